@@ -0,0 +1,275 @@
+// ObjectPool / FixedMemoryPool (utils/memory_pool.h) against new/delete.
+//
+//   memory_pool_bench [threads]
+//
+// A multithreaded stress check runs first and exits non-zero on a failure:
+// threads acquire bursts that cross magazine and chunk boundaries, free a
+// share of them on another thread and claim every object they hold with a
+// CAS, so a block handed out twice (a lost ABA race on a tagged stack) or
+// lost in a magazine refill / flush is caught. Built with TRACK_ALLOCATIONS,
+// it also fails if a warm ObjectPool allocates. Timings are single-thread
+// acquire + release pairs.
+
+#include "utils/alloc_tracker.h"
+#include "utils/memory_pool.h"
+#include "utils/tsc_clock.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using namespace arbitrage;
+
+namespace {
+
+constexpr size_t STRESS_ITERATIONS = 200'000;
+constexpr size_t MAX_BURST = 80;            // More than two magazines
+constexpr size_t PAIRS_PER_RUN = 20'000'000;
+constexpr size_t BURST_PAIRS = 256;
+
+// Pool object / block body: owner is the thread that holds it, 0 when free.
+// A free FixedMemoryPool block keeps its free-list link in the first word.
+struct Slot {
+    void* link = nullptr;
+    std::atomic<uint32_t> owner{0};
+    char payload[52];
+};
+
+using SlotPool = ObjectPool<Slot, PoolReset::NONE>;
+using BlockPool = FixedMemoryPool<64, 256, 8>;
+
+void fail(const char* what) {
+    std::fprintf(stderr, "stress check failed: %s\n", what);
+    std::exit(1);
+}
+
+void claim(std::atomic<uint32_t>& owner, uint32_t thread) {
+    uint32_t expected = 0;
+    if (!owner.compare_exchange_strong(expected, thread, std::memory_order_acq_rel)) {
+        fail("object handed out while held by another thread");
+    }
+}
+
+// Objects a thread passes to its neighbour to free
+class Handoff {
+public:
+    void put(std::vector<void*>& items) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        items_.insert(items_.end(), items.begin(), items.end());
+        items.clear();
+    }
+
+    void take(std::vector<void*>& out) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        out.insert(out.end(), items_.begin(), items_.end());
+        items_.clear();
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<void*> items_;
+};
+
+// Acquire and free in bursts on threads; acquire / release return nullptr
+// when exhausted, Owner maps an item to its owner word
+template<typename Acquire, typename Release, typename Owner>
+void stress(size_t threads, Acquire acquire, Release release, Owner owner_of) {
+    std::vector<Handoff> handoffs(threads);
+    std::vector<std::thread> workers;
+
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            auto id = static_cast<uint32_t>(t + 1);
+            std::mt19937 rng(id);
+            std::vector<void*> held;
+            std::vector<void*> outgoing;
+            std::vector<void*> incoming;
+
+            for (size_t i = 0; i < STRESS_ITERATIONS; ++i) {
+                size_t burst = 1 + rng() % MAX_BURST;
+                for (size_t n = 0; n < burst; ++n) {
+                    void* item = acquire();
+                    if (!item) break;
+                    claim(owner_of(item), id);
+                    held.push_back(item);
+                }
+
+                // About a third goes to the neighbour, the rest back here
+                for (void* item : held) {
+                    if (rng() % 3 == 0) {
+                        outgoing.push_back(item);
+                    } else {
+                        owner_of(item).store(0, std::memory_order_release);
+                        release(item);
+                    }
+                }
+                held.clear();
+                handoffs[(t + 1) % threads].put(outgoing);
+
+                handoffs[t].take(incoming);
+                for (void* item : incoming) {
+                    owner_of(item).store(0, std::memory_order_release);
+                    release(item);
+                }
+                incoming.clear();
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    std::vector<void*> leftover;
+    for (auto& handoff : handoffs) {
+        handoff.take(leftover);
+    }
+    for (void* item : leftover) {
+        owner_of(item).store(0, std::memory_order_release);
+        release(item);
+    }
+}
+
+void stress_object_pool(size_t threads) {
+    SlotPool pool(0);
+    stress(threads,
+           [&] { return static_cast<void*>(pool.acquire_raw()); },
+           [&](void* item) { pool.release(static_cast<Slot*>(item)); },
+           [](void* item) -> std::atomic<uint32_t>& { return static_cast<Slot*>(item)->owner; });
+
+    // Exited threads flushed their magazines: every object comes back once,
+    // without growing the pool
+    size_t allocated = pool.allocated();
+    std::unordered_set<Slot*> seen;
+    std::vector<Slot*> all;
+    for (size_t i = 0; i < allocated; ++i) {
+        Slot* slot = pool.acquire_raw();
+        if (slot->owner.load() != 0 || !seen.insert(slot).second) fail("ObjectPool duplicate");
+        all.push_back(slot);
+    }
+    if (pool.allocated() != allocated) fail("ObjectPool lost objects");
+    for (Slot* slot : all) {
+        pool.release(slot);
+    }
+    std::printf("ObjectPool stress: %zu threads, %zu objects, ok\n", threads, allocated);
+}
+
+void stress_fixed_pool(size_t threads) {
+    // Small enough to run out, so exhaustion and growth race too
+    auto pool = std::make_unique<BlockPool>();
+    stress(threads,
+           [&] { return pool->allocate(); },
+           [&](void* item) { pool->deallocate(item); },
+           [](void* item) -> std::atomic<uint32_t>& { return static_cast<Slot*>(item)->owner; });
+
+    if (pool->allocated() != 0) fail("FixedMemoryPool count");
+    std::unordered_set<void*> seen;
+    for (size_t i = 0; i < BlockPool::max_capacity(); ++i) {
+        void* block = pool->allocate();
+        if (!block || !seen.insert(block).second) fail("FixedMemoryPool lost or duplicate block");
+    }
+    if (pool->allocate()) fail("FixedMemoryPool past capacity");
+    for (void* block : seen) {
+        pool->deallocate(block);
+    }
+    std::printf("FixedMemoryPool stress: %zu threads, %zu blocks, ok\n", threads, BlockPool::max_capacity());
+}
+
+// Once the pool has grown to the burst size, acquire / release cycles,
+// depot refills and flushes included, stay off the heap
+void check_no_allocations() {
+    if (!AllocTracker::enabled()) {
+        std::printf("allocation check skipped: build with TRACK_ALLOCATIONS\n");
+        return;
+    }
+
+    SlotPool pool;
+    std::vector<Slot*> burst(BURST_PAIRS);
+    for (auto& item : burst) item = pool.acquire_raw();
+    for (auto* item : burst) pool.release(item);
+
+    AllocCounter counter;
+    for (size_t r = 0; r < 10'000; ++r) {
+        for (auto& item : burst) item = pool.acquire_raw();
+        for (auto* item : burst) pool.release(item);
+    }
+    if (counter.allocations() > 0) {
+        std::fprintf(stderr, "warm ObjectPool allocated: %llu allocations, %llu bytes\n",
+                     static_cast<unsigned long long>(counter.allocations()),
+                     static_cast<unsigned long long>(counter.bytes()));
+        std::exit(1);
+    }
+    std::printf("allocation check: warm ObjectPool, 0 allocations\n");
+}
+
+template<typename Fn>
+void run(const char* name, size_t pairs_per_call, Fn fn) {
+    size_t reps = PAIRS_PER_RUN / pairs_per_call;
+    uint64_t start = TscClock::now();
+    for (size_t r = 0; r < reps; ++r) {
+        fn();
+        asm volatile("" ::: "memory");
+    }
+    double ns = static_cast<double>(TscClock::to_nanoseconds(TscClock::now() - start)) /
+                static_cast<double>(reps * pairs_per_call);
+    std::printf("%-32s %8.2f ns/pair\n", name, ns);
+}
+
+void bench() {
+    SlotPool objects;
+    BlockPool blocks;
+    std::vector<void*> burst(BURST_PAIRS);
+
+    run("new/delete", 1, [] {
+        Slot* slot = new Slot();
+        asm volatile("" : : "r"(slot) : "memory");
+        delete slot;
+    });
+    run("ObjectPool acquire/release", 1, [&] {
+        Slot* slot = objects.acquire_raw();
+        asm volatile("" : : "r"(slot) : "memory");
+        objects.release(slot);
+    });
+    run("FixedMemoryPool alloc/free", 1, [&] {
+        void* block = blocks.allocate();
+        asm volatile("" : : "r"(block) : "memory");
+        blocks.deallocate(block);
+    });
+
+    // Bursts past two magazines exercise the depot refill / flush
+    run("new/delete burst", BURST_PAIRS, [&] {
+        for (auto& item : burst) item = new Slot();
+        for (auto* item : burst) delete static_cast<Slot*>(item);
+    });
+    run("ObjectPool burst", BURST_PAIRS, [&] {
+        for (auto& item : burst) item = objects.acquire_raw();
+        for (auto* item : burst) objects.release(static_cast<Slot*>(item));
+    });
+    run("FixedMemoryPool burst", BURST_PAIRS, [&] {
+        for (auto& item : burst) item = blocks.allocate();
+        for (auto* item : burst) blocks.deallocate(item);
+    });
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t threads = argc > 1 ? std::strtoull(argv[1], nullptr, 10)
+                              : std::max(4u, std::thread::hardware_concurrency());
+    threads = std::max<size_t>(threads, 2);
+
+    TscClock::calibrate();
+    stress_object_pool(threads);
+    stress_fixed_pool(threads);
+    check_no_allocations();
+
+    std::printf("\n");
+    bench();
+    return 0;
+}
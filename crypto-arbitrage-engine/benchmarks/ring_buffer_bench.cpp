@@ -0,0 +1,314 @@
+// Throughput and ping-pong latency for SpscRing / MpscRing.
+//
+//   ring_buffer_bench [producer_core consumer_core [extra_producer_cores...]]
+//
+// With cores given, threads are pinned (one per core) so the numbers reflect
+// cache-line transfer between those cores; without, the scheduler places
+// them. Latency is half the measured round trip between two rings.
+//
+// Built with TRACK_ALLOCATIONS, a single-thread pass over every push / pop
+// flavour runs first and exits non-zero if it allocates, so the rings stay
+// off the heap after construction.
+
+#include "core/ring_buffer.h"
+#include "utils/alloc_tracker.h"
+#include "utils/tsc_clock.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <pthread.h>
+#include <sched.h>
+#include <thread>
+#include <vector>
+
+using namespace arbitrage;
+
+namespace {
+
+constexpr size_t RING_SIZE = 16384;
+constexpr uint64_t ITEMS = 50'000'000;
+constexpr size_t BATCH = 64;
+constexpr uint64_t ROUND_TRIPS = 1'000'000;
+
+std::vector<int> cores;
+
+void pin(size_t role) {
+    if (role >= cores.size()) return;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cores[role], &set);
+    int result = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (result != 0) {
+        std::fprintf(stderr, "warning: cannot pin to core %d: %s\n", cores[role], std::strerror(result));
+    }
+}
+
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+void report_throughput(const char* name, uint64_t items, std::chrono::steady_clock::duration elapsed) {
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    std::printf("%-28s %8.1f Mitems/s  %6.2f ns/item\n", name,
+                items / seconds / 1e6, seconds * 1e9 / items);
+}
+
+void check_no_allocations() {
+    if (!AllocTracker::enabled()) {
+        std::printf("allocation check skipped: build with TRACK_ALLOCATIONS\n");
+        return;
+    }
+
+    auto spsc = std::make_unique<SpscRing<uint64_t, RING_SIZE>>();
+    auto mpsc = std::make_unique<MpscRing<uint64_t, RING_SIZE>>();
+    uint64_t batch[BATCH] = {};
+    uint64_t value;
+
+    AllocCounter counter;
+    for (uint64_t i = 0; i < 4 * RING_SIZE; ++i) {
+        spsc->push(i);
+        spsc->pop(value);
+        mpsc->push(i);
+        mpsc->pop(value);
+
+        spsc->push_n(batch, BATCH);
+        spsc->pop_n(batch, BATCH);
+        mpsc->push_n(batch, BATCH);
+        mpsc->pop_n(batch, BATCH);
+
+        auto slots = spsc->claim(BATCH);
+        for (size_t k = 0; k < slots.size(); ++k) std::construct_at(slots.data() + k, i);
+        spsc->commit(slots.size());
+        spsc->pop_n(batch, BATCH);
+    }
+    if (counter.allocations() > 0) {
+        std::fprintf(stderr, "ring push/pop allocated: %llu allocations, %llu bytes\n",
+                     static_cast<unsigned long long>(counter.allocations()),
+                     static_cast<unsigned long long>(counter.bytes()));
+        std::exit(1);
+    }
+    std::printf("allocation check: ring push/pop, 0 allocations\n");
+}
+
+template<typename Ring, typename Produce, typename Consume>
+void run_spsc(const char* name, Produce produce, Consume consume) {
+    auto ring = std::make_unique<Ring>();
+    std::atomic<bool> ready{false};
+
+    std::thread consumer([&] {
+        pin(1);
+        while (!ready.load(std::memory_order_acquire)) {
+        }
+        uint64_t expected = 0;
+        consume(*ring, expected);
+        if (expected != ITEMS) {
+            std::fprintf(stderr, "%s: lost items (%llu)\n", name, static_cast<unsigned long long>(expected));
+            std::exit(1);
+        }
+    });
+
+    pin(0);
+    auto start = std::chrono::steady_clock::now();
+    ready.store(true, std::memory_order_release);
+    produce(*ring);
+    consumer.join();
+    report_throughput(name, ITEMS, std::chrono::steady_clock::now() - start);
+}
+
+void bench_spsc_single() {
+    using Ring = SpscRing<uint64_t, RING_SIZE>;
+    run_spsc<Ring>("spsc push/pop",
+        [](Ring& ring) {
+            for (uint64_t i = 0; i < ITEMS; ++i) {
+                while (!ring.push(i)) cpu_relax();
+            }
+        },
+        [](Ring& ring, uint64_t& expected) {
+            uint64_t value;
+            while (expected < ITEMS) {
+                if (!ring.pop(value)) {
+                    cpu_relax();
+                    continue;
+                }
+                if (value != expected++) std::abort();
+            }
+        });
+}
+
+void bench_spsc_batch() {
+    using Ring = SpscRing<uint64_t, RING_SIZE>;
+    run_spsc<Ring>("spsc push_n/pop_n x64",
+        [](Ring& ring) {
+            uint64_t batch[BATCH];
+            for (uint64_t i = 0; i < ITEMS;) {
+                size_t count = std::min<uint64_t>(BATCH, ITEMS - i);
+                for (size_t j = 0; j < count; ++j) batch[j] = i + j;
+
+                size_t sent = 0;
+                while (sent < count) {
+                    size_t pushed = ring.push_n(batch + sent, count - sent);
+                    if (pushed == 0) cpu_relax();
+                    sent += pushed;
+                }
+                i += count;
+            }
+        },
+        [](Ring& ring, uint64_t& expected) {
+            uint64_t batch[BATCH];
+            while (expected < ITEMS) {
+                size_t count = ring.pop_n(batch, BATCH);
+                if (count == 0) {
+                    cpu_relax();
+                    continue;
+                }
+                for (size_t j = 0; j < count; ++j) {
+                    if (batch[j] != expected++) std::abort();
+                }
+            }
+        });
+}
+
+void bench_spsc_claim() {
+    using Ring = SpscRing<uint64_t, RING_SIZE>;
+    run_spsc<Ring>("spsc claim/peek x64",
+        [](Ring& ring) {
+            for (uint64_t i = 0; i < ITEMS;) {
+                auto slots = ring.claim(std::min<uint64_t>(BATCH, ITEMS - i));
+                if (slots.empty()) {
+                    cpu_relax();
+                    continue;
+                }
+                for (size_t k = 0; k < slots.size(); ++k) std::construct_at(slots.data() + k, i++);
+                ring.commit(slots.size());
+            }
+        },
+        [](Ring& ring, uint64_t& expected) {
+            while (expected < ITEMS) {
+                auto items = ring.peek(BATCH);
+                if (items.empty()) {
+                    cpu_relax();
+                    continue;
+                }
+                for (uint64_t value : items) {
+                    if (value != expected++) std::abort();
+                }
+                ring.consume(items.size());
+            }
+        });
+}
+
+void bench_mpsc(size_t producers, bool batched) {
+    using Ring = MpscRing<uint64_t, RING_SIZE>;
+    auto ring = std::make_unique<Ring>();
+    std::atomic<bool> ready{false};
+    uint64_t per_producer = ITEMS / producers;
+
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            pin(p == 0 ? 0 : p + 1);
+            while (!ready.load(std::memory_order_acquire)) {
+            }
+            uint64_t batch[BATCH];
+            for (uint64_t i = 0; i < per_producer;) {
+                if (batched) {
+                    size_t count = std::min<uint64_t>(BATCH, per_producer - i);
+                    std::fill_n(batch, count, p);
+                    size_t pushed = ring->push_n(batch, count);
+                    if (pushed == 0) cpu_relax();
+                    i += pushed;
+                } else if (ring->push(p)) {
+                    i++;
+                } else {
+                    cpu_relax();
+                }
+            }
+        });
+    }
+
+    pin(1);
+    auto start = std::chrono::steady_clock::now();
+    ready.store(true, std::memory_order_release);
+
+    uint64_t received = 0;
+    uint64_t total = per_producer * producers;
+    uint64_t batch[BATCH];
+    while (received < total) {
+        size_t count = ring->pop_n(batch, BATCH);
+        if (count == 0) cpu_relax();
+        received += count;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    for (auto& thread : threads) thread.join();
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "mpsc %zu producers%s", producers, batched ? " x64" : "");
+    report_throughput(name, total, elapsed);
+}
+
+void bench_ping_pong() {
+    using Ring = SpscRing<uint64_t, 64>;
+    auto ping = std::make_unique<Ring>();
+    auto pong = std::make_unique<Ring>();
+
+    std::thread echo([&] {
+        pin(1);
+        uint64_t value;
+        for (uint64_t i = 0; i < ROUND_TRIPS; ++i) {
+            while (!ping->pop(value)) {
+            }
+            while (!pong->push(value)) {
+            }
+        }
+    });
+
+    pin(0);
+    std::vector<uint64_t> samples(ROUND_TRIPS);
+    uint64_t value;
+    for (uint64_t i = 0; i < ROUND_TRIPS; ++i) {
+        uint64_t start = TscClock::now();
+        while (!ping->push(i)) {
+        }
+        while (!pong->pop(value)) {
+        }
+        samples[i] = TscClock::now() - start;
+    }
+    echo.join();
+
+    std::sort(samples.begin(), samples.end());
+    auto one_way = [&](double quantile) {
+        size_t index = std::min(samples.size() - 1, static_cast<size_t>(quantile * samples.size()));
+        return TscClock::to_nanoseconds(samples[index]) / 2.0;
+    };
+    std::printf("%-28s p50 %6.0f ns  p99 %6.0f ns  p99.9 %6.0f ns  max %8.0f ns\n",
+                "spsc ping-pong (one way)", one_way(0.5), one_way(0.99), one_way(0.999), one_way(1.0));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        cores.push_back(std::atoi(argv[i]));
+    }
+
+    TscClock::calibrate();
+    check_no_allocations();
+
+    bench_spsc_single();
+    bench_spsc_batch();
+    bench_spsc_claim();
+    for (size_t producers : {1, 2, 4}) {
+        bench_mpsc(producers, false);
+        bench_mpsc(producers, true);
+    }
+    bench_ping_pong();
+    return 0;
+}
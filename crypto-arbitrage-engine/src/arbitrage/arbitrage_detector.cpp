@@ -4,8 +4,14 @@
 #include "synthetic/futures_pricer.h"
 #include "synthetic/perpetual_pricer.h"
 #include "risk/risk_manager.h"
+#include "performance/event_trace.h"
+#include "performance/hw_counters.h"
+#include "performance/metrics_collector.h"
+#include "performance/scope_timer.h"
 #include "utils/logger.h"
+#include "utils/thread_registry.h"
 #include "core/utils.h"
+#include "utils/clock.h"
 
 namespace arbitrage {
 
@@ -22,6 +28,14 @@ ArbitrageDetector::ArbitrageDetector(MarketDataManager* market_data,
     stat_arb_pricer_ = std::make_unique<StatisticalSyntheticPricer>(market_data_);
     futures_pricer_ = std::make_unique<FuturesPricer>(market_data_);
     perpetual_pricer_ = std::make_unique<PerpetualPricer>(market_data_);
+    
+    auto& registry = MetricRegistry::instance();
+    spot_opportunities_metric_ = registry.register_counter(labelled_metric(
+        "arbitrage_strategy_opportunities_total", {{"strategy", "spot"}}));
+    synthetic_opportunities_metric_ = registry.register_counter(labelled_metric(
+        "arbitrage_strategy_opportunities_total", {{"strategy", "synthetic"}}));
+    funding_opportunities_metric_ = registry.register_counter(labelled_metric(
+        "arbitrage_strategy_opportunities_total", {{"strategy", "funding"}}));
 }
 
 ArbitrageDetector::~ArbitrageDetector() {
@@ -33,6 +47,7 @@ void ArbitrageDetector::start() {
     
     running_ = true;
     detection_thread_ = std::make_unique<std::thread>([this]() {
+        ThreadRegistry::instance().register_current_thread("detector", ThreadRole::DETECTOR);
         detection_loop();
     });
     
@@ -43,6 +58,7 @@ void ArbitrageDetector::stop() {
     if (!running_) return;
     
     running_ = false;
+    market_data_->update_signal().notify_all();
     
     if (detection_thread_ && detection_thread_->joinable()) {
         detection_thread_->join();
@@ -62,28 +78,39 @@ std::vector<ArbitrageOpportunity> ArbitrageDetector::get_current_opportunities()
 }
 
 void ArbitrageDetector::detection_loop() {
+    // A pass runs as soon as any book or ticker changes; the interval only
+    // bounds how long a quiet market goes without one (expiry, funding)
+    WaitStrategy wait(WaitStrategy::for_role(ThreadRole::DETECTOR));
+    WakeSignal& updates = market_data_->update_signal();
+    
     while (running_) {
-        auto start = std::chrono::high_resolution_clock::now();
-        
-        // Run different detection algorithms
-        detect_spot_arbitrage();
-        detect_synthetic_arbitrage();
-        detect_funding_arbitrage();
-        
-        // Cleanup expired opportunities
-        cleanup_expired_opportunities();
+        auto start = WaitStrategy::Clock::now();
+        uint32_t seen = updates.epoch();
         
-        // Sleep to maintain detection frequency
-        auto elapsed = std::chrono::high_resolution_clock::now() - start;
-        auto sleep_time = std::chrono::milliseconds(100) - elapsed;
-        if (sleep_time.count() > 0) {
-            std::this_thread::sleep_for(sleep_time);
+        {
+            ARB_TIME_SCOPE(DETECTION_CYCLE);
+            ARB_HW_SCOPE(DETECTION);
+            CycleArena::Scope cycle(cycle_arena_);
+            
+            // Run different detection algorithms
+            detect_spot_arbitrage();
+            detect_synthetic_arbitrage();
+            detect_funding_arbitrage();
+            
+            // Cleanup expired opportunities
+            cleanup_expired_opportunities();
         }
+        
+        wait.wait(updates, seen, start + std::chrono::milliseconds(100));
     }
 }
 
 void ArbitrageDetector::detect_spot_arbitrage() {
-    std::vector<Symbol> symbols = {"BTC-USDT", "ETH-USDT", "SOL-USDT"};
+    ARB_TIME_SCOPE(DETECT_SPOT);
+    ARB_TRACE_SCOPE(DETECT, 0, metrics::id(metrics::Timer::DETECT_SPOT));
+    
+    CycleArena::Scope cycle(cycle_arena_);
+    std::pmr::vector<Symbol> symbols({"BTC-USDT", "ETH-USDT", "SOL-USDT"}, cycle.resource());
     
     for (const auto& symbol : symbols) {
         MarketDataManager::BestPrices best_prices;
@@ -124,6 +151,7 @@ void ArbitrageDetector::detect_spot_arbitrage() {
                     
                     notify_callbacks(opportunity);
                     total_opportunities_++;
+                    MetricRegistry::increment(spot_opportunities_metric_);
                 }
             }
         }
@@ -131,13 +159,22 @@ void ArbitrageDetector::detect_spot_arbitrage() {
 }
 
 void ArbitrageDetector::detect_synthetic_arbitrage() {
+    ARB_TIME_SCOPE(DETECT_SYNTHETIC);
+    ARB_TRACE_SCOPE(DETECT, 0, metrics::id(metrics::Timer::DETECT_SYNTHETIC));
+    
     // Get synthetic arbitrage opportunities from pricers
-    auto synthetic_arbs = multi_leg_pricer_->find_arbitrage_opportunities(min_profit_threshold_);
+    CycleArena::Scope cycle(cycle_arena_);
+    std::pmr::vector<SyntheticPricer::SyntheticArbitrage> synthetic_arbs(cycle.resource());
+    {
+        ARB_TRACE_SCOPE(PRICE, 0, metrics::id(metrics::Timer::DETECT_SYNTHETIC));
+        synthetic_arbs = multi_leg_pricer_->find_arbitrage_opportunities(min_profit_threshold_,
+                                                                          cycle.resource());
+    }
     
     for (const auto& arb : synthetic_arbs) {
         ArbitrageOpportunity opportunity;
-        opportunity.id = utils::generate_opportunity_id("SYNTHETIC", utils::get_current_timestamp());
-        opportunity.timestamp = utils::get_current_timestamp();
+        opportunity.timestamp = Clock::now();
+        opportunity.id = utils::generate_opportunity_id("SYNTHETIC", opportunity.timestamp);
         
         // Create legs
         opportunity.legs.push_back({
@@ -176,17 +213,26 @@ void ArbitrageDetector::detect_synthetic_arbitrage() {
         
         notify_callbacks(opportunity);
         total_opportunities_++;
+        MetricRegistry::increment(synthetic_opportunities_metric_);
     }
 }
 
 void ArbitrageDetector::detect_funding_arbitrage() {
+    ARB_TIME_SCOPE(DETECT_FUNDING);
+    ARB_TRACE_SCOPE(DETECT, 0, metrics::id(metrics::Timer::DETECT_FUNDING));
+    
     auto perp_pricer = static_cast<PerpetualPricer*>(perpetual_pricer_.get());
-    auto funding_arbs = perp_pricer->find_funding_arbitrage(min_profit_threshold_);
+    CycleArena::Scope cycle(cycle_arena_);
+    std::pmr::vector<PerpetualPricer::FundingArbitrage> funding_arbs(cycle.resource());
+    {
+        ARB_TRACE_SCOPE(PRICE, 0, metrics::id(metrics::Timer::DETECT_FUNDING));
+        funding_arbs = perp_pricer->find_funding_arbitrage(min_profit_threshold_, cycle.resource());
+    }
     
     for (const auto& arb : funding_arbs) {
         ArbitrageOpportunity opportunity;
-        opportunity.id = utils::generate_opportunity_id("FUNDING", utils::get_current_timestamp());
-        opportunity.timestamp = utils::get_current_timestamp();
+        opportunity.timestamp = Clock::now();
+        opportunity.id = utils::generate_opportunity_id("FUNDING", opportunity.timestamp);
         
         // Create legs for funding arbitrage
         opportunity.legs.push_back({
@@ -223,6 +269,7 @@ void ArbitrageDetector::detect_funding_arbitrage() {
         
         notify_callbacks(opportunity);
         total_opportunities_++;
+        MetricRegistry::increment(funding_opportunities_metric_);
     }
 }
 
@@ -234,8 +281,9 @@ ArbitrageOpportunity ArbitrageDetector::create_spot_opportunity(
     const MarketData& sell_data) {
     
     ArbitrageOpportunity opportunity;
-    opportunity.id = utils::generate_opportunity_id("SPOT", utils::get_current_timestamp());
-    opportunity.timestamp = utils::get_current_timestamp();
+    opportunity.timestamp = Clock::now();
+    opportunity.id = utils::generate_opportunity_id("SPOT", opportunity.timestamp);
+    opportunity.source_tick_tsc = std::max(buy_data.received_tsc, sell_data.received_tsc);
     
     // Calculate opportunity details
     double max_quantity = std::min(buy_data.ask_size, sell_data.bid_size);
@@ -284,6 +332,18 @@ ArbitrageOpportunity ArbitrageDetector::create_spot_opportunity(
 }
 
 void ArbitrageDetector::notify_callbacks(const ArbitrageOpportunity& opportunity) {
+    GlobalMetrics::instance().increment_opportunities_detected();
+    ARB_TRACE_SCOPE(DISPATCH, opportunity.legs.empty() ? 0 : trace::instrument_id(opportunity.legs[0].symbol),
+                    opportunity.legs.size());
+    
+    // Tick-to-signal feeds the latency SLO, so it is recorded even without instrumentation
+    if (opportunity.source_tick_tsc != 0) {
+        uint64_t now = TscClock::now();
+        uint64_t ticks = now > opportunity.source_tick_tsc ? now - opportunity.source_tick_tsc : 0;
+        MetricRegistry::record(metrics::id(metrics::Timer::TICK_TO_SIGNAL),
+                               TscClock::to_nanoseconds(ticks));
+    }
+    
     std::lock_guard<std::mutex> lock(callbacks_mutex_);
     
     for (const auto& callback : callbacks_) {
@@ -298,7 +358,7 @@ void ArbitrageDetector::notify_callbacks(const ArbitrageOpportunity& opportunity
 void ArbitrageDetector::cleanup_expired_opportunities() {
     std::lock_guard<std::mutex> lock(opportunities_mutex_);
     
-    auto now = utils::get_current_timestamp();
+    auto now = Clock::now();
     
     auto new_end = std::remove_if(current_opportunities_.begin(), 
                                  current_opportunities_.end(),
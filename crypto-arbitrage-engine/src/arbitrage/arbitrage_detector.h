@@ -1,6 +1,8 @@
 #pragma once
 
 #include "core/types.h"
+#include "performance/metric_shards.h"
+#include "utils/cycle_arena.h"
 #include <memory>
 #include <vector>
 #include <functional>
@@ -82,10 +84,18 @@ private:
     std::atomic<bool> running_{false};
     std::unique_ptr<std::thread> detection_thread_;
     
+    // Scratch for one detection pass, reset at the end of every cycle
+    CycleArena cycle_arena_;
+    
     // Statistics
     std::atomic<uint64_t> total_opportunities_{0};
     std::atomic<uint64_t> expired_opportunities_{0};
     
+    // Per-strategy metric series
+    MetricId spot_opportunities_metric_;
+    MetricId synthetic_opportunities_metric_;
+    MetricId funding_opportunities_metric_;
+    
     // Detection loop
     void detection_loop();
     
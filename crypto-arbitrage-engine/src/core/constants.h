@@ -106,6 +106,10 @@ namespace logging {
     constexpr const char* DEFAULT_LOG_FILE = "arbitrage_engine.log";
     constexpr size_t MAX_LOG_FILE_SIZE = 100 * 1024 * 1024; // 100MB
     constexpr size_t MAX_LOG_FILES = 10;
+    constexpr size_t ASYNC_QUEUE_SIZE = 8192;           // Records, preallocated
+    constexpr size_t ASYNC_MESSAGE_SIZE = 464;          // Longer messages are truncated
+    constexpr uint32_t ASYNC_FLUSH_INTERVAL_MS = 10;    // Writer wake-up when not notified
+    constexpr uint32_t REPEAT_INTERVAL_MS = 1000;       // LOG_*_EVERY_MS for per-event warnings
 }
 
 // Mathematical constants
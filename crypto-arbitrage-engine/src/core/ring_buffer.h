@@ -0,0 +1,348 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace arbitrage {
+
+// Bounded single-producer single-consumer ring.
+//
+// Capacity is rounded up to a power of two so slots are found with a mask.
+// Head and tail only ever grow; each side keeps a cached copy of the other
+// side's index and re-reads the shared atomic only when the cache says the
+// ring is full (producer) or empty (consumer), so an uncontended push or
+// pop touches no cache line owned by the other thread. Items are
+// constructed in place and moved out; batch calls publish once per batch.
+template<typename T, size_t MinCapacity>
+class SpscRing {
+public:
+    static constexpr size_t CAPACITY = std::bit_ceil(std::max<size_t>(MinCapacity, 2));
+
+    SpscRing() = default;
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    ~SpscRing() {
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        for (; head != tail; ++head) {
+            std::destroy_at(slot(head));
+        }
+    }
+
+    // Producer
+
+    template<typename... Args>
+    bool try_emplace(Args&&... args) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (!has_space(tail, 1)) {
+            return false;
+        }
+
+        std::construct_at(storage(tail), std::forward<Args>(args)...);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool push(const T& item) { return try_emplace(item); }
+    bool push(T&& item) { return try_emplace(std::move(item)); }
+
+    // Copies up to count items; returns how many fit
+    size_t push_n(const T* items, size_t count) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        count = std::min(count, free_space(tail, count));
+
+        for (size_t i = 0; i < count; ++i) {
+            std::construct_at(storage(tail + i), items[i]);
+        }
+        if (count > 0) {
+            tail_.store(tail + count, std::memory_order_release);
+        }
+        return count;
+    }
+
+    // Up to max contiguous free slots, made visible by commit(). The span is
+    // raw storage with no objects in it yet: construct item i at data() + i
+    // (std::construct_at) and do not read it before then. It stops at the
+    // wrap point, so a full batch may take two claims.
+    std::span<T> claim(size_t max) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t index = tail & MASK;
+        size_t count = std::min({max, free_space(tail, max), CAPACITY - index});
+        return {storage(tail), count};
+    }
+
+    // Publishes the first count slots of the last claim
+    void commit(size_t count) {
+        tail_.store(tail_.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    // Consumer
+
+    bool pop(T& item) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (!has_items(head, 1)) {
+            return false;
+        }
+
+        T* source = slot(head);
+        item = std::move(*source);
+        std::destroy_at(source);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Moves up to max items into out; returns how many were taken
+    size_t pop_n(T* out, size_t max) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t count = std::min(max, available(head, max));
+
+        for (size_t i = 0; i < count; ++i) {
+            T* source = slot(head + i);
+            out[i] = std::move(*source);
+            std::destroy_at(source);
+        }
+        if (count > 0) {
+            head_.store(head + count, std::memory_order_release);
+        }
+        return count;
+    }
+
+    // Up to max contiguous readable items, consumed in place and released by
+    // consume(). Stops at the wrap point like claim().
+    std::span<T> peek(size_t max) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t index = head & MASK;
+        size_t count = std::min({max, available(head, max), CAPACITY - index});
+        return {slot(head), count};
+    }
+
+    // Destroys and releases the first count items of the last peek
+    void consume(size_t count) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < count; ++i) {
+            std::destroy_at(slot(head + i));
+        }
+        head_.store(head + count, std::memory_order_release);
+    }
+
+    // Approximate when called while the other side is running
+    size_t size() const {
+        size_t head = head_.load(std::memory_order_acquire);
+        size_t tail = tail_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+    static constexpr size_t capacity() { return CAPACITY; }
+
+private:
+    static constexpr size_t MASK = CAPACITY - 1;
+
+    // Where the item at position is, or will be, constructed
+    T* storage(size_t position) {
+        return reinterpret_cast<T*>(storage_ + (position & MASK) * sizeof(T));
+    }
+
+    // The live item at position (constructed and not yet destroyed)
+    T* slot(size_t position) {
+        return std::launder(storage(position));
+    }
+
+    // Free slots at tail, refreshing the cached head only if fewer than wanted
+    size_t free_space(size_t tail, size_t wanted) {
+        size_t space = CAPACITY - (tail - cached_head_);
+        if (space < wanted) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            space = CAPACITY - (tail - cached_head_);
+        }
+        return space;
+    }
+
+    bool has_space(size_t tail, size_t wanted) { return free_space(tail, wanted) >= wanted; }
+
+    size_t available(size_t head, size_t wanted) {
+        size_t items = cached_tail_ - head;
+        if (items < wanted) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            items = cached_tail_ - head;
+        }
+        return items;
+    }
+
+    bool has_items(size_t head, size_t wanted) { return available(head, wanted) >= wanted; }
+
+    // Producer line
+    alignas(64) std::atomic<size_t> tail_{0};
+    size_t cached_head_ = 0;
+
+    // Consumer line
+    alignas(64) std::atomic<size_t> head_{0};
+    size_t cached_tail_ = 0;
+
+    alignas(64) alignas(T) std::byte storage_[CAPACITY * sizeof(T)];
+};
+
+// Bounded multi-producer single-consumer ring, for several io threads
+// feeding one consumer.
+//
+// Each slot carries a sequence number (Vyukov): a producer claims positions
+// with a CAS on the tail and publishes each slot by bumping its sequence,
+// so producers never wait on each other once their positions are claimed.
+// The consumer owns the head outright and needs no atomic read-modify-write.
+template<typename T, size_t MinCapacity>
+class MpscRing {
+public:
+    static constexpr size_t CAPACITY = std::bit_ceil(std::max<size_t>(MinCapacity, 2));
+
+    MpscRing() {
+        for (size_t i = 0; i < CAPACITY; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    ~MpscRing() {
+        size_t head = head_.load(std::memory_order_relaxed);
+        while (slots_[head & MASK].sequence.load(std::memory_order_relaxed) == head + 1) {
+            std::destroy_at(slots_[head & MASK].item());
+            head++;
+        }
+    }
+
+    // Producers
+
+    template<typename... Args>
+    bool try_emplace(Args&&... args) {
+        size_t position = tail_.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& target = slots_[position & MASK];
+            size_t sequence = target.sequence.load(std::memory_order_acquire);
+            auto lag = static_cast<std::ptrdiff_t>(sequence - position);
+
+            if (lag == 0) {
+                if (tail_.compare_exchange_weak(position, position + 1,
+                                                std::memory_order_relaxed)) {
+                    std::construct_at(target.raw(), std::forward<Args>(args)...);
+                    target.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false;       // Slot still holds an item from the last lap
+            } else {
+                position = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool push(const T& item) { return try_emplace(item); }
+    bool push(T&& item) { return try_emplace(std::move(item)); }
+
+    // Claims a run of up to count positions with one CAS and copies items
+    // into it; returns how many were pushed
+    size_t push_n(const T* items, size_t count) {
+        if (count == 0) return 0;
+
+        size_t position = tail_.load(std::memory_order_relaxed);
+        size_t claimed = 0;
+        while (claimed == 0) {
+            // The consumer frees slots in order, so if the last slot of a
+            // run is free the whole run is: binary search the longest run
+            size_t limit = std::min(count, CAPACITY);
+            while (claimed < limit) {
+                size_t length = claimed + (limit - claimed + 1) / 2;
+                size_t last = position + length - 1;
+                if (slots_[last & MASK].sequence.load(std::memory_order_acquire) == last) {
+                    claimed = length;
+                } else {
+                    limit = length - 1;
+                }
+            }
+
+            if (claimed == 0) {
+                size_t sequence = slots_[position & MASK].sequence.load(std::memory_order_acquire);
+                if (static_cast<std::ptrdiff_t>(sequence - position) < 0) {
+                    return 0;       // Full
+                }
+                position = tail_.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            if (!tail_.compare_exchange_weak(position, position + claimed,
+                                             std::memory_order_relaxed)) {
+                claimed = 0;
+            }
+        }
+
+        for (size_t i = 0; i < claimed; ++i) {
+            Slot& target = slots_[(position + i) & MASK];
+            std::construct_at(target.raw(), items[i]);
+            target.sequence.store(position + i + 1, std::memory_order_release);
+        }
+        return claimed;
+    }
+
+    // Consumer
+
+    bool pop(T& item) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        Slot& source = slots_[head & MASK];
+        if (source.sequence.load(std::memory_order_acquire) != head + 1) {
+            return false;
+        }
+
+        T* stored = source.item();
+        item = std::move(*stored);
+        std::destroy_at(stored);
+        source.sequence.store(head + CAPACITY, std::memory_order_release);
+        head_.store(head + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Moves up to max published items into out. Stops at the first slot a
+    // producer has claimed but not yet filled.
+    size_t pop_n(T* out, size_t max) {
+        size_t count = 0;
+        while (count < max && pop(out[count])) {
+            count++;
+        }
+        return count;
+    }
+
+    // Approximate while producers are running
+    size_t size() const {
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t tail = tail_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+    static constexpr size_t capacity() { return CAPACITY; }
+
+private:
+    static constexpr size_t MASK = CAPACITY - 1;
+
+    struct Slot {
+        std::atomic<size_t> sequence;
+        alignas(T) std::byte storage[sizeof(T)];
+
+        T* raw() { return reinterpret_cast<T*>(storage); }      // To construct into
+        T* item() { return std::launder(raw()); }               // Once constructed
+    };
+
+    alignas(64) std::atomic<size_t> tail_{0};
+    alignas(64) std::atomic<size_t> head_{0};      // Written by the consumer only
+    alignas(64) Slot slots_[CAPACITY];
+};
+
+} // namespace arbitrage
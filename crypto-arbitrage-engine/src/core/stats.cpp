@@ -0,0 +1,464 @@
+#include "stats.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define ARB_STATS_AVX2 1
+#define ARB_AVX2_TARGET __attribute__((target("avx2,fma")))
+#endif
+
+namespace arbitrage {
+namespace stats {
+
+namespace {
+
+// Joint moments of two series; covariance and correlation both come from it
+struct CoMoments {
+    size_t count = 0;
+    double mean_a = 0.0;
+    double mean_b = 0.0;
+    double m2_a = 0.0;
+    double m2_b = 0.0;
+    double c = 0.0;             // Sum of (a - mean_a) * (b - mean_b)
+};
+
+CoMoments merge_co(const CoMoments& x, const CoMoments& y) {
+    if (x.count == 0) return y;
+    if (y.count == 0) return x;
+
+    CoMoments result;
+    result.count = x.count + y.count;
+    double n = static_cast<double>(result.count);
+    double weight = static_cast<double>(x.count) * static_cast<double>(y.count) / n;
+    double delta_a = y.mean_a - x.mean_a;
+    double delta_b = y.mean_b - x.mean_b;
+    result.mean_a = x.mean_a + delta_a * static_cast<double>(y.count) / n;
+    result.mean_b = x.mean_b + delta_b * static_cast<double>(y.count) / n;
+    result.m2_a = x.m2_a + y.m2_a + delta_a * delta_a * weight;
+    result.m2_b = x.m2_b + y.m2_b + delta_b * delta_b * weight;
+    result.c = x.c + y.c + delta_a * delta_b * weight;
+    return result;
+}
+
+// Up to this many values moments() uses the scalar two-pass kernel
+// whatever the ISA; the AVX2 lane setup and merge only pay off beyond it
+constexpr size_t TWO_PASS_MAX_COUNT = 64;
+
+struct Kernels {
+    Isa isa;
+    Moments (*moments)(const double* values, size_t count);
+    CoMoments (*co_moments)(const double* a, const double* b, size_t count);
+    double (*sum)(const double* values, size_t count);
+    double (*dot)(const double* a, const double* b, size_t count);
+    Extrema (*extrema)(const double* values, size_t count);
+    double (*ewma)(const double* values, size_t count, double alpha, double state);
+};
+
+// Scalar kernels; also finish the AVX2 kernels' tails
+
+CoMoments co_moments_scalar(const double* a, const double* b, size_t count) {
+    CoMoments result;
+    for (size_t i = 0; i < count; ++i) {
+        result.count++;
+        double inverse = 1.0 / static_cast<double>(result.count);
+        double delta_a = a[i] - result.mean_a;
+        double delta_b = b[i] - result.mean_b;
+        result.mean_a += delta_a * inverse;
+        result.mean_b += delta_b * inverse;
+        result.m2_a += delta_a * (a[i] - result.mean_a);
+        result.m2_b += delta_b * (b[i] - result.mean_b);
+        result.c += delta_a * (b[i] - result.mean_b);
+    }
+    return result;
+}
+
+// Two passes: the mean, then squared deviations from it. Cheaper than
+// Welford's per-value division, and for short series than the AVX2 lane
+// merge, as long as the values are still in cache for the second pass.
+Moments moments_scalar(const double* values, size_t count) {
+    Moments result;
+    result.count = count;
+    if (count == 0) return result;
+
+    double sums[4] = {0.0, 0.0, 0.0, 0.0};
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        for (size_t lane = 0; lane < 4; ++lane) sums[lane] += values[i + lane];
+    }
+    for (; i < count; ++i) sums[0] += values[i];
+    result.mean = ((sums[0] + sums[1]) + (sums[2] + sums[3])) / static_cast<double>(count);
+
+    double squares[4] = {0.0, 0.0, 0.0, 0.0};
+    for (i = 0; i + 4 <= count; i += 4) {
+        for (size_t lane = 0; lane < 4; ++lane) {
+            double deviation = values[i + lane] - result.mean;
+            squares[lane] += deviation * deviation;
+        }
+    }
+    for (; i < count; ++i) {
+        double deviation = values[i] - result.mean;
+        squares[0] += deviation * deviation;
+    }
+    result.m2 = (squares[0] + squares[1]) + (squares[2] + squares[3]);
+    return result;
+}
+
+double sum_scalar(const double* values, size_t count) {
+    double total = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        total += values[i];
+    }
+    return total;
+}
+
+double dot_scalar(const double* a, const double* b, size_t count) {
+    double total = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        total += a[i] * b[i];
+    }
+    return total;
+}
+
+// Folds values[begin, count) into an extrema already holding earlier ones
+void extrema_tail(const double* values, size_t begin, size_t count, Extrema& result) {
+    for (size_t i = begin; i < count; ++i) {
+        if (values[i] < result.min) {
+            result.min = values[i];
+            result.argmin = i;
+        }
+        if (values[i] > result.max) {
+            result.max = values[i];
+            result.argmax = i;
+        }
+    }
+}
+
+Extrema extrema_scalar(const double* values, size_t count) {
+    Extrema result;
+    if (count == 0) return result;
+
+    result.min = result.max = values[0];
+    extrema_tail(values, 1, count, result);
+    return result;
+}
+
+double ewma_scalar(const double* values, size_t count, double alpha, double state) {
+    for (size_t i = 0; i < count; ++i) {
+        state += alpha * (values[i] - state);
+    }
+    return state;
+}
+
+constexpr Kernels SCALAR_KERNELS{
+    Isa::SCALAR, moments_scalar, co_moments_scalar, sum_scalar, dot_scalar, extrema_scalar, ewma_scalar,
+};
+
+#ifdef ARB_STATS_AVX2
+
+ARB_AVX2_TARGET inline double horizontal_sum(__m256d v) {
+    __m128d low = _mm256_castpd256_pd128(v);
+    __m128d high = _mm256_extractf128_pd(v, 1);
+    __m128d pair = _mm_add_pd(low, high);
+    return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+}
+
+// Two independent accumulator sets (8 lanes) hide the FMA latency; every
+// lane has seen the same number of values, so one 1/n serves them all
+ARB_AVX2_TARGET Moments moments_avx2(const double* values, size_t count) {
+    size_t blocks = count / 8;
+    __m256d mean0 = _mm256_setzero_pd(), m2_0 = _mm256_setzero_pd();
+    __m256d mean1 = _mm256_setzero_pd(), m2_1 = _mm256_setzero_pd();
+
+    for (size_t i = 0; i < blocks; ++i) {
+        __m256d inverse = _mm256_set1_pd(1.0 / static_cast<double>(i + 1));
+        __m256d x0 = _mm256_loadu_pd(values + 8 * i);
+        __m256d x1 = _mm256_loadu_pd(values + 8 * i + 4);
+
+        __m256d delta0 = _mm256_sub_pd(x0, mean0);
+        __m256d delta1 = _mm256_sub_pd(x1, mean1);
+        mean0 = _mm256_fmadd_pd(delta0, inverse, mean0);
+        mean1 = _mm256_fmadd_pd(delta1, inverse, mean1);
+        m2_0 = _mm256_fmadd_pd(delta0, _mm256_sub_pd(x0, mean0), m2_0);
+        m2_1 = _mm256_fmadd_pd(delta1, _mm256_sub_pd(x1, mean1), m2_1);
+    }
+
+    Moments result;
+    if (blocks > 0) {
+        alignas(32) double means[8];
+        alignas(32) double m2s[8];
+        _mm256_store_pd(means, mean0);
+        _mm256_store_pd(means + 4, mean1);
+        _mm256_store_pd(m2s, m2_0);
+        _mm256_store_pd(m2s + 4, m2_1);
+        for (size_t lane = 0; lane < 8; ++lane) {
+            result = merge(result, Moments{blocks, means[lane], m2s[lane]});
+        }
+    }
+    return merge(result, moments_scalar(values + 8 * blocks, count - 8 * blocks));
+}
+
+ARB_AVX2_TARGET CoMoments co_moments_avx2(const double* a, const double* b, size_t count) {
+    size_t blocks = count / 4;
+    __m256d mean_a = _mm256_setzero_pd(), mean_b = _mm256_setzero_pd();
+    __m256d m2_a = _mm256_setzero_pd(), m2_b = _mm256_setzero_pd(), c = _mm256_setzero_pd();
+
+    for (size_t i = 0; i < blocks; ++i) {
+        __m256d inverse = _mm256_set1_pd(1.0 / static_cast<double>(i + 1));
+        __m256d x = _mm256_loadu_pd(a + 4 * i);
+        __m256d y = _mm256_loadu_pd(b + 4 * i);
+
+        __m256d delta_a = _mm256_sub_pd(x, mean_a);
+        __m256d delta_b = _mm256_sub_pd(y, mean_b);
+        mean_a = _mm256_fmadd_pd(delta_a, inverse, mean_a);
+        mean_b = _mm256_fmadd_pd(delta_b, inverse, mean_b);
+        __m256d residual_b = _mm256_sub_pd(y, mean_b);
+        m2_a = _mm256_fmadd_pd(delta_a, _mm256_sub_pd(x, mean_a), m2_a);
+        m2_b = _mm256_fmadd_pd(delta_b, residual_b, m2_b);
+        c = _mm256_fmadd_pd(delta_a, residual_b, c);
+    }
+
+    CoMoments result;
+    if (blocks > 0) {
+        alignas(32) double lanes[5][4];
+        _mm256_store_pd(lanes[0], mean_a);
+        _mm256_store_pd(lanes[1], mean_b);
+        _mm256_store_pd(lanes[2], m2_a);
+        _mm256_store_pd(lanes[3], m2_b);
+        _mm256_store_pd(lanes[4], c);
+        for (size_t lane = 0; lane < 4; ++lane) {
+            result = merge_co(result, CoMoments{blocks, lanes[0][lane], lanes[1][lane],
+                                                lanes[2][lane], lanes[3][lane], lanes[4][lane]});
+        }
+    }
+    return merge_co(result, co_moments_scalar(a + 4 * blocks, b + 4 * blocks, count - 4 * blocks));
+}
+
+ARB_AVX2_TARGET double sum_avx2(const double* values, size_t count) {
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    __m256d acc2 = _mm256_setzero_pd(), acc3 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(values + i));
+        acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(values + i + 4));
+        acc2 = _mm256_add_pd(acc2, _mm256_loadu_pd(values + i + 8));
+        acc3 = _mm256_add_pd(acc3, _mm256_loadu_pd(values + i + 12));
+    }
+    for (; i + 4 <= count; i += 4) {
+        acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(values + i));
+    }
+    __m256d acc = _mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3));
+    return horizontal_sum(acc) + sum_scalar(values + i, count - i);
+}
+
+ARB_AVX2_TARGET double dot_avx2(const double* a, const double* b, size_t count) {
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    __m256d acc2 = _mm256_setzero_pd(), acc3 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), acc0);
+        acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4), acc1);
+        acc2 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 8), _mm256_loadu_pd(b + i + 8), acc2);
+        acc3 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i + 12), _mm256_loadu_pd(b + i + 12), acc3);
+    }
+    for (; i + 4 <= count; i += 4) {
+        acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), acc0);
+    }
+    __m256d acc = _mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3));
+    return horizontal_sum(acc) + dot_scalar(a + i, b + i, count - i);
+}
+
+// Indices ride along as doubles (exact below 2^53); strict compares keep
+// each lane's first occurrence, ties across lanes go to the lower index
+ARB_AVX2_TARGET Extrema extrema_avx2(const double* values, size_t count) {
+    if (count < 8) return extrema_scalar(values, count);
+
+    __m256d index = _mm256_set_pd(3.0, 2.0, 1.0, 0.0);
+    const __m256d step = _mm256_set1_pd(4.0);
+    __m256d min = _mm256_loadu_pd(values), max = min;
+    __m256d argmin = index, argmax = index;
+
+    size_t i = 4;
+    for (; i + 4 <= count; i += 4) {
+        index = _mm256_add_pd(index, step);
+        __m256d x = _mm256_loadu_pd(values + i);
+        __m256d lower = _mm256_cmp_pd(x, min, _CMP_LT_OQ);
+        __m256d higher = _mm256_cmp_pd(x, max, _CMP_GT_OQ);
+        min = _mm256_blendv_pd(min, x, lower);
+        argmin = _mm256_blendv_pd(argmin, index, lower);
+        max = _mm256_blendv_pd(max, x, higher);
+        argmax = _mm256_blendv_pd(argmax, index, higher);
+    }
+
+    alignas(32) double mins[4], maxs[4], argmins[4], argmaxs[4];
+    _mm256_store_pd(mins, min);
+    _mm256_store_pd(maxs, max);
+    _mm256_store_pd(argmins, argmin);
+    _mm256_store_pd(argmaxs, argmax);
+
+    Extrema result{mins[0], maxs[0], static_cast<size_t>(argmins[0]), static_cast<size_t>(argmaxs[0])};
+    for (size_t lane = 1; lane < 4; ++lane) {
+        auto lane_argmin = static_cast<size_t>(argmins[lane]);
+        auto lane_argmax = static_cast<size_t>(argmaxs[lane]);
+        if (mins[lane] < result.min || (mins[lane] == result.min && lane_argmin < result.argmin)) {
+            result.min = mins[lane];
+            result.argmin = lane_argmin;
+        }
+        if (maxs[lane] > result.max || (maxs[lane] == result.max && lane_argmax < result.argmax)) {
+            result.max = maxs[lane];
+            result.argmax = lane_argmax;
+        }
+    }
+    extrema_tail(values, i, count, result);
+    return result;
+}
+
+// With beta = 1 - alpha, n updates give
+//   state_n = beta^n * state_0 + alpha * sum_i beta^(n-1-i) * x_i
+// Lane j accumulates x_(4k+j) by Horner's rule in beta^4, so the
+// recurrence costs one FMA per four values; lane j's weight is beta^(3-j)
+ARB_AVX2_TARGET double ewma_avx2(const double* values, size_t count, double alpha, double state) {
+    size_t blocks = count / 4;
+    if (blocks == 0) return ewma_scalar(values, count, alpha, state);
+
+    double beta = 1.0 - alpha;
+    double beta2 = beta * beta;
+    double beta4 = beta2 * beta2;
+    const __m256d decay = _mm256_set1_pd(beta4);
+
+    __m256d acc = _mm256_setzero_pd();
+    for (size_t i = 0; i < blocks; ++i) {
+        acc = _mm256_fmadd_pd(acc, decay, _mm256_loadu_pd(values + 4 * i));
+    }
+
+    const __m256d weights = _mm256_set_pd(1.0, beta, beta2, beta2 * beta);
+    double weighted = horizontal_sum(_mm256_mul_pd(acc, weights));
+    state = std::pow(beta4, static_cast<double>(blocks)) * state + alpha * weighted;
+    return ewma_scalar(values + 4 * blocks, count - 4 * blocks, alpha, state);
+}
+
+constexpr Kernels AVX2_KERNELS{
+    Isa::AVX2, moments_avx2, co_moments_avx2, sum_avx2, dot_avx2, extrema_avx2, ewma_avx2,
+};
+
+bool cpu_has_avx2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+}
+
+#endif
+
+const Kernels* detect() {
+#ifdef ARB_STATS_AVX2
+    if (cpu_has_avx2()) return &AVX2_KERNELS;
+#endif
+    return &SCALAR_KERNELS;
+}
+
+std::atomic<const Kernels*>& active() {
+    static std::atomic<const Kernels*> kernels{detect()};
+    return kernels;
+}
+
+const Kernels& kernels() {
+    return *active().load(std::memory_order_relaxed);
+}
+
+} // namespace
+
+Isa isa() {
+    return kernels().isa;
+}
+
+void set_isa(Isa requested) {
+    const Kernels* chosen = &SCALAR_KERNELS;
+#ifdef ARB_STATS_AVX2
+    if (requested == Isa::AVX2 && cpu_has_avx2()) chosen = &AVX2_KERNELS;
+#endif
+    active().store(chosen, std::memory_order_relaxed);
+}
+
+const char* isa_to_string(Isa isa) {
+    switch (isa) {
+        case Isa::SCALAR: return "scalar";
+        case Isa::AVX2: return "avx2";
+    }
+    return "unknown";
+}
+
+Moments merge(const Moments& a, const Moments& b) {
+    if (a.count == 0) return b;
+    if (b.count == 0) return a;
+
+    Moments result;
+    result.count = a.count + b.count;
+    double n = static_cast<double>(result.count);
+    double delta = b.mean - a.mean;
+    result.mean = a.mean + delta * static_cast<double>(b.count) / n;
+    result.m2 = a.m2 + b.m2 + delta * delta * static_cast<double>(a.count) * static_cast<double>(b.count) / n;
+    return result;
+}
+
+Moments moments(std::span<const double> values) {
+    if (values.size() <= TWO_PASS_MAX_COUNT) {
+        return moments_scalar(values.data(), values.size());
+    }
+    return kernels().moments(values.data(), values.size());
+}
+
+double sum(std::span<const double> values) {
+    return kernels().sum(values.data(), values.size());
+}
+
+double dot(std::span<const double> a, std::span<const double> b) {
+    return kernels().dot(a.data(), b.data(), std::min(a.size(), b.size()));
+}
+
+double covariance(std::span<const double> a, std::span<const double> b) {
+    CoMoments co = kernels().co_moments(a.data(), b.data(), std::min(a.size(), b.size()));
+    return co.count > 1 ? co.c / static_cast<double>(co.count - 1) : 0.0;
+}
+
+double correlation(std::span<const double> a, std::span<const double> b) {
+    CoMoments co = kernels().co_moments(a.data(), b.data(), std::min(a.size(), b.size()));
+    double denominator = std::sqrt(co.m2_a * co.m2_b);
+    return co.count > 1 && denominator > 0.0 ? co.c / denominator : 0.0;
+}
+
+Extrema extrema(std::span<const double> values) {
+    return kernels().extrema(values.data(), values.size());
+}
+
+namespace {
+
+size_t quantile_rank(size_t count, double q) {
+    double rank = std::clamp(q, 0.0, 1.0) * static_cast<double>(count);
+    return std::min(count - 1, static_cast<size_t>(rank));
+}
+
+} // namespace
+
+double select_quantile(std::span<double> values, double q) {
+    if (values.empty()) return 0.0;
+
+    size_t rank = quantile_rank(values.size(), q);
+    std::nth_element(values.begin(), values.begin() + rank, values.end());
+    return values[rank];
+}
+
+double lower_tail_mean(std::span<double> values, double q) {
+    if (values.empty()) return 0.0;
+
+    // nth_element leaves everything up to rank no greater than it
+    size_t rank = quantile_rank(values.size(), q);
+    std::nth_element(values.begin(), values.begin() + rank, values.end());
+    return sum(values.first(rank + 1)) / static_cast<double>(rank + 1);
+}
+
+double ewma(std::span<const double> values, double alpha, double state) {
+    return kernels().ewma(values.data(), values.size(), alpha, state);
+}
+
+} // namespace stats
+} // namespace arbitrage
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <span>
+
+namespace arbitrage {
+namespace stats {
+
+// Statistics kernels over contiguous doubles (returns, spreads, prices).
+//
+// Each kernel has an AVX2/FMA implementation and a scalar one; the AVX2
+// set is chosen once, on first use, when the CPU supports it. The two
+// agree to rounding, not bit for bit, since lanes accumulate in a
+// different order. Inputs must not contain NaN.
+//
+// These are the double fast path; utils::calculate_mean / calculate_std_dev
+// stay as the generic templates.
+
+enum class Isa {
+    SCALAR,
+    AVX2,
+};
+
+Isa isa();
+
+// Force a kernel set (benchmarks, checking the fallback); AVX2 is ignored
+// when the CPU lacks it
+void set_isa(Isa isa);
+
+const char* isa_to_string(Isa isa);
+
+struct Moments {
+    size_t count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;            // Sum of squared deviations from the mean
+
+    double variance() const { return count > 1 ? m2 / static_cast<double>(count - 1) : 0.0; }
+    double std_dev() const { return std::sqrt(variance()); }
+};
+
+// Mean and variance. Up to 64 values (the 30-day return history) two
+// scalar passes; beyond that AVX2 runs one Welford pass per lane and
+// merges the lanes.
+Moments moments(std::span<const double> values);
+
+// Combine the moments of two disjoint samples
+Moments merge(const Moments& a, const Moments& b);
+
+double sum(std::span<const double> values);
+
+// Over the common prefix of a and b
+double dot(std::span<const double> a, std::span<const double> b);
+
+// Sample covariance / Pearson correlation over the common prefix of a and
+// b, one pass; 0 with fewer than two pairs or a constant series
+double covariance(std::span<const double> a, std::span<const double> b);
+double correlation(std::span<const double> a, std::span<const double> b);
+
+// First occurrence of the minimum and maximum; all zero when empty
+struct Extrema {
+    double min = 0.0;
+    double max = 0.0;
+    size_t argmin = 0;
+    size_t argmax = 0;
+};
+
+Extrema extrema(std::span<const double> values);
+
+// Value of rank floor(q * n) (clamped) in ascending order, by selection
+// rather than a sort. Reorders values; 0 when empty.
+double select_quantile(std::span<double> values, double q);
+
+// Mean of the values up to and including that rank (expected shortfall
+// for q = 1 - confidence). Reorders values; 0 when empty.
+double lower_tail_mean(std::span<double> values, double q);
+
+// Exponentially weighted moving average: applies
+//   state += alpha * (x - state)
+// for each value in order and returns the final state
+double ewma(std::span<const double> values, double alpha, double state);
+
+} // namespace stats
+} // namespace arbitrage
@@ -65,7 +65,9 @@ struct MarketData {
     Price last_price;
     Quantity volume_24h;
     Price funding_rate;  // For perpetuals
+    Price mark_price = 0.0;  // For perpetuals, 0 when the venue did not send one
     Timestamp expiry;    // For futures
+    uint64_t received_tsc = 0;  // TscClock ticks when stored by MarketDataManager
     
     Price mid_price() const { return (bid_price + ask_price) / 2.0; }
     Price spread() const { return ask_price - bid_price; }
@@ -120,6 +122,9 @@ struct ArbitrageOpportunity {
     // Execution parameters
     uint32_t ttl_ms;  // Time to live in milliseconds
     bool is_executable;
+    
+    // received_tsc of the newest input tick, 0 when the legs were not priced from stored ticks
+    uint64_t source_tick_tsc = 0;
 };
 
 // Position information
@@ -132,6 +137,7 @@ struct PositionInfo {
     Price average_price;
     Price current_price;
     Timestamp entry_time;
+    double leverage = 0.0;  // 0 = use the venue's default leverage
     
     Price unrealized_pnl() const {
         return (current_price - average_price) * quantity * (side == Side::BUY ? 1 : -1);
@@ -193,13 +199,19 @@ struct ArbitrageConfig {
 };
 
 struct SystemConfig {
-    uint32_t thread_pool_size;
+    uint32_t thread_pool_size = 0;          // 0: one worker per pool core, or per CPU
+    std::vector<int> thread_pool_cores;     // Pool worker pinning; empty = unpinned
     uint32_t order_book_depth;
     uint32_t market_data_buffer_size;
     bool enable_simd_optimization;
     bool enable_memory_pooling;
+    bool huge_pages = false;                 // Back books, tables and pools with 2 MiB pages
+    uint32_t huge_page_arena_mb = 64;
+    bool lock_huge_pages = false;            // mlock() the arena
     std::string log_level;
     std::string log_file;
+    bool async_logging = false;             // Format on the caller, write on a background thread
+    std::string binary_log_file;            // Raw LOG_FAST records; empty formats them into log_file
 };
 
 // Aligned data structures for SIMD operations
@@ -213,45 +225,4 @@ alignas(32) struct AlignedPriceData {
     }
 };
 
-// Thread-safe circular buffer for market data
-template<typename T, size_t N>
-class CircularBuffer {
-private:
-    alignas(64) std::array<T, N> buffer_;
-    alignas(64) std::atomic<size_t> write_pos_{0};
-    alignas(64) std::atomic<size_t> read_pos_{0};
-    
-public:
-    bool push(const T& item) {
-        size_t current_write = write_pos_.load(std::memory_order_relaxed);
-        size_t next_write = (current_write + 1) % N;
-        
-        if (next_write == read_pos_.load(std::memory_order_acquire)) {
-            return false;  // Buffer full
-        }
-        
-        buffer_[current_write] = item;
-        write_pos_.store(next_write, std::memory_order_release);
-        return true;
-    }
-    
-    bool pop(T& item) {
-        size_t current_read = read_pos_.load(std::memory_order_relaxed);
-        
-        if (current_read == write_pos_.load(std::memory_order_acquire)) {
-            return false;  // Buffer empty
-        }
-        
-        item = buffer_[current_read];
-        read_pos_.store((current_read + 1) % N, std::memory_order_release);
-        return true;
-    }
-    
-    size_t size() const {
-        size_t write = write_pos_.load(std::memory_order_acquire);
-        size_t read = read_pos_.load(std::memory_order_acquire);
-        return (write >= read) ? (write - read) : (N - read + write);
-    }
-};
-
 } // namespace arbitrage
\ No newline at end of file
@@ -6,19 +6,16 @@
 #include <cmath>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include <functional>
+#include <vector>
 #include "types.h"
 #include "constants.h"
 
 namespace arbitrage {
 namespace utils {
 
-// Time utilities
-inline Timestamp get_current_timestamp() {
-    return std::chrono::duration_cast<std::chrono::nanoseconds>(
-        std::chrono::high_resolution_clock::now().time_since_epoch()
-    );
-}
-
+// Time utilities; the current time comes from Clock (utils/clock.h)
 inline uint64_t timestamp_to_microseconds(const Timestamp& ts) {
     return std::chrono::duration_cast<std::chrono::microseconds>(ts).count();
 }
@@ -221,16 +218,16 @@ inline double calculate_std_dev(const std::vector<T>& values) {
 // Performance measurement utilities
 class ScopedTimer {
 private:
-    std::chrono::high_resolution_clock::time_point start_;
+    std::chrono::steady_clock::time_point start_;
     std::function<void(uint64_t)> callback_;
     
 public:
     explicit ScopedTimer(std::function<void(uint64_t)> callback)
-        : start_(std::chrono::high_resolution_clock::now())
+        : start_(std::chrono::steady_clock::now())
         , callback_(std::move(callback)) {}
     
     ~ScopedTimer() {
-        auto end = std::chrono::high_resolution_clock::now();
+        auto end = std::chrono::steady_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start_).count();
         if (callback_) {
             callback_(duration);
@@ -1,5 +1,9 @@
 #include "binance_websocket.h"
 #include "core/utils.h"
+#include "performance/event_trace.h"
+#include "performance/hw_counters.h"
+#include "utils/thread_registry.h"
+#include "utils/clock.h"
 #include <algorithm>
 #include <cctype>
 
@@ -53,6 +57,7 @@ void BinanceWebSocket::connect() {
         
         // Run io_context in separate thread
         io_thread_ = std::make_unique<std::thread>([this]() {
+            ThreadRegistry::instance().register_current_thread("io-" + config_.name, ThreadRole::IO);
             ws_client_->run();
         });
         
@@ -144,12 +149,17 @@ void BinanceWebSocket::unsubscribe_all() {
 
 void BinanceWebSocket::on_message(WsConnection hdl, WsMessage msg) {
     messages_received_++;
+    ARB_TRACE_INSTANT(FRAME_RECEIVE, 0, exchange_);
     
     try {
         std::string payload = msg->get_payload();
+        ARB_TRACE_SCOPE(PARSE, 0, payload.size());
+        ARB_HW_SCOPE(PARSE);
+        CycleArena::Scope frame(parse_arena_);
         parse_message(payload);
     } catch (const std::exception& e) {
-        LOG_ERROR("Binance message processing error: {}", e.what());
+        LOG_ERROR_EVERY_MS(constants::logging::REPEAT_INTERVAL_MS,
+                           "Binance message processing error: {}", e.what());
     }
 }
 
@@ -158,7 +168,8 @@ void BinanceWebSocket::parse_message(const std::string& message) {
     doc.Parse(message.c_str());
     
     if (doc.HasParseError()) {
-        LOG_ERROR("Binance JSON parse error: {}", message);
+        LOG_ERROR_EVERY_MS(constants::logging::REPEAT_INTERVAL_MS,
+                           "Binance JSON parse error: {}", message);
         return;
     }
     
@@ -241,7 +252,8 @@ void BinanceWebSocket::parse_depth_update(const rapidjson::Document& doc) {
     }
     
     // Convert to vectors for callback
-    std::vector<PriceLevel> bid_levels, ask_levels;
+    std::pmr::vector<PriceLevel> bid_levels(parse_arena_.resource());
+    std::pmr::vector<PriceLevel> ask_levels(parse_arena_.resource());
     
     size_t count = 0;
     for (const auto& [price, qty] : cache.bids) {
@@ -287,7 +299,7 @@ void BinanceWebSocket::parse_ticker_update(const rapidjson::Document& doc) {
     if (doc.HasMember("c")) md.last_price = std::stod(doc["c"].GetString());
     if (doc.HasMember("v")) md.volume_24h = std::stod(doc["v"].GetString());
     
-    md.timestamp = utils::get_current_timestamp();
+    md.timestamp = Clock::now();
     
     update_market_data(md);
 }
@@ -300,6 +312,7 @@ void BinanceWebSocket::parse_mark_price_update(const rapidjson::Document& doc) {
     md.exchange = Exchange::BINANCE;
     md.type = InstrumentType::PERPETUAL;
     md.funding_rate = std::stod(doc["r"].GetString());
+    if (doc.HasMember("p")) md.mark_price = std::stod(doc["p"].GetString());
     md.timestamp = std::chrono::milliseconds(doc["T"].GetInt64());
     
     update_market_data(md);
@@ -1,5 +1,9 @@
 #include "bybit_websocket.h"
 #include "core/utils.h"
+#include "performance/event_trace.h"
+#include "performance/hw_counters.h"
+#include "utils/thread_registry.h"
+#include "utils/clock.h"
 #include <rapidjson/writer.h>
 #include <rapidjson/stringbuffer.h>
 
@@ -35,6 +39,7 @@ void BybitWebSocket::connect() {
         ws_client_->connect(con);
         
         io_thread_ = std::make_unique<std::thread>([this]() {
+            ThreadRegistry::instance().register_current_thread("io-" + config_.name, ThreadRole::IO);
             ws_client_->run();
         });
         
@@ -95,12 +100,17 @@ void BybitWebSocket::unsubscribe_all() {
 
 void BybitWebSocket::on_message(WsConnection hdl, WsMessage msg) {
     messages_received_++;
+    ARB_TRACE_INSTANT(FRAME_RECEIVE, 0, exchange_);
     
     try {
         std::string payload = msg->get_payload();
+        ARB_TRACE_SCOPE(PARSE, 0, payload.size());
+        ARB_HW_SCOPE(PARSE);
+        CycleArena::Scope frame(parse_arena_);
         parse_message(payload);
     } catch (const std::exception& e) {
-        LOG_ERROR("Bybit message processing error: {}", e.what());
+        LOG_ERROR_EVERY_MS(constants::logging::REPEAT_INTERVAL_MS,
+                           "Bybit message processing error: {}", e.what());
     }
 }
 
@@ -125,7 +135,8 @@ void BybitWebSocket::parse_message(const std::string& message) {
             // Parse orderbook data
             const auto& data = doc["data"];
             if (data.HasMember("b") && data.HasMember("a")) {
-                std::vector<PriceLevel> bids, asks;
+                std::pmr::vector<PriceLevel> bids(parse_arena_.resource());
+                std::pmr::vector<PriceLevel> asks(parse_arena_.resource());
                 
                 const auto& b = data["b"];
                 for (const auto& bid : b.GetArray()) {
@@ -167,8 +178,10 @@ void BybitWebSocket::parse_message(const std::string& message) {
                 md.last_price = std::stod(data["lastPrice"].GetString());
             if (data.HasMember("volume24h")) 
                 md.volume_24h = std::stod(data["volume24h"].GetString());
+            if (data.HasMember("markPrice")) 
+                md.mark_price = std::stod(data["markPrice"].GetString());
             
-            md.timestamp = utils::get_current_timestamp();
+            md.timestamp = Clock::now();
             update_market_data(md);
         }
     }
@@ -1,4 +1,8 @@
 #include "exchange_base.h"
+#include "core/utils.h"
+#include "performance/event_trace.h"
+#include "performance/scope_timer.h"
+#include "utils/thread_registry.h"
 #include <thread>
 #include <chrono>
 
@@ -11,6 +15,21 @@ ExchangeBase::ExchangeBase(Exchange exchange, const ExchangeConfig& config)
     , last_heartbeat_(std::chrono::steady_clock::now())
     , last_message_(std::chrono::steady_clock::now()) {
     
+    // Per-exchange, per-channel series
+    auto& registry = MetricRegistry::instance();
+    std::string venue = utils::exchange_to_string(exchange_);
+    
+    ticker_messages_metric_ = registry.register_counter(labelled_metric(
+        "arbitrage_exchange_messages_total", {{"exchange", venue}, {"channel", "ticker"}}));
+    orderbook_messages_metric_ = registry.register_counter(labelled_metric(
+        "arbitrage_exchange_messages_total", {{"exchange", venue}, {"channel", "orderbook"}}));
+    ticker_dispatch_metric_ = registry.register_histogram(labelled_metric(
+        "arbitrage_exchange_dispatch_seconds", {{"exchange", venue}, {"channel", "ticker"}}));
+    orderbook_dispatch_metric_ = registry.register_histogram(labelled_metric(
+        "arbitrage_exchange_dispatch_seconds", {{"exchange", venue}, {"channel", "orderbook"}}));
+    reconnects_metric_ = registry.register_counter(labelled_metric(
+        "arbitrage_exchange_reconnects_total", {{"exchange", venue}}));
+    
     // Initialize WebSocket client
     ws_client_ = std::make_unique<WsClient>();
     
@@ -44,6 +63,7 @@ void ExchangeBase::reconnect() {
     );
     
     reconnect_count_++;
+    MetricRegistry::increment(reconnects_metric_);
     connect();
 }
 
@@ -72,7 +92,11 @@ void ExchangeBase::on_close(WsConnection hdl) {
     // Attempt reconnection if not manually disconnected
     if (reconnect_count_ < constants::MAX_RECONNECT_ATTEMPTS) {
         state_ = ConnectionState::RECONNECTING;
-        std::thread([this]() { reconnect(); }).detach();
+        std::thread([this]() {
+            ThreadRegistry::instance().register_current_thread("reconnect-" + config_.name,
+                                                               ThreadRole::RECONNECT);
+            reconnect();
+        }).detach();
     }
 }
 
@@ -87,7 +111,11 @@ void ExchangeBase::on_fail(WsConnection hdl) {
     // Attempt reconnection
     if (reconnect_count_ < constants::MAX_RECONNECT_ATTEMPTS) {
         state_ = ConnectionState::RECONNECTING;
-        std::thread([this]() { reconnect(); }).detach();
+        std::thread([this]() {
+            ThreadRegistry::instance().register_current_thread("reconnect-" + config_.name,
+                                                               ThreadRole::RECONNECT);
+            reconnect();
+        }).detach();
     }
 }
 
@@ -100,7 +128,8 @@ void ExchangeBase::send_message(const std::string& message) {
     std::lock_guard<std::mutex> lock(connection_mutex_);
     
     if (state_ != ConnectionState::CONNECTED) {
-        LOG_WARN("Cannot send message - not connected to {}", config_.name);
+        LOG_WARN_EVERY_MS(constants::logging::REPEAT_INTERVAL_MS,
+                          "Cannot send message - not connected to {}", config_.name);
         return;
     }
     
@@ -130,20 +159,26 @@ void ExchangeBase::handle_pong() {
 
 void ExchangeBase::update_market_data(const MarketData& data) {
     messages_processed_++;
+    MetricRegistry::increment(ticker_messages_metric_);
     last_message_ = std::chrono::steady_clock::now();
     
     if (market_data_callback_) {
+        ARB_TIME_SCOPE_ID(ticker_dispatch_metric_);
+        ARB_TRACE_SCOPE(DISPATCH, trace::instrument_id(data.symbol), exchange_);
         market_data_callback_(data);
     }
 }
 
 void ExchangeBase::update_orderbook(const Symbol& symbol,
-                                   const std::vector<PriceLevel>& bids,
-                                   const std::vector<PriceLevel>& asks) {
+                                   std::span<const PriceLevel> bids,
+                                   std::span<const PriceLevel> asks) {
     messages_processed_++;
+    MetricRegistry::increment(orderbook_messages_metric_);
     last_message_ = std::chrono::steady_clock::now();
     
     if (orderbook_callback_) {
+        ARB_TIME_SCOPE_ID(orderbook_dispatch_metric_);
+        ARB_TRACE_SCOPE(DISPATCH, trace::instrument_id(symbol), exchange_);
         orderbook_callback_(symbol, bids, asks);
     }
 }
@@ -160,6 +195,8 @@ void ExchangeBase::start_heartbeat_timer() {
     heartbeat_running_ = true;
     
     heartbeat_thread_ = std::make_unique<std::thread>([this]() {
+        ThreadRegistry::instance().register_current_thread("hb-" + config_.name, ThreadRole::HEARTBEAT);
+        
         while (heartbeat_running_) {
             std::this_thread::sleep_for(
                 std::chrono::milliseconds(config_.heartbeat_interval_ms)
@@ -5,11 +5,14 @@
 #include <functional>
 #include <atomic>
 #include <chrono>
+#include <span>
 #include <websocketpp/config/asio_client.hpp>
 #include <websocketpp/client.hpp>
 #include "core/types.h"
 #include "core/constants.h"
 #include "utils/logger.h"
+#include "utils/cycle_arena.h"
+#include "performance/metric_shards.h"
 
 namespace arbitrage {
 
@@ -32,7 +35,7 @@ enum class ConnectionState {
 
 // Callback types
 using MarketDataCallback = std::function<void(const MarketData&)>;
-using OrderBookCallback = std::function<void(const Symbol&, const std::vector<PriceLevel>&, const std::vector<PriceLevel>&)>;
+using OrderBookCallback = std::function<void(const Symbol&, std::span<const PriceLevel>, std::span<const PriceLevel>)>;
 using ErrorCallback = std::function<void(const std::string&)>;
 
 class ExchangeBase {
@@ -98,8 +101,8 @@ protected:
     // Update market data
     void update_market_data(const MarketData& data);
     void update_orderbook(const Symbol& symbol, 
-                         const std::vector<PriceLevel>& bids,
-                         const std::vector<PriceLevel>& asks);
+                         std::span<const PriceLevel> bids,
+                         std::span<const PriceLevel> asks);
     
     // Error handling
     void handle_error(const std::string& error);
@@ -118,11 +121,21 @@ protected:
     OrderBookCallback orderbook_callback_;
     ErrorCallback error_callback_;
     
+    // Scratch for decoding one frame, reset after each message
+    CycleArena parse_arena_;
+    
     // Statistics
     std::atomic<uint64_t> messages_received_{0};
     std::atomic<uint64_t> messages_processed_{0};
     std::atomic<uint64_t> reconnect_count_{0};
     
+    // Labelled metric series for this venue, resolved once at construction
+    MetricId ticker_messages_metric_;
+    MetricId orderbook_messages_metric_;
+    MetricId ticker_dispatch_metric_;
+    MetricId orderbook_dispatch_metric_;
+    MetricId reconnects_metric_;
+    
     // Timing
     std::chrono::steady_clock::time_point last_heartbeat_;
     std::chrono::steady_clock::time_point last_message_;
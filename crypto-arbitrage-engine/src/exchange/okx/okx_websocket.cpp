@@ -1,5 +1,8 @@
 #include "okx_websocket.h"
 #include "core/utils.h"
+#include "performance/event_trace.h"
+#include "performance/hw_counters.h"
+#include "utils/thread_registry.h"
 #include <rapidjson/writer.h>
 #include <rapidjson/stringbuffer.h>
 #include <sstream>
@@ -44,6 +47,7 @@ void OKXWebSocket::connect() {
         
         // Run io_context in separate thread
         io_thread_ = std::make_unique<std::thread>([this]() {
+            ThreadRegistry::instance().register_current_thread("io-" + config_.name, ThreadRole::IO);
             ws_client_->run();
         });
         
@@ -120,12 +124,17 @@ void OKXWebSocket::unsubscribe_all() {
 
 void OKXWebSocket::on_message(WsConnection hdl, WsMessage msg) {
     messages_received_++;
+    ARB_TRACE_INSTANT(FRAME_RECEIVE, 0, exchange_);
     
     try {
         std::string payload = msg->get_payload();
+        ARB_TRACE_SCOPE(PARSE, 0, payload.size());
+        ARB_HW_SCOPE(PARSE);
+        CycleArena::Scope frame(parse_arena_);
         parse_message(payload);
     } catch (const std::exception& e) {
-        LOG_ERROR("OKX message processing error: {}", e.what());
+        LOG_ERROR_EVERY_MS(constants::logging::REPEAT_INTERVAL_MS,
+                           "OKX message processing error: {}", e.what());
     }
 }
 
@@ -134,7 +143,8 @@ void OKXWebSocket::parse_message(const std::string& message) {
     doc.Parse(message.c_str());
     
     if (doc.HasParseError()) {
-        LOG_ERROR("OKX JSON parse error: {}", message);
+        LOG_ERROR_EVERY_MS(constants::logging::REPEAT_INTERVAL_MS,
+                           "OKX JSON parse error: {}", message);
         return;
     }
     
@@ -189,7 +199,8 @@ void OKXWebSocket::parse_orderbook_message(const rapidjson::Value& data) {
         
         std::string inst_id = item["instId"].GetString();
         
-        std::vector<PriceLevel> bids, asks;
+        std::pmr::vector<PriceLevel> bids(parse_arena_.resource());
+        std::pmr::vector<PriceLevel> asks(parse_arena_.resource());
         
         // Parse bids
         const auto& bids_array = item["bids"];
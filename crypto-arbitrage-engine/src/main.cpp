@@ -4,6 +4,7 @@
 #include <fstream>
 
 #include "utils/logger.h"
+#include "utils/binary_log.h"
 #include "utils/thread_pool.h"
 #include "market_data/market_data_manager.h"
 #include "exchange/okx/okx_websocket.h"
@@ -11,18 +12,32 @@
 #include "exchange/bybit/bybit_websocket.h"
 #include "arbitrage/arbitrage_detector.h"
 #include "risk/risk_manager.h"
+#include "performance/event_trace.h"
+#include "performance/hw_counters.h"
 #include "performance/metrics_collector.h"
+#include "performance/metrics_server.h"
+#include "performance/performance_monitor.h"
+#include "utils/huge_page_arena.h"
+#include "utils/clock.h"
+#include "utils/thread_placement.h"
+#include "utils/wait_strategy.h"
+#include "utils/thread_registry.h"
 
 using namespace arbitrage;
 
 // Global flag for shutdown
 std::atomic<bool> g_shutdown{false};
 
+// Set by SIGUSR1; the main loop writes a trace dump
+std::atomic<bool> g_trace_dump_requested{false};
+
 // Signal handler
 void signal_handler(int signal) {
     if (signal == SIGINT || signal == SIGTERM) {
         LOG_INFO("Shutdown signal received");
         g_shutdown = true;
+    } else if (signal == SIGUSR1) {
+        g_trace_dump_requested = true;
     }
 }
 
@@ -53,12 +68,29 @@ bool load_config(const std::string& config_file,
         
         if (sys.HasMember("thread_pool_size"))
             system_config.thread_pool_size = sys["thread_pool_size"].GetUint();
+        if (sys.HasMember("thread_pool_cores") && sys["thread_pool_cores"].IsArray()) {
+            for (const auto& core : sys["thread_pool_cores"].GetArray())
+                system_config.thread_pool_cores.push_back(core.GetInt());
+        }
         if (sys.HasMember("order_book_depth"))
             system_config.order_book_depth = sys["order_book_depth"].GetUint();
+        if (sys.HasMember("huge_pages") && sys["huge_pages"].IsObject()) {
+            const auto& huge_pages = sys["huge_pages"];
+            if (huge_pages.HasMember("enabled"))
+                system_config.huge_pages = huge_pages["enabled"].GetBool();
+            if (huge_pages.HasMember("arena_mb"))
+                system_config.huge_page_arena_mb = huge_pages["arena_mb"].GetUint();
+            if (huge_pages.HasMember("lock"))
+                system_config.lock_huge_pages = huge_pages["lock"].GetBool();
+        }
         if (sys.HasMember("log_level"))
             system_config.log_level = sys["log_level"].GetString();
         if (sys.HasMember("log_file"))
             system_config.log_file = sys["log_file"].GetString();
+        if (sys.HasMember("async_logging"))
+            system_config.async_logging = sys["async_logging"].GetBool();
+        if (sys.HasMember("binary_log_file"))
+            system_config.binary_log_file = sys["binary_log_file"].GetString();
     }
     
     // Load arbitrage config
@@ -74,6 +106,128 @@ bool load_config(const std::string& config_file,
     return true;
 }
 
+struct ThreadingConfig {
+    ThreadPlacement::Config placement;
+    WaitStrategy::Config waits[THREAD_ROLE_COUNT];
+};
+
+// Load per-role core pinning, SCHED_FIFO priorities, NUMA placement and
+// wait strategies
+ThreadingConfig load_threading_config(const std::string& config_file) {
+    ThreadingConfig threading;
+    
+    std::ifstream file(config_file);
+    if (!file.is_open()) {
+        return threading;
+    }
+    
+    std::string content((std::istreambuf_iterator<char>(file)),
+                       std::istreambuf_iterator<char>());
+    
+    rapidjson::Document doc;
+    doc.Parse(content.c_str());
+    
+    if (doc.HasParseError() || !doc.HasMember("threading")) {
+        return threading;
+    }
+    
+    for (const auto& entry : doc["threading"].GetObject()) {
+        std::string name = entry.name.GetString();
+        
+        ThreadRole role;
+        if (!thread_role_from_string(name, role)) {
+            LOG_WARN("Unknown thread role in threading config: {}", name);
+            continue;
+        }
+        
+        auto& policy = threading.placement.roles[static_cast<size_t>(role)];
+        auto& wait = threading.waits[static_cast<size_t>(role)];
+        const auto& value = entry.value;
+        
+        if (value.HasMember("cores") && value["cores"].IsArray()) {
+            for (const auto& core : value["cores"].GetArray())
+                policy.cores.push_back(core.GetInt());
+        }
+        if (value.HasMember("fifo_priority"))
+            policy.fifo_priority = value["fifo_priority"].GetInt();
+        if (value.HasMember("numa_local"))
+            policy.numa_local = value["numa_local"].GetBool();
+        if (value.HasMember("wait") &&
+            !WaitStrategy::kind_from_string(value["wait"].GetString(), wait.kind)) {
+            LOG_WARN("Unknown wait strategy for {}: {}", name, value["wait"].GetString());
+        }
+        if (value.HasMember("spin_iterations"))
+            wait.spin_iterations = value["spin_iterations"].GetUint();
+    }
+    
+    return threading;
+}
+
+// Load per-venue margin models and liquidation thresholds
+void load_risk_config(const std::string& config_file, RiskManager& risk_manager) {
+    std::ifstream file(config_file);
+    if (!file.is_open()) {
+        return;
+    }
+    
+    std::string content((std::istreambuf_iterator<char>(file)),
+                       std::istreambuf_iterator<char>());
+    
+    rapidjson::Document doc;
+    doc.Parse(content.c_str());
+    
+    if (doc.HasParseError() || !doc.HasMember("risk")) {
+        return;
+    }
+    
+    const auto& risk = doc["risk"];
+    
+    if (risk.HasMember("liquidation")) {
+        const auto& liq = risk["liquidation"];
+        LiquidationMonitor::Config liq_config;
+        
+        if (liq.HasMember("warning_distance"))
+            liq_config.warning_distance = liq["warning_distance"].GetDouble();
+        if (liq.HasMember("critical_distance"))
+            liq_config.critical_distance = liq["critical_distance"].GetDouble();
+        
+        risk_manager.set_liquidation_config(liq_config);
+    }
+    
+    if (risk.HasMember("margin")) {
+        for (const auto& venue : risk["margin"].GetObject()) {
+            std::string name = venue.name.GetString();
+            
+            MarginModel model;
+            if (name == "OKX") {
+                model.exchange = Exchange::OKX;
+            } else if (name == "BINANCE") {
+                model.exchange = Exchange::BINANCE;
+            } else if (name == "BYBIT") {
+                model.exchange = Exchange::BYBIT;
+            } else {
+                LOG_WARN("Unknown exchange in margin config: {}", name);
+                continue;
+            }
+            
+            if (venue.value.HasMember("default_leverage"))
+                model.default_leverage = venue.value["default_leverage"].GetDouble();
+            
+            if (venue.value.HasMember("tiers")) {
+                for (const auto& tier : venue.value["tiers"].GetArray()) {
+                    model.tiers.push_back({
+                        tier["max_notional"].GetDouble(),
+                        tier["maintenance_margin_rate"].GetDouble(),
+                        tier["max_leverage"].GetDouble()
+                    });
+                }
+            }
+            
+            risk_manager.set_margin_model(model);
+        }
+    }
+}
+
 // Load exchange configuration
 std::vector<ExchangeConfig> load_exchange_config(const std::string& config_file) {
     std::vector<ExchangeConfig> configs;
@@ -128,10 +282,105 @@ std::vector<ExchangeConfig> load_exchange_config(const std::string& config_file)
     return configs;
 }
 
+// Load metrics exposition settings and SLOs; returns the scrape port (0 disables the endpoint)
+uint16_t load_performance_config(const std::string& config_file, MetricsCollector& metrics,
+                                 PerformanceMonitor::SloConfig& slo, std::string& metrics_bind_address) {
+    std::ifstream file(config_file);
+    if (!file.is_open()) {
+        return 0;
+    }
+    
+    std::string content((std::istreambuf_iterator<char>(file)),
+                       std::istreambuf_iterator<char>());
+    
+    rapidjson::Document doc;
+    doc.Parse(content.c_str());
+    
+    if (doc.HasParseError() || !doc.HasMember("performance")) {
+        return 0;
+    }
+    
+    const auto& perf = doc["performance"];
+    
+    if (perf.HasMember("metrics_render_interval_ms"))
+        metrics.set_exposition_interval(
+            std::chrono::milliseconds(perf["metrics_render_interval_ms"].GetUint()));
+    
+    if (perf.HasMember("latency_target_ms"))
+        slo.tick_to_signal_p99_us = perf["latency_target_ms"].GetDouble() * 1000.0;
+    if (perf.HasMember("cpu_usage_warning_threshold"))
+        slo.max_cpu_percent = perf["cpu_usage_warning_threshold"].GetDouble();
+    if (perf.HasMember("memory_usage_warning_mb"))
+        slo.max_memory_mb = perf["memory_usage_warning_mb"].GetUint64();
+    
+    if (perf.HasMember("slo")) {
+        const auto& slo_config = perf["slo"];
+        
+        if (slo_config.HasMember("tick_to_signal_p99_us"))
+            slo.tick_to_signal_p99_us = slo_config["tick_to_signal_p99_us"].GetDouble();
+        if (slo_config.HasMember("detection_p99_us"))
+            slo.detection_p99_us = slo_config["detection_p99_us"].GetDouble();
+        if (slo_config.HasMember("min_latency_samples"))
+            slo.min_latency_samples = slo_config["min_latency_samples"].GetUint64();
+        if (slo_config.HasMember("min_hit_rate"))
+            slo.min_hit_rate = slo_config["min_hit_rate"].GetDouble();
+        if (slo_config.HasMember("window_seconds"))
+            slo.window = std::chrono::seconds(slo_config["window_seconds"].GetUint());
+        if (slo_config.HasMember("evaluation_interval_seconds"))
+            slo.evaluation_interval = std::chrono::seconds(slo_config["evaluation_interval_seconds"].GetUint());
+        if (slo_config.HasMember("alert_retention_seconds"))
+            slo.alert_retention = std::chrono::seconds(slo_config["alert_retention_seconds"].GetUint());
+        
+        if (slo_config.HasMember("min_messages_per_second")) {
+            for (const auto& venue : slo_config["min_messages_per_second"].GetObject()) {
+                std::string name = venue.name.GetString();
+                
+                if (name == "OKX") {
+                    slo.min_messages_per_second[Exchange::OKX] = venue.value.GetDouble();
+                } else if (name == "BINANCE") {
+                    slo.min_messages_per_second[Exchange::BINANCE] = venue.value.GetDouble();
+                } else if (name == "BYBIT") {
+                    slo.min_messages_per_second[Exchange::BYBIT] = venue.value.GetDouble();
+                } else {
+                    LOG_WARN("Unknown exchange in SLO config: {}", name);
+                }
+            }
+        }
+    }
+    
+    if (perf.HasMember("hw_counters") && perf["hw_counters"].GetBool())
+        HwCounters::enable();
+    
+    if (perf.HasMember("tracing")) {
+        const auto& tracing = perf["tracing"];
+        EventTracer::Config trace_config;
+        
+        if (tracing.HasMember("ring_capacity"))
+            trace_config.ring_capacity = tracing["ring_capacity"].GetUint();
+        if (tracing.HasMember("dump_window_ms"))
+            trace_config.dump_window = std::chrono::milliseconds(tracing["dump_window_ms"].GetUint());
+        if (tracing.HasMember("min_dump_interval_seconds"))
+            trace_config.min_dump_interval = std::chrono::seconds(tracing["min_dump_interval_seconds"].GetUint());
+        if (tracing.HasMember("dump_directory"))
+            trace_config.dump_directory = tracing["dump_directory"].GetString();
+        
+        EventTracer::instance().configure(trace_config);
+    }
+    
+    if (perf.HasMember("metrics_bind_address"))
+        metrics_bind_address = perf["metrics_bind_address"].GetString();
+    
+    if (perf.HasMember("metrics_port"))
+        return static_cast<uint16_t>(perf["metrics_port"].GetUint());
+    
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
     // Set up signal handlers
     signal(SIGINT, signal_handler);
     signal(SIGTERM, signal_handler);
+    signal(SIGUSR1, signal_handler);
     
     // Load configuration
     std::string config_file = "config/config.json";
@@ -156,13 +405,72 @@ int main(int argc, char* argv[]) {
     Logger::init(system_config.log_file, system_config.log_level);
     
     LOG_INFO("=== Crypto Arbitrage Engine Starting ===");
+    
+    ThreadRegistry::instance().register_current_thread("main", ThreadRole::OTHER);
+    
+    // Scope timers and wall-clock stamps convert TSC ticks with this calibration
+    Clock::calibrate();
     LOG_INFO("Config: {}", config_file);
-    LOG_INFO("Thread pool size: {}", system_config.thread_pool_size);
     LOG_INFO("Min profit threshold: {:.2f} bps", arbitrage_config.min_profit_threshold);
     
+    // Placement applies as threads register, so it must precede them
+    ThreadingConfig threading = load_threading_config(config_file);
+    ThreadPlacement::configure(threading.placement);
+    for (size_t i = 0; i < THREAD_ROLE_COUNT; ++i) {
+        auto role = static_cast<ThreadRole>(i);
+        WaitStrategy::configure(role, threading.waits[i]);
+        if (threading.waits[i].kind == WaitStrategy::Kind::SPIN && threading.placement.roles[i].cores.empty()) {
+            LOG_WARN("{} threads busy-spin without dedicated cores", thread_role_to_string(role));
+        }
+    }
+    
+    // The log writer is a placed thread like any other
+    if (system_config.async_logging) {
+        Logger::enable_async(system_config.binary_log_file);
+    }
+    
+    // Map and pre-fault the huge page arena before books and pools exist
+    HugePageArena::Config huge_page_config;
+    huge_page_config.enabled = system_config.huge_pages;
+    huge_page_config.size_bytes = size_t(system_config.huge_page_arena_mb) << 20;
+    huge_page_config.lock = system_config.lock_huge_pages;
+    HugePageArena::configure(huge_page_config);
+    
     try {
-        // Initialize thread pool
-        ThreadPool thread_pool(system_config.thread_pool_size);
+        // Initialize the shared pool that parallel_for / parallel_reduce run on;
+        // configure() only applies before the first instance() call
+        ThreadPool::Config pool_config;
+        pool_config.num_threads = system_config.thread_pool_size;
+        pool_config.cores = system_config.thread_pool_cores;
+        pool_config.wait = WaitStrategy::for_role(ThreadRole::POOL);
+        
+        // Size 0 gives one worker per pool core (thread_pool_cores, else the
+        // pool role's cores), or one per CPU when the pool is unpinned
+        const auto& pool_cores = !pool_config.cores.empty()
+            ? pool_config.cores
+            : threading.placement.roles[static_cast<size_t>(ThreadRole::POOL)].cores;
+        if (pool_config.num_threads == 0) {
+            pool_config.num_threads = pool_cores.empty() ? std::thread::hardware_concurrency()
+                                                         : pool_cores.size();
+        } else if (!pool_cores.empty() && pool_config.num_threads > pool_cores.size()) {
+            LOG_WARN("Thread pool oversubscribed: {} workers on {} cores", pool_config.num_threads,
+                     pool_cores.size());
+        }
+        LOG_INFO("Thread pool size: {}", pool_config.num_threads);
+        GlobalThreadPool::configure(pool_config);
+        GlobalThreadPool::instance();
+        
+        // Prometheus scrape endpoint
+        std::unique_ptr<MetricsServer> metrics_server;
+        PerformanceMonitor::SloConfig slo_config;
+        std::string metrics_bind_address = "127.0.0.1";
+        uint16_t metrics_port = load_performance_config(config_file, GlobalMetrics::instance(), slo_config,
+                                                        metrics_bind_address);
+        if (metrics_port != 0) {
+            metrics_server = std::make_unique<MetricsServer>(&GlobalMetrics::instance(), metrics_port,
+                                                             metrics_bind_address);
+            metrics_server->start();
+        }
         
         // Initialize market data manager
         auto market_data = std::make_unique<MarketDataManager>();
@@ -185,6 +493,17 @@ int main(int argc, char* argv[]) {
         // Initialize risk manager
         auto risk_manager = std::make_unique<RiskManager>(market_data.get());
         risk_manager->set_max_portfolio_exposure(arbitrage_config.max_portfolio_exposure);
+        load_risk_config(config_file, *risk_manager);
+        
+        // Feed perpetual marks into the liquidation monitor
+        market_data->register_market_data_callback(
+            [&risk_manager](const MarketData& data) {
+                if (data.type == InstrumentType::SPOT) return;
+                
+                Price mark = data.mark_price > 0.0 ? data.mark_price : data.mid_price();
+                risk_manager->on_mark_price(data.symbol, data.exchange, mark);
+            }
+        );
         
         // Initialize arbitrage detector
         auto arbitrage_detector = std::make_unique<ArbitrageDetector>(
@@ -197,21 +516,23 @@ int main(int argc, char* argv[]) {
         // Set up opportunity callback
         arbitrage_detector->register_opportunity_callback(
             [&risk_manager](const ArbitrageOpportunity& opportunity) {
-                LOG_INFO("Arbitrage opportunity detected: {}", opportunity.id);
-                LOG_INFO("  Type: {} arbitrage", 
+                LOG_FAST_INFO("Arbitrage opportunity detected: {}", opportunity.id);
+                LOG_FAST_INFO("  Type: {} arbitrage", 
                         opportunity.legs.size() == 2 ? "Simple" : "Complex");
-                LOG_INFO("  Expected profit: ${:.2f} ({:.2f}%)", 
+                LOG_FAST_INFO("  Expected profit: ${:.2f} ({:.2f}%)", 
                         opportunity.expected_profit, 
                         opportunity.profit_percentage);
-                LOG_INFO("  Required capital: ${:.2f}", opportunity.required_capital);
-                LOG_INFO("  Execution risk: {:.2f}", opportunity.execution_risk);
+                LOG_FAST_INFO("  Required capital: ${:.2f}", opportunity.required_capital);
+                LOG_FAST_INFO("  Execution risk: {:.2f}", opportunity.execution_risk);
                 
                 // Check risk before execution
                 if (risk_manager->check_opportunity_risk(opportunity)) {
-                    LOG_INFO("  Risk check: PASSED - Ready for execution");
+                    LOG_FAST_INFO("  Risk check: PASSED - Ready for execution");
                     GlobalMetrics::instance().increment_opportunities_executed();
                 } else {
-                    LOG_WARN("  Risk check: FAILED - Opportunity rejected");
+                    LOG_FAST_WARN_EVERY_MS(constants::logging::REPEAT_INTERVAL_MS,
+                                           "  Risk check: FAILED - Opportunity rejected");
+                    MetricRegistry::increment(metrics::id(metrics::Counter::RISK_REJECTIONS));
                 }
             }
         );
@@ -234,6 +555,21 @@ int main(int argc, char* argv[]) {
         LOG_INFO("Starting arbitrage detection...");
         arbitrage_detector->start();
         
+        // SLO evaluation on its own low-priority thread
+        PerformanceMonitor performance_monitor(&GlobalMetrics::instance(), market_data.get(),
+                                               arbitrage_detector.get(), risk_manager.get());
+        performance_monitor.set_slo_config(slo_config);
+        
+        // Capture what led up to a latency SLO breach (rate limited by the tracer)
+        performance_monitor.register_alert_callback(
+            [](const PerformanceMonitor::PerformanceAlert& alert) {
+                if (alert.type == PerformanceMonitor::PerformanceAlert::HIGH_LATENCY) {
+                    EventTracer::instance().dump("slo-" + alert.source);
+                }
+            }
+        );
+        performance_monitor.start();
+        
         // Main loop
         LOG_INFO("=== Engine Running ===");
         LOG_INFO("Press Ctrl+C to shutdown");
@@ -243,6 +579,10 @@ int main(int argc, char* argv[]) {
         while (!g_shutdown) {
             std::this_thread::sleep_for(std::chrono::seconds(1));
             
+            if (g_trace_dump_requested.exchange(false)) {
+                EventTracer::instance().dump("manual", true);
+            }
+            
             // Print statistics every 30 seconds
             auto now = std::chrono::steady_clock::now();
             if (now - last_stats_time > std::chrono::seconds(30)) {
@@ -266,9 +606,14 @@ int main(int argc, char* argv[]) {
         // Shutdown sequence
         LOG_INFO("Shutting down...");
         
+        performance_monitor.stop();
         arbitrage_detector->stop();
         market_data->stop();
         
+        if (metrics_server) {
+            metrics_server->stop();
+        }
+        
         // Final statistics
         auto final_metrics = GlobalMetrics::instance().get_detailed_statistics();
         
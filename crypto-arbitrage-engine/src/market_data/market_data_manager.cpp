@@ -1,11 +1,19 @@
 #include "market_data_manager.h"
 #include "exchange/exchange_base.h"
+#include "performance/event_trace.h"
+#include "performance/hw_counters.h"
+#include "performance/metrics_collector.h"
+#include "performance/scope_timer.h"
+#include "utils/huge_page_arena.h"
 #include "utils/logger.h"
+#include "utils/thread_registry.h"
+#include "utils/clock.h"
 #include <algorithm>
 
 namespace arbitrage {
 
-MarketDataManager::MarketDataManager() {
+MarketDataManager::MarketDataManager()
+    : market_data_(MarketDataMap::allocator_type(HugePageArena::resource())) {
 }
 
 MarketDataManager::~MarketDataManager() {
@@ -20,8 +28,8 @@ void MarketDataManager::add_exchange(std::unique_ptr<ExchangeBase> exchange) {
     
     exchange->set_orderbook_callback(
         [this, ex = exchange->get_exchange()](const Symbol& symbol, 
-                                             const std::vector<PriceLevel>& bids,
-                                             const std::vector<PriceLevel>& asks) {
+                                             std::span<const PriceLevel> bids,
+                                             std::span<const PriceLevel> asks) {
             handle_orderbook_update(symbol, ex, InstrumentType::SPOT, bids, asks);
         }
     );
@@ -41,6 +49,7 @@ void MarketDataManager::start() {
     
     // Start statistics thread
     stats_thread_ = std::make_unique<std::thread>([this]() {
+        ThreadRegistry::instance().register_current_thread("md-stats", ThreadRole::STATS);
         update_statistics();
     });
     
@@ -51,6 +60,7 @@ void MarketDataManager::stop() {
     if (!running_) return;
     
     running_ = false;
+    stop_signal_.notify_all();
     
     // Disconnect all exchanges
     for (auto& exchange : exchanges_) {
@@ -81,6 +91,8 @@ void MarketDataManager::subscribe_symbol(const Symbol& symbol, Exchange exchange
 }
 
 void MarketDataManager::subscribe_all_exchanges(const Symbol& symbol, InstrumentType type) {
+    EventTracer::instance().register_instrument(symbol);
+    
     for (auto& exchange : exchanges_) {
         exchange->subscribe_orderbook(symbol, type);
         exchange->subscribe_ticker(symbol, type);
@@ -164,7 +176,12 @@ void MarketDataManager::register_orderbook_callback(OrderBookCallback callback)
 }
 
 void MarketDataManager::handle_market_data(const MarketData& data) {
+    ARB_TIME_SCOPE(MARKET_DATA_UPDATE);
+    ARB_TRACE_SCOPE(BOOK_APPLY, trace::instrument_id(data.symbol), data.exchange);
+    ARB_HW_SCOPE(TICK_UPDATE);
+    
     total_updates_++;
+    GlobalMetrics::instance().increment_messages_processed();
     
     // Update market data
     MarketDataKey key{data.symbol, data.exchange, data.type};
@@ -172,7 +189,9 @@ void MarketDataManager::handle_market_data(const MarketData& data) {
         MarketDataMap::accessor accessor;
         market_data_.insert(accessor, key);
         accessor->second = data;
+        accessor->second.received_tsc = TscClock::now();
     }
+    update_signal_.notify_all();
     
     // Notify callbacks
     {
@@ -185,8 +204,14 @@ void MarketDataManager::handle_market_data(const MarketData& data) {
 
 void MarketDataManager::handle_orderbook_update(const Symbol& symbol, Exchange exchange, 
                                                InstrumentType type,
-                                               const std::vector<PriceLevel>& bids,
-                                               const std::vector<PriceLevel>& asks) {
+                                               std::span<const PriceLevel> bids,
+                                               std::span<const PriceLevel> asks) {
+    ARB_TIME_SCOPE(ORDERBOOK_UPDATE);
+    ARB_TRACE_SCOPE(BOOK_APPLY, trace::instrument_id(symbol), exchange);
+    ARB_HW_SCOPE(BOOK_UPDATE);
+    
+    GlobalMetrics::instance().increment_messages_processed();
+    
     MarketDataKey key{symbol, exchange, type};
     
     // Update lock-free order book
@@ -194,18 +219,20 @@ void MarketDataManager::handle_orderbook_update(const Symbol& symbol, Exchange e
         OrderBookMap::accessor accessor;
         if (!order_books_.find(accessor, key)) {
             order_books_.insert(accessor, key);
-            accessor->second = std::make_shared<LockFreeOrderBook<>>();
+            accessor->second = std::allocate_shared<LockFreeOrderBook<>>(
+                std::pmr::polymorphic_allocator<LockFreeOrderBook<>>(HugePageArena::resource()));
         }
         
         accessor->second->update_bids(bids.data(), bids.size());
         accessor->second->update_asks(asks.data(), asks.size());
     }
+    update_signal_.notify_all();
     
     // Create snapshot for callbacks
     OrderBook::Snapshot snapshot;
-    snapshot.bids = bids;
-    snapshot.asks = asks;
-    snapshot.timestamp = utils::get_current_timestamp();
+    snapshot.bids.assign(bids.begin(), bids.end());
+    snapshot.asks.assign(asks.begin(), asks.end());
+    snapshot.timestamp = Clock::now();
     
     // Notify callbacks
     {
@@ -217,8 +244,11 @@ void MarketDataManager::handle_orderbook_update(const Symbol& symbol, Exchange e
 }
 
 void MarketDataManager::update_statistics() {
+    WaitStrategy wait(WaitStrategy::for_role(ThreadRole::STATS));
+    uint32_t seen = stop_signal_.epoch();
+    
     while (running_) {
-        std::this_thread::sleep_for(std::chrono::seconds(1));
+        wait.wait(stop_signal_, seen, WaitStrategy::Clock::now() + std::chrono::seconds(1));
         // Update statistics
     }
 }
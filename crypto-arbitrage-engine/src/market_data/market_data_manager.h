@@ -2,9 +2,12 @@
 
 #include "core/types.h"
 #include "order_book.h"
+#include "utils/wait_strategy.h"
 #include <unordered_map>
 #include <memory>
+#include <memory_resource>
 #include <shared_mutex>
+#include <span>
 #include <tbb/concurrent_hash_map.h>
 
 namespace arbitrage {
@@ -80,6 +83,10 @@ public:
     void register_market_data_callback(MarketDataCallback callback);
     void register_orderbook_callback(OrderBookCallback callback);
     
+    // Notified after every applied ticker or book update, so consumers
+    // such as the detector can wake on fresh data instead of a timer
+    WakeSignal& update_signal() { return update_signal_; }
+    
     // Statistics
     struct Statistics {
         uint64_t total_updates;
@@ -94,8 +101,11 @@ private:
     // Exchange connections
     std::vector<std::unique_ptr<ExchangeBase>> exchanges_;
     
-    // Market data storage - using TBB concurrent hash map for lock-free access
-    using MarketDataMap = tbb::concurrent_hash_map<MarketDataKey, MarketData, MarketDataKeyHash>;
+    // Market data storage - using TBB concurrent hash map for lock-free access.
+    // The top-of-book table and the books themselves live in the huge page
+    // arena when it is enabled.
+    using MarketDataMap = tbb::concurrent_hash_map<MarketDataKey, MarketData, MarketDataKeyHash,
+        std::pmr::polymorphic_allocator<std::pair<const MarketDataKey, MarketData>>>;
     using OrderBookMap = tbb::concurrent_hash_map<MarketDataKey, std::shared_ptr<LockFreeOrderBook<>>, MarketDataKeyHash>;
     
     MarketDataMap market_data_;
@@ -109,12 +119,14 @@ private:
     // Statistics
     std::atomic<uint64_t> total_updates_{0};
     std::atomic<bool> running_{false};
+    WakeSignal update_signal_;
+    WakeSignal stop_signal_;
     
     // Handlers for exchange callbacks
     void handle_market_data(const MarketData& data);
     void handle_orderbook_update(const Symbol& symbol, Exchange exchange, InstrumentType type,
-                                const std::vector<PriceLevel>& bids,
-                                const std::vector<PriceLevel>& asks);
+                                std::span<const PriceLevel> bids,
+                                std::span<const PriceLevel> asks);
     
     // Update thread for statistics
     std::unique_ptr<std::thread> stats_thread_;
@@ -20,7 +20,7 @@ void OrderBook::update(const std::vector<PriceLevel>& bids,
         asks_[ask.price] = ask;
     }
     
-    last_update_ = utils::get_current_timestamp();
+    last_update_tsc_ = Clock::ticks();
 }
 
 bool OrderBook::get_best_bid(PriceLevel& level) const {
@@ -288,7 +288,7 @@ OrderBook::Snapshot OrderBook::get_snapshot() const {
     std::shared_lock<std::shared_mutex> lock(mutex_);
     
     Snapshot snapshot;
-    snapshot.timestamp = last_update_;
+    snapshot.timestamp = Clock::to_wall(last_update_tsc_);
     
     for (const auto& [price, level] : bids_) {
         snapshot.bids.push_back(level);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/types.h"
+#include "utils/clock.h"
 #include <map>
 #include <vector>
 #include <shared_mutex>
@@ -54,7 +55,7 @@ public:
     bool is_valid() const;
     
     // Get update timestamp
-    Timestamp get_last_update() const { return last_update_; }
+    Timestamp get_last_update() const { return Clock::to_wall(last_update_tsc_); }
     
     // Thread-safe snapshot
     struct Snapshot {
@@ -72,8 +73,8 @@ private:
     // Ask levels (price -> level) in ascending order
     std::map<Price, PriceLevel> asks_;
     
-    // Last update timestamp
-    Timestamp last_update_;
+    // Last update, Clock ticks; converted to wall time when read
+    Clock::Ticks last_update_tsc_ = 0;
     
     // Thread safety
     mutable std::shared_mutex mutex_;
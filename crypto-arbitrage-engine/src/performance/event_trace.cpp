@@ -0,0 +1,245 @@
+#include "event_trace.h"
+#include "utils/logger.h"
+#include "utils/thread_registry.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <pthread.h>
+
+namespace arbitrage {
+
+thread_local TraceRing* EventTracer::tls_ring_ = nullptr;
+
+namespace {
+
+// Returns the calling thread's ring to the tracer on thread exit
+struct TraceRingOwner {
+    TraceRing* ring = nullptr;
+    std::function<void(TraceRing*)> on_exit;
+
+    ~TraceRingOwner() {
+        if (ring && on_exit) {
+            on_exit(ring);
+        }
+    }
+};
+
+size_t round_up_to_power_of_two(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+std::string current_thread_name() {
+    char name[16] = {};
+    if (pthread_getname_np(pthread_self(), name, sizeof(name)) != 0) {
+        return "unknown";
+    }
+    return name;
+}
+
+template <size_t N>
+void copy_name(char (&target)[N], const std::string& source) {
+    std::memset(target, 0, N);
+    std::memcpy(target, source.data(), std::min(source.size(), N - 1));
+}
+
+} // namespace
+
+TraceRing::TraceRing(size_t capacity, pid_t tid, std::string name)
+    : records_(new trace::TraceRecord[round_up_to_power_of_two(std::max<size_t>(capacity, 2))]())
+    , capacity_(round_up_to_power_of_two(std::max<size_t>(capacity, 2)))
+    , mask_(capacity_ - 1)
+    , tid_(tid)
+    , name_(std::move(name)) {
+}
+
+void TraceRing::snapshot(uint64_t since_tsc, std::vector<trace::TraceRecord>& out) const {
+    uint64_t end = head_.load(std::memory_order_acquire);
+    uint64_t begin = end > capacity_ ? end - capacity_ : 0;
+
+    std::vector<trace::TraceRecord> copy(end - begin);
+    for (uint64_t index = begin; index < end; ++index) {
+        copy[index - begin] = records_[index & mask_];
+    }
+
+    // Anything the owner may have started overwriting during the copy is dropped
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t after = head_.load(std::memory_order_relaxed);
+    uint64_t valid_from = after + 1 > capacity_ ? after + 1 - capacity_ : 0;
+
+    for (uint64_t index = std::max(begin, valid_from); index < end; ++index) {
+        const auto& record = copy[index - begin];
+        if (record.tsc >= since_tsc) {
+            out.push_back(record);
+        }
+    }
+}
+
+void TraceRing::reassign(pid_t tid, std::string name) {
+    head_.store(0, std::memory_order_relaxed);
+    tid_ = tid;
+    name_ = std::move(name);
+}
+
+EventTracer& EventTracer::instance() {
+    static EventTracer tracer;
+    return tracer;
+}
+
+void EventTracer::configure(const Config& config) {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    config_ = config;
+}
+
+EventTracer::Config EventTracer::get_config() const {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    return config_;
+}
+
+void EventTracer::register_instrument(const std::string& symbol) {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    instruments_[trace::instrument_id(symbol)] = symbol;
+}
+
+TraceRing* EventTracer::acquire_ring() {
+    size_t capacity = get_config().ring_capacity;
+    pid_t tid = ThreadRegistry::current_tid();
+    std::string name = current_thread_name();
+
+    TraceRing* ring = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        if (!free_rings_.empty()) {
+            ring = free_rings_.back();
+            free_rings_.pop_back();
+            ring->reassign(tid, std::move(name));
+        } else {
+            rings_.push_back(std::make_unique<TraceRing>(capacity, tid, std::move(name)));
+            ring = rings_.back().get();
+        }
+    }
+
+    thread_local TraceRingOwner owner;
+    owner.ring = ring;
+    owner.on_exit = [this](TraceRing* exiting) {
+        release_ring(exiting);
+        tls_ring_ = nullptr;
+    };
+
+    tls_ring_ = ring;
+    return ring;
+}
+
+void EventTracer::release_ring(TraceRing* ring) {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    free_rings_.push_back(ring);
+}
+
+std::string EventTracer::dump(const std::string& reason, bool force) {
+    std::lock_guard<std::mutex> dump_lock(dump_mutex_);
+
+    auto config = get_config();
+    auto now = std::chrono::steady_clock::now();
+    if (!force && last_dump_ != std::chrono::steady_clock::time_point{} &&
+        now - last_dump_ < config.min_dump_interval) {
+        return {};
+    }
+
+    trace::TraceFileHeader header{};
+    std::memcpy(header.magic, trace::TRACE_MAGIC, sizeof(header.magic));
+    header.version = trace::TRACE_VERSION;
+    header.ticks_per_nanosecond = TscClock::is_tsc() ? TscClock::ticks_per_nanosecond() : 1.0;
+    header.anchor_tsc = TscClock::now();
+    header.anchor_wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    uint64_t window_ticks = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(config.dump_window).count() *
+        header.ticks_per_nanosecond);
+    uint64_t since = header.anchor_tsc > window_ticks ? header.anchor_tsc - window_ticks : 0;
+
+    struct ThreadDump {
+        trace::TraceThreadHeader header;
+        std::vector<trace::TraceRecord> records;
+    };
+
+    std::vector<ThreadDump> threads;
+    std::vector<trace::TraceInstrument> instruments;
+    size_t total_records = 0;
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+
+        // Rings of exited threads still hold their last records until reused
+        for (const auto& ring : rings_) {
+            ThreadDump thread{};
+            thread.header.tid = ring->tid();
+            copy_name(thread.header.name, ring->name());
+            ring->snapshot(since, thread.records);
+            if (thread.records.empty()) continue;
+
+            thread.header.record_count = static_cast<uint32_t>(thread.records.size());
+            total_records += thread.records.size();
+            threads.push_back(std::move(thread));
+        }
+
+        for (const auto& [id, symbol] : instruments_) {
+            trace::TraceInstrument instrument{};
+            instrument.id = id;
+            copy_name(instrument.name, symbol);
+            instruments.push_back(instrument);
+        }
+    }
+
+    // Nothing traced (tracing compiled out, or idle): no file, and the rate
+    // limit stays open for the next trigger
+    if (total_records == 0 && !force) {
+        return {};
+    }
+    last_dump_ = now;
+
+    header.thread_count = static_cast<uint32_t>(threads.size());
+    header.instrument_count = static_cast<uint32_t>(instruments.size());
+
+    std::string safe_reason = reason;
+    std::replace_if(safe_reason.begin(), safe_reason.end(),
+                    [](unsigned char c) { return !std::isalnum(c) && c != '-' && c != '_'; }, '_');
+
+    std::error_code error;
+    std::filesystem::create_directories(config.dump_directory, error);
+
+    std::string path = config.dump_directory + "/trace-" +
+                       std::to_string(header.anchor_wall_ns / 1000000) + "-" + safe_reason + ".bin";
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        LOG_ERROR("Failed to open trace dump {}", path);
+        return {};
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(instruments.data()),
+               static_cast<std::streamsize>(instruments.size() * sizeof(trace::TraceInstrument)));
+    for (const auto& thread : threads) {
+        file.write(reinterpret_cast<const char*>(&thread.header), sizeof(thread.header));
+        file.write(reinterpret_cast<const char*>(thread.records.data()),
+                   static_cast<std::streamsize>(thread.records.size() * sizeof(trace::TraceRecord)));
+    }
+
+    if (!file) {
+        LOG_ERROR("Failed to write trace dump {}", path);
+        return {};
+    }
+
+    dumps_written_++;
+    LOG_INFO("Trace dump ({}): {} records from {} threads -> {}",
+             reason, total_records, threads.size(), path);
+    return path;
+}
+
+} // namespace arbitrage
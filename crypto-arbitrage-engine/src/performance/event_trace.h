@@ -0,0 +1,174 @@
+#pragma once
+
+#include "event_trace_format.h"
+#include "utils/alloc_tracker.h"
+#include "utils/tsc_clock.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+#include <unordered_map>
+#include <vector>
+
+namespace arbitrage {
+
+// Fixed-size ring of trace records owned by one thread.
+//
+// The owner writes a slot and then publishes the new head with a release
+// store; it never waits. A dump copies the ring while the owner keeps
+// writing and afterwards discards any slot the owner may have lapped.
+class TraceRing {
+public:
+    TraceRing(size_t capacity, pid_t tid, std::string name);
+
+    TraceRing(const TraceRing&) = delete;
+    TraceRing& operator=(const TraceRing&) = delete;
+
+    void push(trace::Event event, trace::Phase phase, uint32_t instrument, uint64_t arg) {
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        trace::TraceRecord& record = records_[head & mask_];
+        record.tsc = TscClock::now();
+        record.arg = arg;
+        record.instrument = instrument;
+        record.event = static_cast<uint16_t>(event);
+        record.phase = static_cast<uint8_t>(phase);
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    // Append records with tsc >= since_tsc, oldest first
+    void snapshot(uint64_t since_tsc, std::vector<trace::TraceRecord>& out) const;
+
+    // Hand the ring to a new thread; old records are dropped
+    void reassign(pid_t tid, std::string name);
+
+    pid_t tid() const { return tid_; }
+    const std::string& name() const { return name_; }
+
+private:
+    std::unique_ptr<trace::TraceRecord[]> records_;
+    size_t capacity_;
+    uint64_t mask_;
+    std::atomic<uint64_t> head_{0};     // Records ever written
+    pid_t tid_;
+    std::string name_;
+};
+
+// Per-thread binary event trace with on-demand dumps.
+//
+// Hot stages call the ARB_TRACE_* macros, which cost an rdtscp and a 24-byte
+// store into the calling thread's ring. Nothing is formatted or written
+// until dump() copies the last few seconds of every ring into a binary file;
+// tools/trace_to_chrome turns that into Chrome trace / Perfetto JSON.
+class EventTracer {
+public:
+    struct Config {
+        size_t ring_capacity = 65536;                   // Records per thread, rounded to a power of two
+        std::chrono::milliseconds dump_window{5000};    // How far back a dump reaches
+        std::chrono::seconds min_dump_interval{30};     // Rate limit for triggered dumps
+        std::string dump_directory = "traces";
+    };
+
+    static EventTracer& instance();
+
+    // Takes effect for rings created afterwards
+    void configure(const Config& config);
+    Config get_config() const;
+
+    // Hot path
+    static void record(trace::Event event, trace::Phase phase, uint32_t instrument, uint64_t arg) {
+        TraceRing* ring = tls_ring_;
+        if (!ring) {
+            ring = instance().acquire_ring();
+        }
+        ring->push(event, phase, instrument, arg);
+    }
+
+    // Name an instrument id in future dumps (cold path, e.g. on subscribe)
+    void register_instrument(const std::string& symbol);
+
+    // Write the last dump_window of every ring to <dump_directory>/trace-<ms>-<reason>.bin.
+    // Returns the file path, or an empty string when rate limited, when there is
+    // nothing to write (unless forced) or on failure.
+    std::string dump(const std::string& reason, bool force = false);
+
+    uint64_t dumps_written() const { return dumps_written_.load(); }
+
+private:
+    EventTracer() = default;
+
+    TraceRing* acquire_ring();
+    void release_ring(TraceRing* ring);
+
+    Config config_;
+    mutable std::mutex config_mutex_;
+
+    // Rings are never freed; a ring of an exited thread is reused by the next one
+    std::vector<std::unique_ptr<TraceRing>> rings_;
+    std::vector<TraceRing*> free_rings_;
+    std::unordered_map<uint32_t, std::string> instruments_;
+    std::mutex rings_mutex_;
+
+    std::mutex dump_mutex_;
+    std::chrono::steady_clock::time_point last_dump_{};
+    std::atomic<uint64_t> dumps_written_{0};
+
+    static thread_local TraceRing* tls_ring_;
+};
+
+// Begin/end pair around the enclosing scope; also the allocation stage
+// marker when built with TRACK_ALLOCATIONS
+class TraceScope {
+public:
+    TraceScope(trace::Event event, uint32_t instrument, uint64_t arg)
+        : event_(event)
+        , instrument_(instrument)
+#ifdef ARB_TRACK_ALLOCATIONS
+        , alloc_stage_(event)
+#endif
+    {
+        EventTracer::record(event, trace::Phase::BEGIN, instrument, arg);
+    }
+
+    ~TraceScope() {
+        EventTracer::record(event_, trace::Phase::END, instrument_, 0);
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    trace::Event event_;
+    uint32_t instrument_;
+#ifdef ARB_TRACK_ALLOCATIONS
+    AllocStageScope alloc_stage_;
+#endif
+};
+
+} // namespace arbitrage
+
+// ARB_TRACE_SCOPE(PARSE, instrument, arg) traces the rest of the enclosing
+// block; ARB_TRACE_INSTANT marks a point. Arguments are not evaluated and
+// everything compiles away unless built with ENABLE_TRACING. With only
+// TRACK_ALLOCATIONS, scopes still tag allocations with their stage.
+#ifdef ARB_ENABLE_TRACING
+#define ARB_TRACE_SCOPE(event, instrument, arg) \
+    ::arbitrage::TraceScope ARB_TRACE_CONCAT(arb_trace_scope_, __LINE__)( \
+        ::arbitrage::trace::Event::event, (instrument), static_cast<uint64_t>(arg))
+#define ARB_TRACE_INSTANT(event, instrument, arg) \
+    ::arbitrage::EventTracer::record(::arbitrage::trace::Event::event, \
+        ::arbitrage::trace::Phase::INSTANT, (instrument), static_cast<uint64_t>(arg))
+#elif defined(ARB_TRACK_ALLOCATIONS)
+#define ARB_TRACE_SCOPE(event, instrument, arg) \
+    ::arbitrage::AllocStageScope ARB_TRACE_CONCAT(arb_trace_scope_, __LINE__)( \
+        ::arbitrage::trace::Event::event)
+#define ARB_TRACE_INSTANT(event, instrument, arg) static_cast<void>(0)
+#else
+#define ARB_TRACE_SCOPE(event, instrument, arg) static_cast<void>(0)
+#define ARB_TRACE_INSTANT(event, instrument, arg) static_cast<void>(0)
+#endif
+
+#define ARB_TRACE_CONCAT_IMPL(a, b) a##b
+#define ARB_TRACE_CONCAT(a, b) ARB_TRACE_CONCAT_IMPL(a, b)
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace arbitrage {
+namespace trace {
+
+// Traced pipeline stages. Add new entries before COUNT and name them below;
+// the converter reads the names from this table, so ids in old dumps keep
+// their meaning only while entries are appended.
+enum class Event : uint16_t {
+    FRAME_RECEIVE,      // Websocket frame handed to the exchange adapter
+    PARSE,              // Venue JSON -> MarketData / book levels
+    BOOK_APPLY,         // Tick or depth stored by MarketDataManager
+    PRICE,              // Synthetic / funding pricer pass
+    DETECT,             // One detection strategy pass
+    RISK,               // Pre-trade risk check
+    DISPATCH,           // Callback fan-out (adapter -> manager, detector -> consumers)
+    COUNT
+};
+
+enum class Phase : uint8_t {
+    BEGIN,
+    END,
+    INSTANT
+};
+
+inline constexpr std::array<std::string_view, static_cast<size_t>(Event::COUNT)> EVENT_NAMES = {
+    "frame_receive",
+    "parse",
+    "book_apply",
+    "price",
+    "detect",
+    "risk",
+    "dispatch",
+};
+
+// FNV-1a of the symbol; names are written into every dump for the converter
+constexpr uint32_t instrument_id(std::string_view symbol) {
+    uint32_t hash = 2166136261u;
+    for (char c : symbol) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// One traced event - 24 bytes, written by the owning thread only
+struct TraceRecord {
+    uint64_t tsc;
+    uint64_t arg;
+    uint32_t instrument;
+    uint16_t event;
+    uint8_t phase;
+    uint8_t reserved;
+};
+
+static_assert(sizeof(TraceRecord) == 24);
+
+// Dump file layout (native endianness):
+//   TraceFileHeader
+//   TraceInstrument   x instrument_count
+//   { TraceThreadHeader, TraceRecord x record_count }   x thread_count
+inline constexpr char TRACE_MAGIC[8] = {'A', 'R', 'B', 'T', 'R', 'A', 'C', 'E'};
+inline constexpr uint32_t TRACE_VERSION = 1;
+
+struct TraceFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t thread_count;
+    uint32_t instrument_count;
+    uint32_t reserved;
+    double ticks_per_nanosecond;    // Converts record tsc deltas to time
+    uint64_t anchor_tsc;            // Taken together with anchor_wall_ns at dump time
+    int64_t anchor_wall_ns;         // system_clock, nanoseconds since epoch
+};
+
+struct TraceInstrument {
+    uint32_t id;
+    char name[28];                  // NUL-terminated, truncated
+};
+
+struct TraceThreadHeader {
+    int32_t tid;
+    char name[16];                  // Kernel thread name
+    uint32_t record_count;          // Records follow, oldest first
+};
+
+} // namespace trace
+} // namespace arbitrage
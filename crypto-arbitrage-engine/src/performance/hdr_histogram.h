@@ -0,0 +1,192 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace arbitrage {
+
+// Log-linear (HDR-style) histogram.
+//
+// Values below 2^SUB_BUCKET_BITS are counted exactly; above that every power
+// of two is split into SUB_BUCKET_COUNT linear sub-buckets, so the relative
+// error is bounded by 1/SUB_BUCKET_COUNT (~0.8%) from single nanoseconds up to
+// MAX_TRACKABLE_VALUE (2^41 - 1, ~36.6 minutes when recording nanoseconds);
+// larger values are recorded as MAX_TRACKABLE_VALUE. Recording is a
+// count-leading-zeros and an increment; histograms merge by adding buckets.
+class HdrHistogram {
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 7;
+    static constexpr uint64_t SUB_BUCKET_COUNT = uint64_t(1) << SUB_BUCKET_BITS;
+    static constexpr unsigned MAX_MAGNITUDE = 40;
+    static constexpr size_t BUCKET_COUNT = (MAX_MAGNITUDE - SUB_BUCKET_BITS + 2) * SUB_BUCKET_COUNT;
+    static constexpr uint64_t MAX_TRACKABLE_VALUE = (uint64_t(1) << (MAX_MAGNITUDE + 1)) - 1;
+
+    HdrHistogram() { reset(); }
+
+    // Bucket layout helpers (shared with lock-free shards)
+    static size_t bucket_index(uint64_t value) {
+        if (value < SUB_BUCKET_COUNT) {
+            return static_cast<size_t>(value);
+        }
+        value = std::min(value, MAX_TRACKABLE_VALUE);
+
+        unsigned msb = 63 - static_cast<unsigned>(__builtin_clzll(value));
+        unsigned shift = msb - SUB_BUCKET_BITS;
+        return (static_cast<size_t>(shift) + 1) * SUB_BUCKET_COUNT +
+               static_cast<size_t>((value >> shift) - SUB_BUCKET_COUNT);
+    }
+
+    static uint64_t bucket_lowest_value(size_t index) {
+        if (index < SUB_BUCKET_COUNT) {
+            return index;
+        }
+        unsigned shift = static_cast<unsigned>(index / SUB_BUCKET_COUNT) - 1;
+        uint64_t sub_bucket = index % SUB_BUCKET_COUNT;
+        return (SUB_BUCKET_COUNT + sub_bucket) << shift;
+    }
+
+    static uint64_t bucket_highest_value(size_t index) {
+        if (index < SUB_BUCKET_COUNT) {
+            return index;
+        }
+        unsigned shift = static_cast<unsigned>(index / SUB_BUCKET_COUNT) - 1;
+        return bucket_lowest_value(index) + (uint64_t(1) << shift) - 1;
+    }
+
+    // Recording
+    void record(uint64_t value) {
+        record_n(value, 1);
+    }
+
+    void record_n(uint64_t value, uint64_t count) {
+        // Clamped like the bucket, so max() never exceeds percentile(1.0)
+        value = std::min(value, MAX_TRACKABLE_VALUE);
+        size_t index = bucket_index(value);
+        counts_[index] += count;
+        total_count_ += count;
+        sum_ += value * count;
+        min_index_ = std::min(min_index_, index);
+        max_index_ = std::max(max_index_, index);
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+
+    // Add raw bucket counts (used when folding shards into a snapshot)
+    void add_bucket(size_t index, uint64_t count) {
+        if (count == 0) return;
+        counts_[index] += count;
+        total_count_ += count;
+        min_index_ = std::min(min_index_, index);
+        max_index_ = std::max(max_index_, index);
+        min_ = std::min(min_, bucket_lowest_value(index));
+        max_ = std::max(max_, bucket_highest_value(index));
+    }
+
+    void add_sum(uint64_t sum) { sum_ += sum; }
+
+    void merge(const HdrHistogram& other) {
+        if (other.total_count_ == 0) return;
+
+        for (size_t i = other.min_index_; i <= other.max_index_; ++i) {
+            counts_[i] += other.counts_[i];
+        }
+        total_count_ += other.total_count_;
+        sum_ += other.sum_;
+        min_index_ = std::min(min_index_, other.min_index_);
+        max_index_ = std::max(max_index_, other.max_index_);
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+    // Remove an earlier snapshot of the same monotonically growing series,
+    // leaving only what was recorded since. Extremes drop to bucket resolution.
+    void subtract(const HdrHistogram& older) {
+        if (older.total_count_ == 0) return;
+
+        for (size_t i = older.min_index_; i <= older.max_index_; ++i) {
+            counts_[i] -= std::min(counts_[i], older.counts_[i]);
+        }
+        total_count_ -= std::min(total_count_, older.total_count_);
+        sum_ -= std::min(sum_, older.sum_);
+
+        size_t first = min_index_;
+        size_t last = max_index_;
+        min_index_ = BUCKET_COUNT - 1;
+        max_index_ = 0;
+        min_ = std::numeric_limits<uint64_t>::max();
+        max_ = 0;
+
+        for (size_t i = first; i <= last && i < BUCKET_COUNT; ++i) {
+            if (counts_[i] == 0) continue;
+            min_index_ = std::min(min_index_, i);
+            max_index_ = i;
+        }
+        if (total_count_ > 0) {
+            min_ = bucket_lowest_value(min_index_);
+            max_ = bucket_highest_value(max_index_);
+        }
+    }
+
+    void reset() {
+        counts_.fill(0);
+        total_count_ = 0;
+        sum_ = 0;
+        min_index_ = BUCKET_COUNT - 1;
+        max_index_ = 0;
+        min_ = std::numeric_limits<uint64_t>::max();
+        max_ = 0;
+    }
+
+    // Queries - p in [0, 1]
+    uint64_t percentile(double p) const {
+        if (total_count_ == 0) return 0;
+
+        p = std::clamp(p, 0.0, 1.0);
+        uint64_t target = std::max<uint64_t>(
+            1, static_cast<uint64_t>(std::ceil(p * static_cast<double>(total_count_))));
+
+        uint64_t cumulative = 0;
+        for (size_t i = min_index_; i <= max_index_; ++i) {
+            cumulative += counts_[i];
+            if (cumulative >= target) {
+                return std::min(bucket_highest_value(i), max_);
+            }
+        }
+        return max_;
+    }
+
+    // Number of recorded values <= value (bucket resolution)
+    uint64_t count_at_or_below(uint64_t value) const {
+        if (total_count_ == 0) return 0;
+
+        size_t limit = std::min(bucket_index(value), max_index_);
+        uint64_t cumulative = 0;
+        for (size_t i = min_index_; i <= limit; ++i) {
+            cumulative += counts_[i];
+        }
+        return cumulative;
+    }
+
+    uint64_t count() const { return total_count_; }
+    uint64_t sum() const { return sum_; }
+    uint64_t min() const { return total_count_ ? min_ : 0; }
+    uint64_t max() const { return max_; }
+
+    double mean() const {
+        return total_count_ ? static_cast<double>(sum_) / total_count_ : 0.0;
+    }
+
+private:
+    std::array<uint64_t, BUCKET_COUNT> counts_;
+    uint64_t total_count_;
+    uint64_t sum_;
+    size_t min_index_;
+    size_t max_index_;
+    uint64_t min_;
+    uint64_t max_;
+};
+
+} // namespace arbitrage
@@ -0,0 +1,224 @@
+#include "hw_counters.h"
+#include "utils/logger.h"
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <memory>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define ARB_HAS_RDPMC 1
+#endif
+
+namespace arbitrage {
+
+std::atomic<bool> HwCounters::enabled_{false};
+std::array<MetricId, HW_STAGE_COUNT> HwCounters::sample_ids_{};
+std::array<std::array<MetricId, HW_EVENT_COUNT>, HW_STAGE_COUNT> HwCounters::event_ids_{};
+
+namespace {
+
+struct EventSpec {
+    uint32_t type;
+    uint64_t config;
+};
+
+constexpr uint64_t cache_event(uint64_t cache, uint64_t op, uint64_t result) {
+    return cache | (op << 8) | (result << 16);
+}
+
+// Indexed by HwEvent
+constexpr std::array<EventSpec, HW_EVENT_COUNT> EVENT_SPECS = {{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ,
+                                     PERF_COUNT_HW_CACHE_RESULT_MISS)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+}};
+
+// One thread's counter group. Counters are read with rdpmc from the mapped
+// perf page; when the kernel has not scheduled an event onto a PMC (index 0,
+// e.g. while multiplexed) the whole group is read with one read() instead.
+class HwCounterGroup {
+public:
+    ~HwCounterGroup() {
+        for (size_t i = 0; i < HW_EVENT_COUNT; ++i) {
+            if (pages_[i]) munmap(pages_[i], page_size_);
+            if (fds_[i] >= 0) close(fds_[i]);
+        }
+    }
+
+    bool open(int& error) {
+        page_size_ = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        fds_.fill(-1);
+        pages_.fill(nullptr);
+
+        for (size_t i = 0; i < HW_EVENT_COUNT; ++i) {
+            perf_event_attr attr{};
+            attr.size = sizeof(attr);
+            attr.type = EVENT_SPECS[i].type;
+            attr.config = EVENT_SPECS[i].config;
+            attr.disabled = i == 0 ? 1 : 0;     // Leader starts the group
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP;
+
+            int group_fd = i == 0 ? -1 : fds_[0];
+            fds_[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+            if (fds_[i] < 0) {
+                error = errno;
+                return false;
+            }
+
+            void* page = mmap(nullptr, page_size_, PROT_READ, MAP_SHARED, fds_[i], 0);
+            if (page != MAP_FAILED) {
+                pages_[i] = static_cast<perf_event_mmap_page*>(page);
+            }
+        }
+
+        if (ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) != 0) {
+            error = errno;
+            return false;
+        }
+        return true;
+    }
+
+    bool read(HwReading& reading) const {
+        for (size_t i = 0; i < HW_EVENT_COUNT; ++i) {
+            if (!read_rdpmc(i, reading.values[i])) {
+                return read_group(reading);
+            }
+        }
+        return true;
+    }
+
+private:
+    std::array<int, HW_EVENT_COUNT> fds_{};
+    std::array<perf_event_mmap_page*, HW_EVENT_COUNT> pages_{};
+    size_t page_size_ = 0;
+
+    bool read_rdpmc(size_t event, uint64_t& value) const {
+#ifdef ARB_HAS_RDPMC
+        const perf_event_mmap_page* page = pages_[event];
+        if (!page) return false;
+
+        // Seqlock against the kernel updating offset/index on reschedule
+        uint32_t sequence;
+        do {
+            sequence = page->lock;
+            std::atomic_signal_fence(std::memory_order_acquire);
+
+            uint32_t index = page->index;
+            if (!page->cap_user_rdpmc || index == 0) return false;
+
+            unsigned width = page->pmc_width;
+            int64_t counter = static_cast<int64_t>(__rdpmc(static_cast<int>(index - 1)));
+            counter <<= 64 - width;
+            counter >>= 64 - width;     // Sign-extend the PMC width
+            value = static_cast<uint64_t>(page->offset + counter);
+
+            std::atomic_signal_fence(std::memory_order_acquire);
+        } while (page->lock != sequence);
+
+        return true;
+#else
+        (void)event;
+        (void)value;
+        return false;
+#endif
+    }
+
+    bool read_group(HwReading& reading) const {
+        struct {
+            uint64_t count;
+            uint64_t values[HW_EVENT_COUNT];
+        } group{};
+
+        if (::read(fds_[0], &group, sizeof(group)) < static_cast<ssize_t>(sizeof(uint64_t)) ||
+            group.count != HW_EVENT_COUNT) {
+            return false;
+        }
+
+        for (size_t i = 0; i < HW_EVENT_COUNT; ++i) {
+            reading.values[i] = group.values[i];
+        }
+        return true;
+    }
+};
+
+struct ThreadGroup {
+    std::unique_ptr<HwCounterGroup> group;
+    bool failed = false;
+};
+
+thread_local ThreadGroup thread_group;
+
+HwCounterGroup* current_group() {
+    if (thread_group.group) return thread_group.group.get();
+    if (thread_group.failed) return nullptr;
+
+    auto group = std::make_unique<HwCounterGroup>();
+    int error = 0;
+    if (!group->open(error)) {
+        thread_group.failed = true;
+        return nullptr;
+    }
+
+    thread_group.group = std::move(group);
+    return thread_group.group.get();
+}
+
+} // namespace
+
+bool HwCounters::enable() {
+    if (enabled()) return true;
+
+    // Probe on the calling thread so an unusable PMU is reported once, at startup
+    HwCounterGroup probe;
+    int error = 0;
+    if (!probe.open(error)) {
+        LOG_WARN("Hardware counters unavailable: perf_event_open failed ({}); "
+                 "check kernel.perf_event_paranoid", std::strerror(error));
+        return false;
+    }
+
+    auto& registry = MetricRegistry::instance();
+    for (size_t stage = 0; stage < HW_STAGE_COUNT; ++stage) {
+        sample_ids_[stage] = registry.register_counter(labelled_metric(
+            "arbitrage_stage_hw_samples_total", {{"stage", HW_STAGE_NAMES[stage]}}));
+
+        for (size_t event = 0; event < HW_EVENT_COUNT; ++event) {
+            event_ids_[stage][event] = registry.register_counter(labelled_metric(
+                "arbitrage_stage_hw_events_total",
+                {{"stage", HW_STAGE_NAMES[stage]}, {"event", HW_EVENT_NAMES[event]}}));
+        }
+    }
+
+    enabled_.store(true, std::memory_order_release);
+    LOG_INFO("Hardware counters enabled for {} pipeline stages", HW_STAGE_COUNT);
+    return true;
+}
+
+bool HwCounters::read(HwReading& reading) {
+    HwCounterGroup* group = current_group();
+    return group && group->read(reading);
+}
+
+void HwCounters::add_sample(HwStage stage, const HwReading& begin, const HwReading& end) {
+    size_t index = static_cast<size_t>(stage);
+    MetricRegistry::increment(sample_ids_[index]);
+
+    for (size_t event = 0; event < HW_EVENT_COUNT; ++event) {
+        // A group re-read after multiplexing can step back marginally
+        if (end.values[event] > begin.values[event]) {
+            MetricRegistry::increment(event_ids_[index][event], end.values[event] - begin.values[event]);
+        }
+    }
+}
+
+} // namespace arbitrage
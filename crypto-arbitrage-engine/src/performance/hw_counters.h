@@ -0,0 +1,126 @@
+#pragma once
+
+#include "metric_shards.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+
+namespace arbitrage {
+
+// Hardware events counted in every stage sample
+enum class HwEvent {
+    CYCLES,
+    INSTRUCTIONS,
+    L1D_READ_MISSES,
+    LLC_MISSES,
+    BRANCH_MISSES,
+    COUNT
+};
+
+// Pipeline stages with counter scopes
+enum class HwStage {
+    PARSE,
+    TICK_UPDATE,
+    BOOK_UPDATE,
+    DETECTION,
+    RISK_CHECK,
+    COUNT
+};
+
+inline constexpr size_t HW_EVENT_COUNT = static_cast<size_t>(HwEvent::COUNT);
+inline constexpr size_t HW_STAGE_COUNT = static_cast<size_t>(HwStage::COUNT);
+
+inline constexpr std::array<std::string_view, HW_EVENT_COUNT> HW_EVENT_NAMES = {
+    "cycles",
+    "instructions",
+    "l1d_read_misses",
+    "llc_misses",
+    "branch_misses",
+};
+
+inline constexpr std::array<std::string_view, HW_STAGE_COUNT> HW_STAGE_NAMES = {
+    "parse",
+    "tick_update",
+    "book_update",
+    "detection",
+    "risk_check",
+};
+
+struct HwReading {
+    std::array<uint64_t, HW_EVENT_COUNT> values{};
+};
+
+// perf_event_open counter groups read with rdpmc.
+//
+// Each thread that enters a counter scope opens its own group (user-space
+// only, following the thread across CPUs) and maps the counter pages so
+// reads are rdpmc instructions rather than syscalls. Stage deltas land in
+// sharded registry counters, labelled
+// arbitrage_stage_hw_events_total{stage, event} plus a per-stage sample
+// count, so they merge and export like every other counter.
+class HwCounters {
+public:
+    // Opt in at startup. Returns false (and stays off) when perf events are
+    // unavailable: perf_event_paranoid, seccomp, or no PMU in a VM.
+    static bool enable();
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    // Current values for the calling thread; opens its group on first use
+    static bool read(HwReading& reading);
+
+    static void add_sample(HwStage stage, const HwReading& begin, const HwReading& end);
+
+    static MetricId sample_metric(HwStage stage) {
+        return sample_ids_[static_cast<size_t>(stage)];
+    }
+    static MetricId event_metric(HwStage stage, HwEvent event) {
+        return event_ids_[static_cast<size_t>(stage)][static_cast<size_t>(event)];
+    }
+
+private:
+    static std::atomic<bool> enabled_;
+    static std::array<MetricId, HW_STAGE_COUNT> sample_ids_;
+    static std::array<std::array<MetricId, HW_EVENT_COUNT>, HW_STAGE_COUNT> event_ids_;
+};
+
+// Counts the enclosing scope's hardware events into a stage; a no-op until
+// HwCounters::enable() succeeds
+template <HwStage STAGE>
+class HwCounterScope {
+public:
+    HwCounterScope() {
+        if (HwCounters::enabled()) {
+            active_ = HwCounters::read(begin_);
+        }
+    }
+
+    ~HwCounterScope() {
+        HwReading end;
+        if (active_ && HwCounters::read(end)) {
+            HwCounters::add_sample(STAGE, begin_, end);
+        }
+    }
+
+    HwCounterScope(const HwCounterScope&) = delete;
+    HwCounterScope& operator=(const HwCounterScope&) = delete;
+
+private:
+    HwReading begin_;
+    bool active_ = false;
+};
+
+} // namespace arbitrage
+
+#define ARB_HW_CONCAT_IMPL(a, b) a##b
+#define ARB_HW_CONCAT(a, b) ARB_HW_CONCAT_IMPL(a, b)
+
+// ARB_HW_SCOPE(PARSE) counts the rest of the enclosing block. Compiled out
+// unless built with ENABLE_HW_COUNTERS; even then it costs one relaxed load
+// until counters are enabled at runtime.
+#ifdef ARB_ENABLE_HW_COUNTERS
+#define ARB_HW_SCOPE(stage) \
+    ::arbitrage::HwCounterScope<::arbitrage::HwStage::stage> ARB_HW_CONCAT(arb_hw_scope_, __LINE__)
+#else
+#define ARB_HW_SCOPE(stage) static_cast<void>(0)
+#endif
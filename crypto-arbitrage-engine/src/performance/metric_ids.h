@@ -0,0 +1,66 @@
+#pragma once
+
+#include "metric_shards.h"
+#include <array>
+#include <string_view>
+
+namespace arbitrage {
+namespace metrics {
+
+// Built-in metrics. Ids are the enum values; MetricRegistry registers the
+// names below in declaration order before anything else, so the runtime id
+// of every built-in equals its compile-time id. Add new entries before COUNT
+// and give them a name in the matching table.
+
+enum class Counter : MetricId {
+    MESSAGES_PROCESSED,
+    OPPORTUNITIES_DETECTED,
+    OPPORTUNITIES_EXECUTED,
+    RISK_REJECTIONS,
+    COUNT
+};
+
+// Latency histograms, recorded in nanoseconds
+enum class Timer : MetricId {
+    DETECTION_CYCLE,
+    EXECUTION,
+    MARKET_DATA_UPDATE,
+    ORDERBOOK_UPDATE,
+    DETECT_SPOT,
+    DETECT_SYNTHETIC,
+    DETECT_FUNDING,
+    RISK_CHECK,
+    TICK_TO_SIGNAL,     // Newest input tick received -> opportunity emitted
+    COUNT
+};
+
+inline constexpr std::array<std::string_view, static_cast<size_t>(Counter::COUNT)> COUNTER_NAMES = {
+    "messages_processed",
+    "opportunities_detected",
+    "opportunities_executed",
+    "risk_rejections",
+};
+
+inline constexpr std::array<std::string_view, static_cast<size_t>(Timer::COUNT)> TIMER_NAMES = {
+    "detection_latency",
+    "execution_latency",
+    "market_data_update",
+    "orderbook_update",
+    "detect_spot",
+    "detect_synthetic",
+    "detect_funding",
+    "risk_check",
+    "tick_to_signal",
+};
+
+static_assert(COUNTER_NAMES.size() <= MetricShard::MAX_COUNTERS);
+static_assert(TIMER_NAMES.size() <= MetricShard::MAX_HISTOGRAMS);
+
+constexpr MetricId id(Counter counter) { return static_cast<MetricId>(counter); }
+constexpr MetricId id(Timer timer) { return static_cast<MetricId>(timer); }
+
+constexpr std::string_view name(Counter counter) { return COUNTER_NAMES[id(counter)]; }
+constexpr std::string_view name(Timer timer) { return TIMER_NAMES[id(timer)]; }
+
+} // namespace metrics
+} // namespace arbitrage
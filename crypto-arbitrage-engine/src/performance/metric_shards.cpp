@@ -0,0 +1,252 @@
+#include "metric_shards.h"
+#include "metric_ids.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <functional>
+
+namespace arbitrage {
+
+std::string labelled_metric(std::string_view family,
+                            std::initializer_list<std::pair<std::string_view, std::string_view>> labels) {
+    std::string name(family);
+    name += '{';
+
+    bool first = true;
+    for (const auto& [key, value] : labels) {
+        if (!first) name += ',';
+        name.append(key).append("=\"").append(value).append("\"");
+        first = false;
+    }
+
+    name += '}';
+    return name;
+}
+
+// MetricShard implementation
+
+ShardHistogram* MetricShard::allocate_histogram(MetricId id) {
+    auto histogram = std::make_unique<ShardHistogram>();
+    ShardHistogram* raw = histogram.get();
+    owned_histograms_.push_back(std::move(histogram));
+
+    // Release so a concurrent scrape sees zeroed buckets behind the pointer
+    histograms_[id].store(raw, std::memory_order_release);
+    return raw;
+}
+
+void MetricShard::fold_histogram(MetricId id, HdrHistogram& out) const {
+    const ShardHistogram* histogram = histograms_[id].load(std::memory_order_acquire);
+    if (!histogram) return;
+
+    size_t min_index = histogram->min_index.load(std::memory_order_relaxed);
+    size_t max_index = histogram->max_index.load(std::memory_order_relaxed);
+
+    for (size_t i = min_index; i <= max_index; ++i) {
+        out.add_bucket(i, histogram->buckets[i].load(std::memory_order_relaxed));
+    }
+    out.add_sum(histogram->sum.load(std::memory_order_relaxed));
+}
+
+// MetricRegistry implementation
+
+thread_local MetricShard* MetricRegistry::tls_shard_ = nullptr;
+thread_local bool MetricRegistry::tls_exiting_ = false;
+
+namespace {
+
+// Owns the calling thread's shard and hands its totals back on thread exit
+struct ShardOwner {
+    std::unique_ptr<MetricShard> shard;
+    std::function<void(MetricShard*)> on_exit;
+
+    ~ShardOwner() {
+        if (shard && on_exit) {
+            on_exit(shard.get());
+        }
+    }
+};
+
+} // namespace
+
+MetricRegistry& MetricRegistry::instance() {
+    static MetricRegistry registry;
+    return registry;
+}
+
+MetricRegistry::MetricRegistry() {
+    // Built-ins first, so their runtime ids match the compile-time enum values
+    for (auto name : metrics::COUNTER_NAMES) {
+        register_counter(std::string(name));
+    }
+    for (auto name : metrics::TIMER_NAMES) {
+        register_histogram(std::string(name));
+    }
+}
+
+MetricShard* MetricRegistry::attach_current_thread() {
+    auto& registry = instance();
+
+    // Runs once per thread: after ~ShardOwner, local_shard() sees
+    // tls_exiting_ and never comes back here to reuse the destroyed owner
+    thread_local ShardOwner owner;
+    owner.shard = std::make_unique<MetricShard>();
+    owner.on_exit = [&registry](MetricShard* shard) {
+        registry.retire(shard);
+        tls_shard_ = nullptr;
+        tls_exiting_ = true;
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex_);
+        registry.shards_.push_back(owner.shard.get());
+    }
+
+    tls_shard_ = owner.shard.get();
+    return tls_shard_;
+}
+
+void MetricRegistry::retire(MetricShard* shard) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Registered slots plus the overflow slot of each kind
+    auto fold_counter = [&](MetricId i) { retired_counters_[i] += shard->counter(i); };
+    auto fold_gauge = [&](MetricId i) { retired_gauges_[i] += shard->gauge(i); };
+    auto fold_histogram = [&](MetricId i) {
+        if (!retired_histograms_[i]) {
+            retired_histograms_[i] = std::make_unique<HdrHistogram>();
+        }
+        shard->fold_histogram(i, *retired_histograms_[i]);
+    };
+
+    for (MetricId i = 0; i < counter_names_.size(); ++i) fold_counter(i);
+    for (MetricId i = 0; i < gauge_names_.size(); ++i) fold_gauge(i);
+    for (MetricId i = 0; i < histogram_names_.size(); ++i) fold_histogram(i);
+    fold_counter(MetricShard::COUNTER_OVERFLOW);
+    fold_gauge(MetricShard::GAUGE_OVERFLOW);
+    fold_histogram(MetricShard::HISTOGRAM_OVERFLOW);
+
+    shards_.erase(std::remove(shards_.begin(), shards_.end(), shard), shards_.end());
+}
+
+void MetricRegistry::retired_add(MetricId id, uint64_t n) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    retired_counters_[id] += n;
+}
+
+void MetricRegistry::retired_gauge_add(MetricId id, int64_t delta) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    retired_gauges_[id] += delta;
+}
+
+void MetricRegistry::retired_record(MetricId id, uint64_t value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!retired_histograms_[id]) {
+        retired_histograms_[id] = std::make_unique<HdrHistogram>();
+    }
+    retired_histograms_[id]->record(value);
+}
+
+MetricId MetricRegistry::register_name(std::vector<std::string>& names,
+                                       std::unordered_map<std::string, MetricId>& ids,
+                                       const std::string& name, MetricId overflow,
+                                       const char* kind) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = ids.find(name);
+    if (it != ids.end()) {
+        return it->second;
+    }
+
+    // Not remembered: every thread that resolves the name warns once
+    if (names.size() >= overflow) {
+        LOG_WARN("All {} {} metric slots in use; updates to {} are dropped", overflow, kind, name);
+        return overflow;
+    }
+
+    MetricId id = static_cast<MetricId>(names.size());
+    names.push_back(name);
+    ids.emplace(name, id);
+    return id;
+}
+
+MetricId MetricRegistry::register_counter(const std::string& name) {
+    return register_name(counter_names_, counter_ids_, name, MetricShard::COUNTER_OVERFLOW, "counter");
+}
+
+MetricId MetricRegistry::register_gauge(const std::string& name) {
+    return register_name(gauge_names_, gauge_ids_, name, MetricShard::GAUGE_OVERFLOW, "gauge");
+}
+
+MetricId MetricRegistry::register_histogram(const std::string& name) {
+    return register_name(histogram_names_, histogram_ids_, name,
+                         MetricShard::HISTOGRAM_OVERFLOW, "histogram");
+}
+
+bool MetricRegistry::find_histogram(const std::string& name, MetricId& id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = histogram_ids_.find(name);
+    if (it == histogram_ids_.end()) return false;
+
+    id = it->second;
+    return true;
+}
+
+std::vector<std::string> MetricRegistry::counter_names() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return counter_names_;
+}
+
+std::vector<std::string> MetricRegistry::gauge_names() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return gauge_names_;
+}
+
+std::vector<std::string> MetricRegistry::histogram_names() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return histogram_names_;
+}
+
+uint64_t MetricRegistry::read_counter(MetricId id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    uint64_t total = retired_counters_[id];
+    for (const auto* shard : shards_) {
+        total += shard->counter(id);
+    }
+    return total;
+}
+
+int64_t MetricRegistry::read_gauge(MetricId id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    int64_t total = retired_gauges_[id];
+    for (const auto* shard : shards_) {
+        total += shard->gauge(id);
+    }
+    return total;
+}
+
+void MetricRegistry::read_histogram(MetricId id, HdrHistogram& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (retired_histograms_[id]) {
+        out.merge(*retired_histograms_[id]);
+    }
+    for (const auto* shard : shards_) {
+        shard->fold_histogram(id, out);
+    }
+}
+
+uint64_t MetricRegistry::dropped_histogram_samples() const {
+    HdrHistogram dropped;
+    read_histogram(MetricShard::HISTOGRAM_OVERFLOW, dropped);
+    return dropped.count();
+}
+
+size_t MetricRegistry::shard_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return shards_.size();
+}
+
+} // namespace arbitrage
@@ -0,0 +1,196 @@
+#pragma once
+
+#include "hdr_histogram.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace arbitrage {
+
+using MetricId = uint32_t;
+
+// Series name carrying Prometheus labels: family{key="value",...}. Register
+// one series per label combination up front and keep the id on the owner.
+std::string labelled_metric(std::string_view family,
+                            std::initializer_list<std::pair<std::string_view, std::string_view>> labels);
+
+// Histogram storage inside a shard. Bucket layout is HdrHistogram's so a
+// scrape folds shards straight into an HdrHistogram.
+struct ShardHistogram {
+    std::array<std::atomic<uint64_t>, HdrHistogram::BUCKET_COUNT> buckets{};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<size_t> min_index{HdrHistogram::BUCKET_COUNT - 1};
+    std::atomic<size_t> max_index{0};
+};
+
+// Metric storage owned by a single thread.
+//
+// Only the owning thread writes, so updates are a relaxed load + store (no
+// lock prefix, no contention); the collector reads the same words with
+// relaxed loads while merging. Histograms are allocated on first use so a
+// thread only pays for the histograms it actually records.
+class MetricShard {
+public:
+    static constexpr size_t MAX_COUNTERS = 128;
+    static constexpr size_t MAX_GAUGES = 64;
+    static constexpr size_t MAX_HISTOGRAMS = 64;
+
+    // One spare slot per kind takes the updates for names registered after
+    // the slots ran out; it is counted as dropped, never exported
+    static constexpr MetricId COUNTER_OVERFLOW = MAX_COUNTERS;
+    static constexpr MetricId GAUGE_OVERFLOW = MAX_GAUGES;
+    static constexpr MetricId HISTOGRAM_OVERFLOW = MAX_HISTOGRAMS;
+
+    MetricShard() = default;
+    MetricShard(const MetricShard&) = delete;
+    MetricShard& operator=(const MetricShard&) = delete;
+
+    // Writer side (owning thread only)
+    void add(MetricId id, uint64_t n) {
+        bump(counters_[id], n);
+    }
+
+    void gauge_add(MetricId id, int64_t delta) {
+        bump(gauges_[id], delta);
+    }
+
+    void record(MetricId id, uint64_t value) {
+        ShardHistogram* histogram = histograms_[id].load(std::memory_order_relaxed);
+        if (!histogram) {
+            histogram = allocate_histogram(id);
+        }
+
+        size_t index = HdrHistogram::bucket_index(value);
+        bump(histogram->buckets[index], uint64_t(1));
+        bump(histogram->sum, value);
+
+        if (index < histogram->min_index.load(std::memory_order_relaxed)) {
+            histogram->min_index.store(index, std::memory_order_relaxed);
+        }
+        if (index > histogram->max_index.load(std::memory_order_relaxed)) {
+            histogram->max_index.store(index, std::memory_order_relaxed);
+        }
+    }
+
+    // Reader side (any thread)
+    uint64_t counter(MetricId id) const {
+        return counters_[id].load(std::memory_order_relaxed);
+    }
+
+    int64_t gauge(MetricId id) const {
+        return gauges_[id].load(std::memory_order_relaxed);
+    }
+
+    void fold_histogram(MetricId id, HdrHistogram& out) const;
+
+private:
+    template <typename T>
+    static void bump(std::atomic<T>& cell, T n) {
+        cell.store(cell.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    ShardHistogram* allocate_histogram(MetricId id);
+
+    std::array<std::atomic<uint64_t>, MAX_COUNTERS + 1> counters_{};
+    std::array<std::atomic<int64_t>, MAX_GAUGES + 1> gauges_{};
+    std::array<std::atomic<ShardHistogram*>, MAX_HISTOGRAMS + 1> histograms_{};
+    std::vector<std::unique_ptr<ShardHistogram>> owned_histograms_;
+};
+
+// Process-wide registry of metric names and per-thread shards.
+//
+// Metrics are registered once (cold path, mutex) and referenced by id from
+// then on. Recording touches only the calling thread's shard; reads merge
+// every live shard plus the totals left behind by threads that exited.
+class MetricRegistry {
+public:
+    static MetricRegistry& instance();
+
+    // Registration - idempotent, returns the existing id for a known name.
+    // Once a kind is full, new names get its overflow id (never throws, so
+    // lazy registration on a record path is safe)
+    MetricId register_counter(const std::string& name);
+    MetricId register_gauge(const std::string& name);
+    MetricId register_histogram(const std::string& name);
+
+    bool find_histogram(const std::string& name, MetricId& id) const;
+    std::vector<std::string> counter_names() const;
+    std::vector<std::string> gauge_names() const;
+    std::vector<std::string> histogram_names() const;
+
+    // Hot path - thread-local, contention free. Updates from a thread whose
+    // shard is already retired (thread_local destructors running late) go
+    // straight to the retired totals under the lock.
+    static void increment(MetricId id, uint64_t n = 1) {
+        if (MetricShard* shard = local_shard()) shard->add(id, n);
+        else instance().retired_add(id, n);
+    }
+
+    static void gauge_add(MetricId id, int64_t delta) {
+        if (MetricShard* shard = local_shard()) shard->gauge_add(id, delta);
+        else instance().retired_gauge_add(id, delta);
+    }
+
+    static void record(MetricId id, uint64_t value) {
+        if (MetricShard* shard = local_shard()) shard->record(id, value);
+        else instance().retired_record(id, value);
+    }
+
+    // Read side - merges all shards
+    uint64_t read_counter(MetricId id) const;
+    int64_t read_gauge(MetricId id) const;
+    void read_histogram(MetricId id, HdrHistogram& out) const;
+    size_t shard_count() const;
+
+    // Updates that landed in the overflow slots
+    uint64_t dropped_counter_increments() const { return read_counter(MetricShard::COUNTER_OVERFLOW); }
+    uint64_t dropped_histogram_samples() const;
+
+private:
+    MetricRegistry();
+
+    // Null once the calling thread's shard has been retired
+    static MetricShard* local_shard() {
+        MetricShard* shard = tls_shard_;
+        return shard || tls_exiting_ ? shard : attach_current_thread();
+    }
+
+    static MetricShard* attach_current_thread();
+    void retire(MetricShard* shard);
+
+    void retired_add(MetricId id, uint64_t n);
+    void retired_gauge_add(MetricId id, int64_t delta);
+    void retired_record(MetricId id, uint64_t value);
+
+    MetricId register_name(std::vector<std::string>& names,
+                           std::unordered_map<std::string, MetricId>& ids,
+                           const std::string& name, MetricId overflow, const char* kind);
+
+    static thread_local MetricShard* tls_shard_;
+    static thread_local bool tls_exiting_;      // Set once the shard is retired
+
+    // Names
+    std::vector<std::string> counter_names_;
+    std::vector<std::string> gauge_names_;
+    std::vector<std::string> histogram_names_;
+    std::unordered_map<std::string, MetricId> counter_ids_;
+    std::unordered_map<std::string, MetricId> gauge_ids_;
+    std::unordered_map<std::string, MetricId> histogram_ids_;
+
+    // Live shards and totals from exited threads
+    std::vector<MetricShard*> shards_;
+    std::array<uint64_t, MetricShard::MAX_COUNTERS + 1> retired_counters_{};
+    std::array<int64_t, MetricShard::MAX_GAUGES + 1> retired_gauges_{};
+    std::array<std::unique_ptr<HdrHistogram>, MetricShard::MAX_HISTOGRAMS + 1> retired_histograms_;
+
+    mutable std::mutex mutex_;
+};
+
+} // namespace arbitrage
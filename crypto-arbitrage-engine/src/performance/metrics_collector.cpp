@@ -1,5 +1,11 @@
 #include "metrics_collector.h"
+#include "utils/alloc_tracker.h"
+#include "utils/binary_log.h"
+#include "utils/huge_page_arena.h"
 #include "utils/logger.h"
+#include "utils/clock.h"
+#include <algorithm>
+#include <cstdio>
 #include <fstream>
 #include <sstream>
 #include <sys/resource.h>
@@ -9,61 +15,66 @@
 
 namespace arbitrage {
 
+namespace {
+
+constexpr MetricId DETECTION_LATENCY = metrics::id(metrics::Timer::DETECTION_CYCLE);
+constexpr MetricId EXECUTION_LATENCY = metrics::id(metrics::Timer::EXECUTION);
+constexpr MetricId MESSAGES_PROCESSED = metrics::id(metrics::Counter::MESSAGES_PROCESSED);
+constexpr MetricId OPPORTUNITIES_DETECTED = metrics::id(metrics::Counter::OPPORTUNITIES_DETECTED);
+constexpr MetricId OPPORTUNITIES_EXECUTED = metrics::id(metrics::Counter::OPPORTUNITIES_EXECUTED);
+
+} // namespace
+
 MetricsCollector::MetricsCollector() 
-    : start_time_(std::chrono::steady_clock::now()) {
+    : registry_(MetricRegistry::instance())
+    , start_time_(std::chrono::steady_clock::now()) {
     running_ = true;
     
     // Start background thread for system metrics
     metrics_thread_ = std::make_unique<std::thread>([this]() {
+        ThreadRegistry::instance().register_current_thread("metrics", ThreadRole::METRICS);
         metrics_update_loop();
     });
 }
 
 MetricsCollector::~MetricsCollector() {
     running_ = false;
+    stop_signal_.notify_all();
     
     if (metrics_thread_ && metrics_thread_->joinable()) {
         metrics_thread_->join();
     }
 }
 
+MetricId MetricsCollector::register_operation(const std::string& operation) {
+    return registry_.register_histogram(operation);
+}
+
 void MetricsCollector::record_processing_latency(const std::string& operation, uint64_t microseconds) {
-    std::lock_guard<std::mutex> lock(latency_mutex_);
+    // Name-based convenience path; resolved ids are cached per thread so the
+    // registry lock is only taken the first time a thread sees an operation
+    thread_local std::unordered_map<std::string, MetricId> resolved;
     
-    auto& tracker = operation_latencies_[operation];
-    if (!tracker) {
-        tracker = std::make_unique<LatencyTracker<1000>>();
+    auto it = resolved.find(operation);
+    if (it == resolved.end()) {
+        it = resolved.emplace(operation, register_operation(operation)).first;
     }
-    tracker->record(microseconds);
+    MetricRegistry::record(it->second, microseconds * 1000);
 }
 
 void MetricsCollector::record_detection_latency(uint64_t microseconds) {
-    std::lock_guard<std::mutex> lock(latency_mutex_);
-    detection_latencies_.record(microseconds);
+    MetricRegistry::record(DETECTION_LATENCY, microseconds * 1000);
 }
 
 void MetricsCollector::record_execution_latency(uint64_t microseconds) {
-    std::lock_guard<std::mutex> lock(latency_mutex_);
-    execution_latencies_.record(microseconds);
-}
-
-void MetricsCollector::increment_messages_processed() {
-    messages_processed_++;
-}
-
-void MetricsCollector::increment_opportunities_detected() {
-    opportunities_detected_++;
-}
-
-void MetricsCollector::increment_opportunities_executed() {
-    opportunities_executed_++;
+    MetricRegistry::record(EXECUTION_LATENCY, microseconds * 1000);
 }
 
 void MetricsCollector::record_trade(const ArbitrageOpportunity& opportunity, double actual_profit) {
     std::lock_guard<std::mutex> lock(trade_mutex_);
     
     TradeRecord record;
-    record.timestamp = utils::get_current_timestamp();
+    record.timestamp = Clock::now();
     record.opportunity_id = opportunity.id;
     record.expected_profit = opportunity.expected_profit;
     record.actual_profit = actual_profit;
@@ -71,13 +82,20 @@ void MetricsCollector::record_trade(const ArbitrageOpportunity& opportunity, dou
     
     trade_history_.push_back(record);
     
+    total_trades_++;
+    if (record.successful) {
+        winning_trades_++;
+    }
+    total_pnl_.store(total_pnl_.load() + actual_profit);
+    
     LOG_INFO("Trade recorded: {} - Expected: ${:.2f}, Actual: ${:.2f}", 
             opportunity.id, opportunity.expected_profit, actual_profit);
 }
 
 void MetricsCollector::record_missed_opportunity(const ArbitrageOpportunity& opportunity, 
                                                 const std::string& reason) {
-    LOG_WARN("Missed opportunity: {} - Reason: {}", opportunity.id, reason);
+    LOG_WARN_EVERY_MS(constants::logging::REPEAT_INTERVAL_MS,
+                      "Missed opportunity: {} - Reason: {}", opportunity.id, reason);
 }
 
 void MetricsCollector::update_memory_usage() {
@@ -98,6 +116,18 @@ void MetricsCollector::update_cpu_usage() {
     }
 }
 
+void MetricsCollector::update_thread_usage() {
+    auto samples = ThreadRegistry::instance().sample();
+    
+    std::lock_guard<std::mutex> lock(thread_samples_mutex_);
+    thread_samples_ = std::move(samples);
+}
+
+std::vector<ThreadRegistry::ThreadSample> MetricsCollector::get_thread_samples() const {
+    std::lock_guard<std::mutex> lock(thread_samples_mutex_);
+    return thread_samples_;
+}
+
 PerformanceMetrics MetricsCollector::get_current_metrics() const {
     PerformanceMetrics metrics;
     
@@ -105,31 +135,34 @@ PerformanceMetrics MetricsCollector::get_current_metrics() const {
     {
         std::lock_guard<std::mutex> lock(latency_mutex_);
         
-        if (detection_latencies_.count() > 0) {
-            metrics.avg_detection_latency = detection_latencies_.percentile(0.5);
-            metrics.max_processing_latency = detection_latencies_.max();
+        HdrHistogram detection = cumulative_histogram(DETECTION_LATENCY);
+        if (detection.count() > 0) {
+            metrics.avg_detection_latency = detection.percentile(0.5) / 1000;
+            metrics.max_processing_latency = detection.max() / 1000;
         }
         
-        // Average across all operations
-        uint64_t total_latency = 0;
+        // Mean across all operations
+        uint64_t total_latency_ns = 0;
         uint64_t total_count = 0;
         
-        for (const auto& [op, tracker] : operation_latencies_) {
-            if (tracker->count() > 0) {
-                total_latency += tracker->percentile(0.5) * tracker->count();
-                total_count += tracker->count();
-            }
+        size_t histogram_count = registry_.histogram_names().size();
+        for (MetricId id = 0; id < histogram_count; ++id) {
+            if (!is_operation(id)) continue;
+            
+            HdrHistogram histogram = cumulative_histogram(id);
+            total_latency_ns += histogram.sum();
+            total_count += histogram.count();
         }
         
         if (total_count > 0) {
-            metrics.avg_processing_latency = total_latency / total_count;
+            metrics.avg_processing_latency = total_latency_ns / total_count / 1000;
         }
     }
     
     // Throughput metrics
-    metrics.messages_processed = messages_processed_.load();
-    metrics.opportunities_detected = opportunities_detected_.load();
-    metrics.opportunities_executed = opportunities_executed_.load();
+    metrics.messages_processed = read_counter(MESSAGES_PROCESSED);
+    metrics.opportunities_detected = read_counter(OPPORTUNITIES_DETECTED);
+    metrics.opportunities_executed = read_counter(OPPORTUNITIES_EXECUTED);
     
     // System metrics
     metrics.memory_usage_mb = current_memory_mb_.load();
@@ -159,28 +192,34 @@ MetricsCollector::DetailedStatistics MetricsCollector::get_detailed_statistics()
     {
         std::lock_guard<std::mutex> lock(latency_mutex_);
         
-        for (const auto& [op, tracker] : operation_latencies_) {
-            if (tracker->count() > 0) {
-                DetailedStatistics::LatencyStats lat_stats;
-                lat_stats.p50 = tracker->percentile(0.5);
-                lat_stats.p90 = tracker->percentile(0.9);
-                lat_stats.p95 = tracker->percentile(0.95);
-                lat_stats.p99 = tracker->percentile(0.99);
-                lat_stats.max = tracker->max();
-                lat_stats.count = tracker->count();
-                
-                stats.operation_latencies[op] = lat_stats;
+        auto names = registry_.histogram_names();
+        for (MetricId id = 0; id < names.size(); ++id) {
+            if (!is_operation(id)) continue;
+            
+            HdrHistogram cumulative = cumulative_histogram(id);
+            if (cumulative.count() > 0) {
+                stats.operation_latencies[names[id]] = summarize(cumulative);
+            }
+            
+            if (id < histogram_views_.size() && histogram_views_[id] &&
+                histogram_views_[id]->last_interval.count() > 0) {
+                stats.interval_latencies[names[id]] = summarize(histogram_views_[id]->last_interval);
             }
         }
+        
+        stats.detection_latency = summarize(cumulative_histogram(DETECTION_LATENCY));
+        stats.execution_latency = summarize(cumulative_histogram(EXECUTION_LATENCY));
     }
     
     // Calculate throughput
     auto uptime = std::chrono::steady_clock::now() - start_time_;
     double uptime_seconds = std::chrono::duration<double>(uptime).count();
     
-    stats.throughput.messages_per_second = messages_processed_ / uptime_seconds;
-    stats.throughput.opportunities_per_minute = (opportunities_detected_ * 60) / uptime_seconds;
-    stats.throughput.trades_per_hour = (opportunities_executed_ * 3600) / uptime_seconds;
+    stats.throughput.messages_per_second = read_counter(MESSAGES_PROCESSED) / uptime_seconds;
+    stats.throughput.opportunities_per_minute =
+        (read_counter(OPPORTUNITIES_DETECTED) * 60) / uptime_seconds;
+    stats.throughput.trades_per_hour =
+        (read_counter(OPPORTUNITIES_EXECUTED) * 3600) / uptime_seconds;
     
     // Business statistics
     {
@@ -212,73 +251,436 @@ MetricsCollector::DetailedStatistics MetricsCollector::get_detailed_statistics()
     stats.system.avg_memory_mb = current_memory_mb_.load();
     stats.system.peak_memory_mb = peak_memory_mb_;
     stats.system.uptime_hours = uptime_seconds / 3600.0;
+    stats.threads = get_thread_samples();
+    collect_hw_stages(stats);
     
     return stats;
 }
 
-void MetricsCollector::reset() {
-    messages_processed_ = 0;
-    opportunities_detected_ = 0;
-    opportunities_executed_ = 0;
+void MetricsCollector::collect_hw_stages(DetailedStatistics& stats) const {
+    if (!HwCounters::enabled()) return;
     
+    for (size_t index = 0; index < HW_STAGE_COUNT; ++index) {
+        auto stage = static_cast<HwStage>(index);
+        
+        DetailedStatistics::HwStageStats hw{};
+        hw.samples = read_counter(HwCounters::sample_metric(stage));
+        if (hw.samples == 0) continue;
+        
+        for (size_t event = 0; event < HW_EVENT_COUNT; ++event) {
+            hw.events[event] = read_counter(HwCounters::event_metric(stage, static_cast<HwEvent>(event)));
+        }
+        
+        double samples = static_cast<double>(hw.samples);
+        double cycles = static_cast<double>(hw.events[static_cast<size_t>(HwEvent::CYCLES)]);
+        hw.instructions_per_cycle = cycles > 0.0
+            ? hw.events[static_cast<size_t>(HwEvent::INSTRUCTIONS)] / cycles
+            : 0.0;
+        hw.cycles_per_sample = cycles / samples;
+        hw.llc_misses_per_sample = hw.events[static_cast<size_t>(HwEvent::LLC_MISSES)] / samples;
+        hw.branch_misses_per_sample = hw.events[static_cast<size_t>(HwEvent::BRANCH_MISSES)] / samples;
+        
+        stats.hw_stages[std::string(HW_STAGE_NAMES[index])] = hw;
+    }
+}
+
+void MetricsCollector::reset() {
+    // Shards are never cleared by readers; record the current totals instead
     {
         std::lock_guard<std::mutex> lock(latency_mutex_);
-        operation_latencies_.clear();
-        detection_latencies_ = LatencyTracker<1000>();
-        execution_latencies_ = LatencyTracker<1000>();
+        
+        size_t counter_count = registry_.counter_names().size();
+        for (MetricId id = 0; id < counter_count; ++id) {
+            counter_baselines_[id] = registry_.read_counter(id);
+        }
+        
+        size_t histogram_count = registry_.histogram_names().size();
+        for (MetricId id = 0; id < histogram_count; ++id) {
+            auto& view = histogram_view(id);
+            view.baseline.reset();
+            registry_.read_histogram(id, view.baseline);
+            view.previous = view.baseline;
+            view.last_interval.reset();
+        }
     }
     
     {
         std::lock_guard<std::mutex> lock(trade_mutex_);
         trade_history_.clear();
+        total_trades_ = 0;
+        winning_trades_ = 0;
+        total_pnl_ = 0.0;
     }
     
     start_time_ = std::chrono::steady_clock::now();
 }
 
+HdrHistogram MetricsCollector::get_latency_histogram(const std::string& operation) const {
+    MetricId id;
+    if (!registry_.find_histogram(operation, id)) {
+        return HdrHistogram();
+    }
+    
+    std::lock_guard<std::mutex> lock(latency_mutex_);
+    return cumulative_histogram(id);
+}
+
+HdrHistogram MetricsCollector::get_detection_histogram() const {
+    std::lock_guard<std::mutex> lock(latency_mutex_);
+    return cumulative_histogram(DETECTION_LATENCY);
+}
+
+void MetricsCollector::roll_latency_intervals() {
+    std::lock_guard<std::mutex> lock(latency_mutex_);
+    
+    size_t histogram_count = registry_.histogram_names().size();
+    for (MetricId id = 0; id < histogram_count; ++id) {
+        auto& view = histogram_view(id);
+        
+        HdrHistogram raw;
+        registry_.read_histogram(id, raw);
+        
+        view.last_interval = raw;
+        view.last_interval.subtract(view.previous);
+        view.previous = raw;
+    }
+}
+
+MetricsCollector::HistogramView& MetricsCollector::histogram_view(MetricId id) {
+    if (id >= histogram_views_.size()) {
+        histogram_views_.resize(id + 1);
+    }
+    if (!histogram_views_[id]) {
+        histogram_views_[id] = std::make_unique<HistogramView>();
+    }
+    return *histogram_views_[id];
+}
+
+HdrHistogram MetricsCollector::cumulative_histogram(MetricId id) const {
+    HdrHistogram histogram;
+    registry_.read_histogram(id, histogram);
+    
+    if (id < histogram_views_.size() && histogram_views_[id]) {
+        histogram.subtract(histogram_views_[id]->baseline);
+    }
+    return histogram;
+}
+
+uint64_t MetricsCollector::read_counter(MetricId id) const {
+    std::lock_guard<std::mutex> lock(latency_mutex_);
+    
+    uint64_t value = registry_.read_counter(id);
+    uint64_t baseline = counter_baselines_[id];
+    return value > baseline ? value - baseline : 0;
+}
+
+bool MetricsCollector::is_operation(MetricId id) const {
+    return id != DETECTION_LATENCY && id != EXECUTION_LATENCY;
+}
+
+MetricsCollector::DetailedStatistics::LatencyStats 
+MetricsCollector::summarize(const HdrHistogram& histogram) {
+    // Histograms hold nanoseconds, statistics are reported in microseconds
+    DetailedStatistics::LatencyStats stats{};
+    
+    if (histogram.count() == 0) {
+        return stats;
+    }
+    
+    stats.p50 = histogram.percentile(0.50) / 1000;
+    stats.p90 = histogram.percentile(0.90) / 1000;
+    stats.p95 = histogram.percentile(0.95) / 1000;
+    stats.p99 = histogram.percentile(0.99) / 1000;
+    stats.p999 = histogram.percentile(0.999) / 1000;
+    stats.max = histogram.max() / 1000;
+    stats.count = histogram.count();
+    stats.mean = histogram.mean() / 1000.0;
+    
+    return stats;
+}
+
 std::string MetricsCollector::export_prometheus_format() const {
-    auto metrics = get_current_metrics();
-    auto stats = get_detailed_statistics();
+    std::string out;
+    render_exposition(out);
+    return out;
+}
+
+void MetricsCollector::set_exposition_interval(std::chrono::milliseconds interval) {
+    exposition_interval_ms_ = std::max<int64_t>(interval.count(), 100);
+}
+
+void MetricsCollector::copy_exposition(std::string& out) const {
+    std::lock_guard<std::mutex> lock(exposition_mutex_);
+    out.assign(exposition_);
+}
+
+void MetricsCollector::publish_exposition() {
+    // Render outside the publish lock, then swap buffers so both keep their capacity
+    render_exposition(exposition_scratch_);
     
-    std::stringstream ss;
+    std::lock_guard<std::mutex> lock(exposition_mutex_);
+    exposition_.swap(exposition_scratch_);
+}
+
+namespace {
+
+// A registered name split into Prometheus family and label set
+struct Series {
+    std::string family;
+    std::string labels;
+    MetricId id;
+};
+
+// Plain names get the engine prefix; labelled names are used verbatim
+std::vector<Series> split_series(const std::vector<std::string>& names,
+                                 const std::string& prefix, const std::string& suffix,
+                                 const char* default_label) {
+    std::vector<Series> series;
+    series.reserve(names.size());
+    
+    for (MetricId id = 0; id < names.size(); ++id) {
+        const auto& name = names[id];
+        auto brace = name.find('{');
+        
+        if (brace != std::string::npos) {
+            series.push_back({name.substr(0, brace), name.substr(brace + 1, name.size() - brace - 2), id});
+        } else if (default_label) {
+            series.push_back({prefix + suffix, std::string(default_label) + "=\"" + name + "\"", id});
+        } else {
+            series.push_back({prefix + name + suffix, std::string(), id});
+        }
+    }
     
-    // Latency metrics
-    ss << "# HELP arbitrage_processing_latency_us Processing latency in microseconds\n";
-    ss << "# TYPE arbitrage_processing_latency_us gauge\n";
-    ss << "arbitrage_processing_latency_us " << metrics.avg_processing_latency << "\n";
+    std::stable_sort(series.begin(), series.end(),
+                     [](const Series& a, const Series& b) { return a.family < b.family; });
+    return series;
+}
+
+void append_number(std::string& out, double value) {
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+    out.append(buffer, static_cast<size_t>(std::max(length, 0)));
+}
+
+void append_sample(std::string& out, const std::string& name, const std::string& labels,
+                   double value) {
+    out += name;
+    if (!labels.empty()) {
+        out.append("{").append(labels).append("}");
+    }
+    out += ' ';
+    append_number(out, value);
+    out += '\n';
+}
+
+void append_header(std::string& out, const std::string& family, const char* type) {
+    out.append("# TYPE ").append(family).append(" ").append(type).append("\n");
+}
+
+void append_gauge(std::string& out, const char* family, const char* help, double value) {
+    out.append("# HELP ").append(family).append(" ").append(help).append("\n");
+    out.append("# TYPE ").append(family).append(" gauge\n");
+    out.append(family).append(" ");
+    append_number(out, value);
+    out += '\n';
+}
+
+std::string thread_labels(const ThreadRegistry::ThreadSample& thread) {
+    // Unregistered threads carry their raw comm, which may contain anything
+    std::string name = thread.name;
+    std::replace_if(name.begin(), name.end(), [](char c) { return c == '"' || c == '\\'; }, '_');
     
-    ss << "# HELP arbitrage_detection_latency_us Detection latency in microseconds\n";
-    ss << "# TYPE arbitrage_detection_latency_us gauge\n";
-    ss << "arbitrage_detection_latency_us " << metrics.avg_detection_latency << "\n";
+    return "thread=\"" + name + "\",role=\"" + thread_role_to_string(thread.role) +
+           "\",tid=\"" + std::to_string(thread.tid) + "\"";
+}
+
+// Exposition bucket bounds in nanoseconds (1us .. 1s)
+constexpr uint64_t EXPOSITION_BUCKETS_NS[] = {
+    1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 500000,
+    1000000, 2500000, 5000000, 10000000, 25000000, 50000000, 100000000,
+    250000000, 500000000, 1000000000
+};
+
+} // namespace
+
+void MetricsCollector::render_exposition(std::string& out) const {
+    out.clear();
+    
+    // Counters
+    std::string last_family;
+    for (const auto& series : split_series(registry_.counter_names(), "arbitrage_", "_total", nullptr)) {
+        if (series.family != last_family) {
+            append_header(out, series.family, "counter");
+            last_family = series.family;
+        }
+        append_sample(out, series.family, series.labels,
+                      static_cast<double>(registry_.read_counter(series.id)));
+    }
     
-    // Throughput metrics
-    ss << "# HELP arbitrage_messages_processed_total Total messages processed\n";
-    ss << "# TYPE arbitrage_messages_processed_total counter\n";
-    ss << "arbitrage_messages_processed_total " << metrics.messages_processed << "\n";
+    // Sharded gauges
+    last_family.clear();
+    for (const auto& series : split_series(registry_.gauge_names(), "arbitrage_", "", nullptr)) {
+        if (series.family != last_family) {
+            append_header(out, series.family, "gauge");
+            last_family = series.family;
+        }
+        append_sample(out, series.family, series.labels,
+                      static_cast<double>(registry_.read_gauge(series.id)));
+    }
     
-    ss << "# HELP arbitrage_opportunities_detected_total Total opportunities detected\n";
-    ss << "# TYPE arbitrage_opportunities_detected_total counter\n";
-    ss << "arbitrage_opportunities_detected_total " << metrics.opportunities_detected << "\n";
+    // Latency histograms - plain names are pipeline stages
+    last_family.clear();
+    HdrHistogram histogram;
+    std::string labels;
     
-    // Business metrics
-    ss << "# HELP arbitrage_total_pnl_usd Total P&L in USD\n";
-    ss << "# TYPE arbitrage_total_pnl_usd gauge\n";
-    ss << "arbitrage_total_pnl_usd " << metrics.total_pnl << "\n";
+    for (const auto& series : split_series(registry_.histogram_names(),
+                                           "arbitrage_stage_latency", "_seconds", "stage")) {
+        if (series.family != last_family) {
+            append_header(out, series.family, "histogram");
+            last_family = series.family;
+        }
+        
+        histogram.reset();
+        registry_.read_histogram(series.id, histogram);
+        
+        std::string separator = series.labels.empty() ? "" : ",";
+        for (uint64_t bound : EXPOSITION_BUCKETS_NS) {
+            labels = series.labels + separator + "le=\"";
+            append_number(labels, static_cast<double>(bound) / 1e9);
+            labels += '"';
+            append_sample(out, series.family + "_bucket", labels,
+                          static_cast<double>(histogram.count_at_or_below(bound)));
+        }
+        append_sample(out, series.family + "_bucket", series.labels + separator + "le=\"+Inf\"",
+                      static_cast<double>(histogram.count()));
+        append_sample(out, series.family + "_sum", series.labels,
+                      static_cast<double>(histogram.sum()) / 1e9);
+        append_sample(out, series.family + "_count", series.labels,
+                      static_cast<double>(histogram.count()));
+    }
+
+    // Updates to names registered after the slots ran out
+    append_header(out, "arbitrage_metric_dropped_total", "counter");
+    append_sample(out, "arbitrage_metric_dropped_total", "kind=\"counter\"",
+                  static_cast<double>(registry_.dropped_counter_increments()));
+    append_sample(out, "arbitrage_metric_dropped_total", "kind=\"histogram\"",
+                  static_cast<double>(registry_.dropped_histogram_samples()));
+
+    // Business and system gauges (running totals, no trade-history walk)
+    uint64_t total_trades = total_trades_.load();
+    double win_rate = total_trades > 0
+        ? static_cast<double>(winning_trades_.load()) / total_trades
+        : 0.0;
+    double uptime_seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start_time_).count();
+    
+    append_gauge(out, "arbitrage_total_pnl_usd", "Total P&L in USD", total_pnl_.load());
+    append_gauge(out, "arbitrage_trades", "Trades recorded", static_cast<double>(total_trades));
+    append_gauge(out, "arbitrage_win_rate", "Fraction of profitable trades", win_rate);
+    append_gauge(out, "arbitrage_memory_usage_mb", "Resident memory in MB",
+                 static_cast<double>(current_memory_mb_.load()));
+    append_gauge(out, "arbitrage_cpu_usage_percent", "Process CPU usage percentage",
+                 current_cpu_percent_.load());
+    append_gauge(out, "arbitrage_uptime_seconds", "Seconds since start", uptime_seconds);
+    
+    auto huge_pages = HugePageArena::stats();
+    if (huge_pages.backing != HugePageArena::Backing::DISABLED) {
+        append_gauge(out, "arbitrage_huge_page_reserved_bytes", "Size of the huge page arena",
+                     static_cast<double>(huge_pages.reserved_bytes));
+        append_gauge(out, "arbitrage_huge_page_backed_bytes", "Arena bytes backed by huge pages",
+                     static_cast<double>(huge_pages.huge_page_bytes));
+        append_gauge(out, "arbitrage_huge_page_used_bytes", "Arena bytes handed out",
+                     static_cast<double>(huge_pages.used_bytes));
+        append_gauge(out, "arbitrage_huge_page_fallback_bytes", "Bytes served by the heap after the arena filled",
+                     static_cast<double>(huge_pages.fallback_bytes));
+    }
+    
+    auto logging = Logger::async_stats();
+    if (logging.enabled) {
+        append_header(out, "arbitrage_log_dropped_total", "counter");
+        append_sample(out, "arbitrage_log_dropped_total", "", static_cast<double>(logging.dropped));
+        append_header(out, "arbitrage_log_truncated_total", "counter");
+        append_sample(out, "arbitrage_log_truncated_total", "", static_cast<double>(logging.truncated));
+        append_gauge(out, "arbitrage_log_queue_depth", "Records waiting for the async log writer",
+                     static_cast<double>(logging.queue_depth));
+        
+        auto fast = BinaryLog::stats();
+        append_header(out, "arbitrage_log_fast_dropped_total", "counter");
+        append_sample(out, "arbitrage_log_fast_dropped_total", "", static_cast<double>(fast.dropped));
+    }
     
-    ss << "# HELP arbitrage_win_rate Win rate percentage\n";
-    ss << "# TYPE arbitrage_win_rate gauge\n";
-    ss << "arbitrage_win_rate " << stats.business.win_rate * 100 << "\n";
+    // Per-thread usage from the last /proc sample
+    std::lock_guard<std::mutex> lock(thread_samples_mutex_);
     
-    // System metrics
-    ss << "# HELP arbitrage_memory_usage_mb Memory usage in MB\n";
-    ss << "# TYPE arbitrage_memory_usage_mb gauge\n";
-    ss << "arbitrage_memory_usage_mb " << metrics.memory_usage_mb << "\n";
+    append_header(out, "arbitrage_thread_cpu_percent", "gauge");
+    for (const auto& thread : thread_samples_) {
+        labels = thread_labels(thread);
+        append_sample(out, "arbitrage_thread_cpu_percent", labels, thread.cpu_percent);
+    }
+    
+    append_header(out, "arbitrage_thread_context_switches_total", "counter");
+    for (const auto& thread : thread_samples_) {
+        labels = thread_labels(thread);
+        append_sample(out, "arbitrage_thread_context_switches_total", labels + ",kind=\"voluntary\"",
+                      static_cast<double>(thread.voluntary_switches));
+        append_sample(out, "arbitrage_thread_context_switches_total", labels + ",kind=\"involuntary\"",
+                      static_cast<double>(thread.involuntary_switches));
+    }
     
-    ss << "# HELP arbitrage_cpu_usage_percent CPU usage percentage\n";
-    ss << "# TYPE arbitrage_cpu_usage_percent gauge\n";
-    ss << "arbitrage_cpu_usage_percent " << metrics.cpu_usage_percent << "\n";
+    append_header(out, "arbitrage_thread_last_cpu", "gauge");
+    for (const auto& thread : thread_samples_) {
+        labels = thread_labels(thread);
+        append_sample(out, "arbitrage_thread_last_cpu", labels, thread.last_cpu);
+    }
+    
+    // Heap allocations per pipeline stage and thread (TRACK_ALLOCATIONS builds)
+    if (!AllocTracker::enabled()) return;
+    
+    auto stages = AllocTracker::stage_totals();
+    append_header(out, "arbitrage_allocations_total", "counter");
+    for (size_t stage = 0; stage < stages.size(); ++stage) {
+        labels = "stage=\"" + std::string(AllocTracker::stage_name(stage)) + "\"";
+        append_sample(out, "arbitrage_allocations_total", labels,
+                      static_cast<double>(stages[stage].allocations));
+    }
+    
+    append_header(out, "arbitrage_allocated_bytes_total", "counter");
+    for (size_t stage = 0; stage < stages.size(); ++stage) {
+        labels = "stage=\"" + std::string(AllocTracker::stage_name(stage)) + "\"";
+        append_sample(out, "arbitrage_allocated_bytes_total", labels,
+                      static_cast<double>(stages[stage].bytes_allocated));
+    }
+    
+    append_header(out, "arbitrage_freed_bytes_total", "counter");
+    for (size_t stage = 0; stage < stages.size(); ++stage) {
+        labels = "stage=\"" + std::string(AllocTracker::stage_name(stage)) + "\"";
+        append_sample(out, "arbitrage_freed_bytes_total", labels,
+                      static_cast<double>(stages[stage].bytes_freed));
+    }
+    
+    // Live threads only; labelled like the /proc series when sampled
+    auto threads = AllocTracker::thread_totals();
+    std::vector<std::string> thread_label_sets;
+    thread_label_sets.reserve(threads.size());
+    for (const auto& thread : threads) {
+        auto sample = std::find_if(thread_samples_.begin(), thread_samples_.end(),
+                                   [&](const auto& s) { return s.tid == thread.tid; });
+        thread_label_sets.push_back(sample != thread_samples_.end()
+            ? thread_labels(*sample)
+            : "tid=\"" + std::to_string(thread.tid) + "\"");
+    }
     
-    return ss.str();
+    append_header(out, "arbitrage_thread_allocations_total", "counter");
+    for (size_t i = 0; i < threads.size(); ++i) {
+        append_sample(out, "arbitrage_thread_allocations_total", thread_label_sets[i],
+                      static_cast<double>(threads[i].stats.allocations));
+    }
+    
+    append_header(out, "arbitrage_thread_allocated_bytes_total", "counter");
+    for (size_t i = 0; i < threads.size(); ++i) {
+        append_sample(out, "arbitrage_thread_allocated_bytes_total", thread_label_sets[i],
+                      static_cast<double>(threads[i].stats.bytes_allocated));
+    }
 }
 
 std::string MetricsCollector::export_json() const {
@@ -306,9 +708,25 @@ std::string MetricsCollector::export_json() const {
     system.AddMember("cpu_percent", metrics.cpu_usage_percent, allocator);
     system.AddMember("uptime_hours", stats.system.uptime_hours, allocator);
     
+    rapidjson::Value hw_counters(rapidjson::kObjectType);
+    for (const auto& [stage, hw] : stats.hw_stages) {
+        rapidjson::Value entry(rapidjson::kObjectType);
+        entry.AddMember("samples", hw.samples, allocator);
+        for (size_t event = 0; event < HW_EVENT_COUNT; ++event) {
+            entry.AddMember(rapidjson::StringRef(HW_EVENT_NAMES[event].data(), HW_EVENT_NAMES[event].size()),
+                            hw.events[event], allocator);
+        }
+        entry.AddMember("ipc", hw.instructions_per_cycle, allocator);
+        entry.AddMember("cycles_per_sample", hw.cycles_per_sample, allocator);
+        entry.AddMember("llc_misses_per_sample", hw.llc_misses_per_sample, allocator);
+        entry.AddMember("branch_misses_per_sample", hw.branch_misses_per_sample, allocator);
+        hw_counters.AddMember(rapidjson::Value(stage.c_str(), allocator), entry, allocator);
+    }
+    
     doc.AddMember("performance", performance, allocator);
     doc.AddMember("business", business, allocator);
     doc.AddMember("system", system, allocator);
+    doc.AddMember("hw_counters", hw_counters, allocator);
     
     rapidjson::StringBuffer buffer;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
@@ -318,11 +736,28 @@ std::string MetricsCollector::export_json() const {
 }
 
 void MetricsCollector::metrics_update_loop() {
+    auto next_sample = std::chrono::steady_clock::now();
+    auto next_render = next_sample;
+    WaitStrategy wait(WaitStrategy::for_role(ThreadRole::METRICS));
+    uint32_t seen = stop_signal_.epoch();
+    
     while (running_) {
-        update_memory_usage();
-        update_cpu_usage();
+        auto now = std::chrono::steady_clock::now();
         
-        std::this_thread::sleep_for(std::chrono::seconds(1));
+        if (now >= next_sample) {
+            update_memory_usage();
+            update_cpu_usage();
+            update_thread_usage();
+            roll_latency_intervals();
+            next_sample += std::chrono::seconds(1);
+        }
+        
+        if (now >= next_render) {
+            publish_exposition();
+            next_render = now + std::chrono::milliseconds(exposition_interval_ms_.load());
+        }
+        
+        wait.wait(stop_signal_, seen, std::min(next_sample, next_render));
     }
 }
 
@@ -338,21 +773,27 @@ uint64_t MetricsCollector::get_process_memory_mb() const {
     return 0;
 }
 
-double MetricsCollector::get_process_cpu_percent() const {
-    // Simplified CPU usage - would need more sophisticated implementation
+double MetricsCollector::get_process_cpu_percent() {
+    // CPU over the last sample interval, not the lifetime average
     struct rusage usage;
-    if (getrusage(RUSAGE_SELF, &usage) == 0) {
-        double cpu_time = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 +
-                         usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
-        
-        auto uptime = std::chrono::steady_clock::now() - start_time_;
-        double uptime_seconds = std::chrono::duration<double>(uptime).count();
-        
-        if (uptime_seconds > 0) {
-            return (cpu_time / uptime_seconds) * 100.0;
-        }
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0.0;
     }
-    return 0.0;
+    
+    double cpu_time = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 +
+                     usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+    auto now = std::chrono::steady_clock::now();
+    
+    if (last_cpu_sample_.time_since_epoch().count() == 0) {
+        last_cpu_sample_ = start_time_;
+    }
+    
+    double elapsed = std::chrono::duration<double>(now - last_cpu_sample_).count();
+    double percent = elapsed > 0 ? ((cpu_time - last_cpu_time_) / elapsed) * 100.0 : 0.0;
+    
+    last_cpu_time_ = cpu_time;
+    last_cpu_sample_ = now;
+    return percent;
 }
 
 } // namespace arbitrage
\ No newline at end of file
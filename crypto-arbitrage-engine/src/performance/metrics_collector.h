@@ -1,11 +1,20 @@
 #pragma once
 
 #include "core/types.h"
+#include "hdr_histogram.h"
+#include "hw_counters.h"
+#include "metric_ids.h"
+#include "metric_shards.h"
+#include "scope_timer.h"
+#include "utils/thread_registry.h"
+#include "utils/wait_strategy.h"
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <unordered_map>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 namespace arbitrage {
 
@@ -14,15 +23,26 @@ public:
     MetricsCollector();
     ~MetricsCollector();
     
-    // Latency tracking
+    // Latency tracking - hot paths register an operation once and record by id
+    MetricId register_operation(const std::string& operation);
+    void record_latency_ns(MetricId operation, uint64_t nanoseconds) {
+        MetricRegistry::record(operation, nanoseconds);
+    }
+    
     void record_processing_latency(const std::string& operation, uint64_t microseconds);
     void record_detection_latency(uint64_t microseconds);
     void record_execution_latency(uint64_t microseconds);
     
     // Throughput tracking
-    void increment_messages_processed();
-    void increment_opportunities_detected();
-    void increment_opportunities_executed();
+    void increment_messages_processed() {
+        MetricRegistry::increment(metrics::id(metrics::Counter::MESSAGES_PROCESSED));
+    }
+    void increment_opportunities_detected() {
+        MetricRegistry::increment(metrics::id(metrics::Counter::OPPORTUNITIES_DETECTED));
+    }
+    void increment_opportunities_executed() {
+        MetricRegistry::increment(metrics::id(metrics::Counter::OPPORTUNITIES_EXECUTED));
+    }
     
     // Business metrics
     void record_trade(const ArbitrageOpportunity& opportunity, double actual_profit);
@@ -31,6 +51,14 @@ public:
     // System metrics
     void update_memory_usage();
     void update_cpu_usage();
+    void update_thread_usage();
+    
+    // Latest process-wide sample (refreshed every second); plain atomic loads
+    double cpu_usage_percent() const { return current_cpu_percent_.load(std::memory_order_relaxed); }
+    uint64_t memory_usage_mb() const { return current_memory_mb_.load(std::memory_order_relaxed); }
+    
+    // Latest per-thread CPU / context-switch sample (refreshed every second)
+    std::vector<ThreadRegistry::ThreadSample> get_thread_samples() const;
     
     // Get current metrics
     PerformanceMetrics get_current_metrics() const;
@@ -43,11 +71,19 @@ public:
             uint64_t p90;
             uint64_t p95;
             uint64_t p99;
+            uint64_t p999;
             uint64_t max;
             uint64_t count;
+            double mean;
         };
         
+        // Cumulative since start/reset
         std::unordered_map<std::string, LatencyStats> operation_latencies;
+        LatencyStats detection_latency;
+        LatencyStats execution_latency;
+        
+        // Last completed metrics interval only
+        std::unordered_map<std::string, LatencyStats> interval_latencies;
         
         // Throughput over time
         struct ThroughputStats {
@@ -81,10 +117,32 @@ public:
         };
         
         SystemStats system;
+        
+        // Per-thread usage over the last sample interval
+        std::vector<ThreadRegistry::ThreadSample> threads;
+        
+        // Hardware counters per pipeline stage (empty unless HwCounters is enabled)
+        struct HwStageStats {
+            uint64_t samples;
+            std::array<uint64_t, HW_EVENT_COUNT> events;    // Indexed by HwEvent
+            double instructions_per_cycle;
+            double cycles_per_sample;
+            double llc_misses_per_sample;
+            double branch_misses_per_sample;
+        };
+        
+        std::unordered_map<std::string, HwStageStats> hw_stages;
     };
     
     DetailedStatistics get_detailed_statistics() const;
     
+    // Mergeable histogram snapshots (nanoseconds)
+    HdrHistogram get_latency_histogram(const std::string& operation) const;
+    HdrHistogram get_detection_histogram() const;
+    
+    // Close the current latency interval (driven by the metrics thread)
+    void roll_latency_intervals();
+    
     // Reset metrics
     void reset();
     
@@ -92,57 +150,26 @@ public:
     std::string export_prometheus_format() const;
     std::string export_json() const;
     
+    // Pre-rendered Prometheus exposition, refreshed by the metrics thread.
+    // Readers only take the publish lock, never a recording-path lock.
+    void set_exposition_interval(std::chrono::milliseconds interval);
+    void copy_exposition(std::string& out) const;
+    
 private:
-    // Latency tracking with circular buffer
-    template<size_t N>
-    class LatencyTracker {
-    public:
-        void record(uint64_t value) {
-            buffer_[index_ % N] = value;
-            index_++;
-            count_ = std::min(count_ + 1, N);
-        }
-        
-        uint64_t percentile(double p) const {
-            if (count_ == 0) return 0;
-            
-            std::vector<uint64_t> sorted;
-            sorted.reserve(count_);
-            
-            for (size_t i = 0; i < count_; ++i) {
-                sorted.push_back(buffer_[i]);
-            }
-            
-            std::sort(sorted.begin(), sorted.end());
-            
-            size_t idx = static_cast<size_t>(p * (count_ - 1));
-            return sorted[idx];
-        }
-        
-        uint64_t max() const {
-            if (count_ == 0) return 0;
-            return *std::max_element(buffer_.begin(), buffer_.begin() + count_);
-        }
-        
-        size_t count() const { return count_; }
-        
-    private:
-        std::array<uint64_t, N> buffer_{};
-        size_t index_ = 0;
-        size_t count_ = 0;
+    MetricRegistry& registry_;
+    
+    // Read-side views over the sharded latency histograms (nanoseconds).
+    // Shards only ever grow; reset() and interval rolls work on differences.
+    struct HistogramView {
+        HdrHistogram baseline;          // Raw totals at the last reset
+        HdrHistogram previous;          // Raw totals at the last interval roll
+        HdrHistogram last_interval;
     };
     
-    // Latency trackers
-    std::unordered_map<std::string, std::unique_ptr<LatencyTracker<1000>>> operation_latencies_;
-    LatencyTracker<1000> detection_latencies_;
-    LatencyTracker<1000> execution_latencies_;
+    std::vector<std::unique_ptr<HistogramView>> histogram_views_;   // Indexed by MetricId
+    std::array<uint64_t, MetricShard::MAX_COUNTERS> counter_baselines_{};
     mutable std::mutex latency_mutex_;
     
-    // Throughput counters
-    std::atomic<uint64_t> messages_processed_{0};
-    std::atomic<uint64_t> opportunities_detected_{0};
-    std::atomic<uint64_t> opportunities_executed_{0};
-    
     // Business metrics
     struct TradeRecord {
         Timestamp timestamp;
@@ -155,11 +182,21 @@ private:
     std::vector<TradeRecord> trade_history_;
     mutable std::mutex trade_mutex_;
     
+    // Running business totals so exposition never walks trade_history_
+    std::atomic<uint64_t> total_trades_{0};
+    std::atomic<uint64_t> winning_trades_{0};
+    std::atomic<double> total_pnl_{0.0};
+    
     // System metrics
     std::atomic<uint64_t> current_memory_mb_{0};
     std::atomic<double> current_cpu_percent_{0.0};
     uint64_t peak_memory_mb_ = 0;
     double peak_cpu_percent_ = 0.0;
+    double last_cpu_time_ = 0.0;
+    std::chrono::steady_clock::time_point last_cpu_sample_;
+    
+    std::vector<ThreadRegistry::ThreadSample> thread_samples_;
+    mutable std::mutex thread_samples_mutex_;
     
     // Start time
     std::chrono::steady_clock::time_point start_time_;
@@ -167,10 +204,25 @@ private:
     // Background thread for system metrics
     std::unique_ptr<std::thread> metrics_thread_;
     std::atomic<bool> running_{false};
+    WakeSignal stop_signal_;
+    
+    // Prometheus exposition
+    std::string exposition_scratch_;                // Render buffer, metrics thread only
+    std::string exposition_;                        // Last published rendering
+    mutable std::mutex exposition_mutex_;
+    std::atomic<int64_t> exposition_interval_ms_{1000};
     
     void metrics_update_loop();
+    void render_exposition(std::string& out) const;
+    void publish_exposition();
+    HistogramView& histogram_view(MetricId id);
+    HdrHistogram cumulative_histogram(MetricId id) const;
+    uint64_t read_counter(MetricId id) const;
+    void collect_hw_stages(DetailedStatistics& stats) const;
+    bool is_operation(MetricId id) const;
+    static DetailedStatistics::LatencyStats summarize(const HdrHistogram& histogram);
     uint64_t get_process_memory_mb() const;
-    double get_process_cpu_percent() const;
+    double get_process_cpu_percent();
 };
 
 // Global metrics instance
@@ -182,22 +234,4 @@ public:
     }
 };
 
-// RAII metric timer
-class MetricTimer {
-public:
-    MetricTimer(const std::string& operation)
-        : operation_(operation)
-        , start_(std::chrono::high_resolution_clock::now()) {}
-    
-    ~MetricTimer() {
-        auto end = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start_).count();
-        GlobalMetrics::instance().record_processing_latency(operation_, duration);
-    }
-    
-private:
-    std::string operation_;
-    std::chrono::high_resolution_clock::time_point start_;
-};
-
 } // namespace arbitrage
\ No newline at end of file
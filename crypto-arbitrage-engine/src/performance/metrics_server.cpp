@@ -0,0 +1,171 @@
+#include "metrics_server.h"
+#include "metrics_collector.h"
+#include "utils/logger.h"
+#include "utils/thread_registry.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace arbitrage {
+
+namespace {
+
+constexpr int ACCEPT_POLL_MS = 200;         // Bounds shutdown latency
+constexpr int CLIENT_TIMEOUT_MS = 1000;     // Per recv / send, so a stalled scraper cannot hold the thread
+constexpr size_t MAX_REQUEST_BYTES = 4096;
+
+const char NOT_FOUND_RESPONSE[] =
+    "HTTP/1.0 404 Not Found\r\n"
+    "Content-Type: text/plain\r\n"
+    "Content-Length: 10\r\n"
+    "Connection: close\r\n\r\n"
+    "Not Found\n";
+
+} // namespace
+
+MetricsServer::MetricsServer(MetricsCollector* collector, uint16_t port, const std::string& bind_address)
+    : collector_(collector)
+    , port_(port)
+    , bind_address_(bind_address) {
+    request_buffer_.reserve(MAX_REQUEST_BYTES);
+}
+
+MetricsServer::~MetricsServer() {
+    stop();
+}
+
+bool MetricsServer::start() {
+    if (running_) return true;
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port_);
+    if (::inet_pton(AF_INET, bind_address_.c_str(), &address.sin_addr) != 1) {
+        LOG_ERROR("Metrics server: invalid bind address {}", bind_address_);
+        return false;
+    }
+
+    listen_fd_ = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listen_fd_ < 0) {
+        LOG_ERROR("Metrics server: socket() failed: {}", std::strerror(errno));
+        return false;
+    }
+
+    int enable = 1;
+    ::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        ::listen(listen_fd_, 16) < 0) {
+        LOG_ERROR("Metrics server: cannot listen on {}:{}: {}", bind_address_, port_, std::strerror(errno));
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+        return false;
+    }
+
+    running_ = true;
+    server_thread_ = std::make_unique<std::thread>([this]() {
+        ThreadRegistry::instance().register_current_thread("metrics-http", ThreadRole::METRICS);
+        serve_loop();
+    });
+
+    LOG_INFO("Metrics endpoint listening on {}:{}/metrics", bind_address_, port_);
+    return true;
+}
+
+void MetricsServer::stop() {
+    if (!running_) return;
+
+    running_ = false;
+
+    if (server_thread_ && server_thread_->joinable()) {
+        server_thread_->join();
+    }
+
+    if (listen_fd_ >= 0) {
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+    }
+
+    LOG_INFO("Metrics endpoint stopped");
+}
+
+void MetricsServer::serve_loop() {
+    pollfd listener{listen_fd_, POLLIN, 0};
+
+    while (running_) {
+        int ready = ::poll(&listener, 1, ACCEPT_POLL_MS);
+        if (ready <= 0) continue;
+
+        int client_fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client_fd < 0) continue;
+
+        // A scraper that stops reading fails the send instead of blocking it
+        timeval send_timeout{CLIENT_TIMEOUT_MS / 1000, (CLIENT_TIMEOUT_MS % 1000) * 1000};
+        ::setsockopt(client_fd, SOL_SOCKET, SO_SNDTIMEO, &send_timeout, sizeof(send_timeout));
+
+        // Scrapes are rare and tiny - serve them one at a time on this thread
+        handle_connection(client_fd);
+        ::close(client_fd);
+    }
+}
+
+void MetricsServer::handle_connection(int client_fd) {
+    request_buffer_.clear();
+    char chunk[1024];
+
+    // Read until the end of the request headers
+    while (request_buffer_.size() < MAX_REQUEST_BYTES &&
+           request_buffer_.find("\r\n\r\n") == std::string::npos) {
+        pollfd client{client_fd, POLLIN, 0};
+        if (::poll(&client, 1, CLIENT_TIMEOUT_MS) <= 0) return;
+
+        ssize_t received = ::recv(client_fd, chunk, sizeof(chunk), 0);
+        if (received <= 0) return;
+        request_buffer_.append(chunk, static_cast<size_t>(received));
+    }
+
+    bool is_metrics = request_buffer_.compare(0, 13, "GET /metrics ") == 0 ||
+                      request_buffer_.compare(0, 13, "GET /metrics?") == 0;
+    if (!is_metrics) {
+        send_all(client_fd, NOT_FOUND_RESPONSE, sizeof(NOT_FOUND_RESPONSE) - 1);
+        return;
+    }
+
+    collector_->copy_exposition(response_body_);
+
+    response_header_ = "HTTP/1.0 200 OK\r\n"
+                       "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                       "Connection: close\r\n"
+                       "Content-Length: ";
+    response_header_ += std::to_string(response_body_.size());
+    response_header_ += "\r\n\r\n";
+
+    if (send_all(client_fd, response_header_.data(), response_header_.size()) &&
+        send_all(client_fd, response_body_.data(), response_body_.size())) {
+        scrapes_served_++;
+    }
+}
+
+bool MetricsServer::send_all(int fd, const char* data, size_t length) const {
+    while (length > 0) {
+        // Checked between partial sends so stop() is never held up by more
+        // than one send timeout
+        if (!running_) return false;
+
+        ssize_t sent = ::send(fd, data, length, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            return false;           // Including EAGAIN from SO_SNDTIMEO
+        }
+        data += sent;
+        length -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+} // namespace arbitrage
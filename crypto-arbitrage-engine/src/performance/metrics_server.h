@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace arbitrage {
+
+class MetricsCollector;
+
+// Minimal HTTP/1.0 endpoint serving GET /metrics for Prometheus.
+//
+// Runs on its own thread and only copies the exposition text the metrics
+// thread already rendered, so a scrape never renders, walks histograms or
+// touches a lock on the recording path.
+class MetricsServer {
+public:
+    // bind_address is an IPv4 address; the loopback default keeps the
+    // endpoint off the network unless the config opens it up
+    MetricsServer(MetricsCollector* collector, uint16_t port,
+                  const std::string& bind_address = "127.0.0.1");
+    ~MetricsServer();
+
+    bool start();
+    void stop();
+
+    bool is_running() const { return running_.load(); }
+    uint16_t port() const { return port_; }
+    uint64_t scrapes_served() const { return scrapes_served_.load(); }
+
+private:
+    MetricsCollector* collector_;
+    uint16_t port_;
+    std::string bind_address_;
+    int listen_fd_ = -1;
+
+    std::unique_ptr<std::thread> server_thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> scrapes_served_{0};
+
+    // Reused across scrapes
+    std::string request_buffer_;
+    std::string response_body_;
+    std::string response_header_;
+
+    void serve_loop();
+    void handle_connection(int client_fd);
+    bool send_all(int fd, const char* data, size_t length) const;
+};
+
+} // namespace arbitrage
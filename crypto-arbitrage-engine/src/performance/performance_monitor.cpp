@@ -0,0 +1,819 @@
+#include "performance_monitor.h"
+#include "metrics_collector.h"
+#include "market_data/market_data_manager.h"
+#include "risk/risk_manager.h"
+#include "utils/logger.h"
+#include "utils/thread_registry.h"
+#include "core/utils.h"
+#include "utils/clock.h"
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sys/resource.h>
+
+namespace arbitrage {
+
+namespace {
+
+// Keeps SLO evaluation from competing with detection for a core
+constexpr int MONITOR_NICE = 10;
+
+// Evaluation history kept for the daily report
+constexpr std::chrono::hours SAMPLE_HISTORY{24};
+constexpr size_t MAX_ALERT_HISTORY = 1000;
+
+// Hit rate is noise below this many detections in a window
+constexpr uint64_t MIN_HIT_RATE_DETECTIONS = 20;
+
+const std::string TICK_TO_SIGNAL_SLO = "tick_to_signal_p99";
+const std::string DETECTION_SLO = "detection_p99";
+
+double overshoot(double observed, double threshold) {
+    // 0 at the threshold, 1 at twice (or half, for floors) the threshold
+    if (threshold <= 0.0) return 1.0;
+    return std::clamp(std::abs(observed - threshold) / threshold, 0.0, 1.0);
+}
+
+const char* risk_alert_to_string(RiskManager::Alert::Type type) {
+    switch (type) {
+        case RiskManager::Alert::POSITION_LIMIT_WARNING: return "position_limit";
+        case RiskManager::Alert::EXCHANGE_EXPOSURE_WARNING: return "exchange_exposure";
+        case RiskManager::Alert::CORRELATION_RISK_WARNING: return "correlation_risk";
+        case RiskManager::Alert::VAR_BREACH: return "var_breach";
+        case RiskManager::Alert::DRAWDOWN_WARNING: return "drawdown";
+        case RiskManager::Alert::LIQUIDATION_WARNING: return "liquidation";
+    }
+    return "unknown";
+}
+
+std::string format_double(const char* format, double value) {
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), format, value);
+    return buffer;
+}
+
+} // namespace
+
+const char* alert_type_to_string(PerformanceMonitor::PerformanceAlert::AlertType type) {
+    switch (type) {
+        case PerformanceMonitor::PerformanceAlert::HIGH_LATENCY: return "HIGH_LATENCY";
+        case PerformanceMonitor::PerformanceAlert::LOW_THROUGHPUT: return "LOW_THROUGHPUT";
+        case PerformanceMonitor::PerformanceAlert::HIGH_CPU: return "HIGH_CPU";
+        case PerformanceMonitor::PerformanceAlert::HIGH_MEMORY: return "HIGH_MEMORY";
+        case PerformanceMonitor::PerformanceAlert::LOW_HIT_RATE: return "LOW_HIT_RATE";
+        case PerformanceMonitor::PerformanceAlert::RISK_LIMIT_BREACH: return "RISK_LIMIT_BREACH";
+    }
+    return "UNKNOWN";
+}
+
+PerformanceMonitor::PerformanceMonitor(MetricsCollector* metrics,
+                                     MarketDataManager* market_data,
+                                     ArbitrageDetector* arbitrage_detector,
+                                     RiskManager* risk_manager)
+    : metrics_(metrics)
+    , market_data_(market_data)
+    , arbitrage_detector_(arbitrage_detector)
+    , risk_manager_(risk_manager) {
+}
+
+PerformanceMonitor::~PerformanceMonitor() {
+    stop();
+}
+
+void PerformanceMonitor::set_slo_config(const SloConfig& config) {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    config_ = config;
+    config_.evaluation_interval = std::max(config_.evaluation_interval, std::chrono::seconds(1));
+    config_.window = std::max(config_.window, config_.evaluation_interval);
+}
+
+PerformanceMonitor::SloConfig PerformanceMonitor::get_slo_config() const {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    return config_;
+}
+
+void PerformanceMonitor::start() {
+    if (running_) return;
+
+    running_ = true;
+    monitor_thread_ = std::make_unique<std::thread>([this]() {
+        ThreadRegistry::instance().register_current_thread("perf-monitor", ThreadRole::MONITOR);
+
+        // Linux applies nice per thread; failure only costs priority, not correctness
+        if (setpriority(PRIO_PROCESS, static_cast<id_t>(ThreadRegistry::current_tid()), MONITOR_NICE) != 0) {
+            LOG_DEBUG("PerformanceMonitor: could not lower thread priority");
+        }
+
+        monitor_loop();
+    });
+
+    auto config = get_slo_config();
+    LOG_INFO("PerformanceMonitor started: tick-to-signal p99 < {:.0f}us, window {}s, every {}s",
+             config.tick_to_signal_p99_us, config.window.count(), config.evaluation_interval.count());
+}
+
+void PerformanceMonitor::stop() {
+    if (!running_) return;
+
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        running_ = false;
+    }
+    wake_.notify_all();
+
+    if (monitor_thread_ && monitor_thread_->joinable()) {
+        monitor_thread_->join();
+    }
+
+    LOG_INFO("PerformanceMonitor stopped");
+}
+
+void PerformanceMonitor::register_alert_callback(AlertCallback callback) {
+    std::lock_guard<std::mutex> lock(alerts_mutex_);
+    alert_callbacks_.push_back(std::move(callback));
+}
+
+void PerformanceMonitor::monitor_loop() {
+    auto last_hourly = std::chrono::steady_clock::now();
+    auto last_daily = last_hourly;
+
+    while (running_) {
+        auto config = get_slo_config();
+
+        current_ = EvaluationSample{};
+        current_.timestamp = Clock::now();
+
+        check_latency(config);
+        check_throughput(config);
+        check_system_resources(config);
+        check_business_metrics(config);
+        check_risk_metrics();
+        cleanup_alerts(config);
+        record_sample(config);
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - last_hourly >= std::chrono::hours(1)) {
+            generate_hourly_report();
+            last_hourly = now;
+        }
+        if (now - last_daily >= std::chrono::hours(24)) {
+            generate_daily_report();
+            last_daily = now;
+        }
+
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_.wait_for(lock, config.evaluation_interval, [this]() { return !running_; });
+    }
+}
+
+void PerformanceMonitor::check_latency(const SloConfig& config) {
+    // Cumulative snapshots; these only take the collector's read-side lock
+    LatencySnapshot snapshot;
+    snapshot.time = std::chrono::steady_clock::now();
+    snapshot.tick_to_signal =
+        metrics_->get_latency_histogram(std::string(metrics::name(metrics::Timer::TICK_TO_SIGNAL)));
+    snapshot.detection = metrics_->get_detection_histogram();
+
+    // A collector reset makes the totals go backwards; restart the window
+    if (!latency_window_.empty() &&
+        (snapshot.tick_to_signal.count() < latency_window_.back().tick_to_signal.count() ||
+         snapshot.detection.count() < latency_window_.back().detection.count())) {
+        latency_window_.clear();
+    }
+
+    latency_window_.push_back(std::move(snapshot));
+    while (latency_window_.size() > 2 &&
+           latency_window_[1].time <= latency_window_.back().time - config.window) {
+        latency_window_.pop_front();
+    }
+
+    if (latency_window_.size() < 2) return;
+
+    HdrHistogram tick_to_signal = latency_window_.back().tick_to_signal;
+    tick_to_signal.subtract(latency_window_.front().tick_to_signal);
+    HdrHistogram detection = latency_window_.back().detection;
+    detection.subtract(latency_window_.front().detection);
+
+    auto evaluate = [&](const HdrHistogram& window, const std::string& slo,
+                        const char* label, double threshold_us, double& p99_us) {
+        if (window.count() < config.min_latency_samples) return;
+
+        p99_us = window.percentile(0.99) / 1000.0;
+        if (threshold_us <= 0.0) return;
+
+        if (p99_us > threshold_us) {
+            generate_alert(PerformanceAlert::HIGH_LATENCY, slo,
+                           std::string(label) + " p99 " + format_double("%.0f", p99_us) +
+                               "us over " + std::to_string(config.window.count()) +
+                               "s exceeds SLO " + format_double("%.0f", threshold_us) + "us (" +
+                               std::to_string(window.count()) + " samples)",
+                           overshoot(p99_us, threshold_us), p99_us, threshold_us);
+        } else {
+            resolve_alert(PerformanceAlert::HIGH_LATENCY, slo);
+        }
+    };
+
+    evaluate(tick_to_signal, TICK_TO_SIGNAL_SLO, "Tick-to-signal",
+             config.tick_to_signal_p99_us, current_.tick_to_signal_p99_us);
+    evaluate(detection, DETECTION_SLO, "Detection cycle",
+             config.detection_p99_us, current_.detection_p99_us);
+}
+
+void PerformanceMonitor::check_throughput(const SloConfig& config) {
+    // Exchange counters are plain atomics - no market data locks involved
+    auto stats = market_data_->get_statistics();
+    auto& registry = MetricRegistry::instance();
+
+    CounterSnapshot snapshot;
+    snapshot.time = std::chrono::steady_clock::now();
+    snapshot.messages_by_exchange = std::move(stats.updates_by_exchange);
+    snapshot.opportunities_detected =
+        registry.read_counter(metrics::id(metrics::Counter::OPPORTUNITIES_DETECTED));
+    snapshot.opportunities_executed =
+        registry.read_counter(metrics::id(metrics::Counter::OPPORTUNITIES_EXECUTED));
+
+    counter_window_.push_back(std::move(snapshot));
+    while (counter_window_.size() > 2 &&
+           counter_window_[1].time <= counter_window_.back().time - config.window) {
+        counter_window_.pop_front();
+    }
+
+    if (counter_window_.size() < 2) return;
+
+    const auto& oldest = counter_window_.front();
+    const auto& newest = counter_window_.back();
+    double seconds = std::chrono::duration<double>(newest.time - oldest.time).count();
+
+    std::unordered_map<Exchange, double> rates;
+    double total_rate = 0.0;
+    for (const auto& [exchange, count] : newest.messages_by_exchange) {
+        auto previous = oldest.messages_by_exchange.find(exchange);
+        uint64_t base = previous != oldest.messages_by_exchange.end() ? previous->second : 0;
+        double rate = count >= base ? (count - base) / seconds : 0.0;
+        rates[exchange] = rate;
+        total_rate += rate;
+    }
+    current_.messages_per_second = total_rate;
+
+    {
+        std::lock_guard<std::mutex> lock(samples_mutex_);
+        venue_rates_ = rates;
+    }
+
+    // Floors are only judged over a full window, so startup and reconnects settle first
+    if (seconds < std::chrono::duration<double>(config.window).count()) return;
+
+    for (const auto& [exchange, floor] : config.min_messages_per_second) {
+        if (floor <= 0.0) continue;
+
+        std::string venue = utils::exchange_to_string(exchange);
+        auto found = rates.find(exchange);
+        double rate = found != rates.end() ? found->second : 0.0;
+
+        if (rate < floor) {
+            generate_alert(PerformanceAlert::LOW_THROUGHPUT, venue,
+                           venue + " message rate " + format_double("%.1f", rate) + "/s over " +
+                               std::to_string(config.window.count()) + "s below floor " +
+                               format_double("%.1f", floor) + "/s",
+                           overshoot(rate, floor), rate, floor);
+        } else {
+            resolve_alert(PerformanceAlert::LOW_THROUGHPUT, venue);
+        }
+    }
+}
+
+void PerformanceMonitor::check_system_resources(const SloConfig& config) {
+    // Refreshed by the metrics thread once a second; no collector locks
+    current_.cpu_percent = metrics_->cpu_usage_percent();
+    current_.memory_mb = metrics_->memory_usage_mb();
+
+    if (config.max_cpu_percent > 0.0) {
+        if (current_.cpu_percent > config.max_cpu_percent) {
+            generate_alert(PerformanceAlert::HIGH_CPU, "process",
+                           "Process CPU " + format_double("%.1f", current_.cpu_percent) +
+                               "% above " + format_double("%.1f", config.max_cpu_percent) + "%",
+                           overshoot(current_.cpu_percent, config.max_cpu_percent),
+                           current_.cpu_percent, config.max_cpu_percent);
+        } else {
+            resolve_alert(PerformanceAlert::HIGH_CPU, "process");
+        }
+    }
+
+    if (config.max_memory_mb > 0) {
+        double memory = static_cast<double>(current_.memory_mb);
+        double limit = static_cast<double>(config.max_memory_mb);
+        if (memory > limit) {
+            generate_alert(PerformanceAlert::HIGH_MEMORY, "process",
+                           "Resident memory " + std::to_string(current_.memory_mb) + " MB above " +
+                               std::to_string(config.max_memory_mb) + " MB",
+                           overshoot(memory, limit), memory, limit);
+        } else {
+            resolve_alert(PerformanceAlert::HIGH_MEMORY, "process");
+        }
+    }
+}
+
+void PerformanceMonitor::check_business_metrics(const SloConfig& config) {
+    // Reads the counter window filled by check_throughput; the detector's own
+    // statistics sit behind its opportunities lock, so they are not used here
+    if (counter_window_.size() < 2) return;
+
+    const auto& oldest = counter_window_.front();
+    const auto& newest = counter_window_.back();
+    if (newest.opportunities_detected < oldest.opportunities_detected ||
+        newest.opportunities_executed < oldest.opportunities_executed) {
+        return;
+    }
+
+    uint64_t detected = newest.opportunities_detected - oldest.opportunities_detected;
+    uint64_t executed = newest.opportunities_executed - oldest.opportunities_executed;
+    if (detected < MIN_HIT_RATE_DETECTIONS) return;
+
+    current_.hit_rate = static_cast<double>(executed) / static_cast<double>(detected);
+    if (config.min_hit_rate <= 0.0) return;
+
+    if (current_.hit_rate < config.min_hit_rate) {
+        generate_alert(PerformanceAlert::LOW_HIT_RATE, "opportunities",
+                       "Executed " + std::to_string(executed) + " of " + std::to_string(detected) +
+                           " opportunities (" + format_double("%.1f", current_.hit_rate * 100) +
+                           "%) below " + format_double("%.1f", config.min_hit_rate * 100) + "%",
+                       overshoot(current_.hit_rate, config.min_hit_rate),
+                       current_.hit_rate, config.min_hit_rate);
+    } else {
+        resolve_alert(PerformanceAlert::LOW_HIT_RATE, "opportunities");
+    }
+}
+
+void PerformanceMonitor::check_risk_metrics() {
+    if (!risk_manager_) return;
+
+    // Only the risk manager's alert lock, which the risk check itself never holds
+    auto risk_alerts = risk_manager_->get_active_alerts();
+
+    std::unordered_map<std::string, const RiskManager::Alert*> worst;
+    for (const auto& alert : risk_alerts) {
+        const char* source = risk_alert_to_string(alert.type);
+        auto& entry = worst[source];
+        if (!entry || alert.severity > entry->severity) {
+            entry = &alert;
+        }
+    }
+
+    for (const auto& [source, alert] : worst) {
+        generate_alert(PerformanceAlert::RISK_LIMIT_BREACH, source, alert->message,
+                       std::clamp(alert->severity, 0.0, 1.0), alert->severity, 0.0);
+    }
+
+    // Risk conditions the risk manager no longer reports are resolved
+    std::vector<std::string> cleared;
+    {
+        std::lock_guard<std::mutex> lock(alerts_mutex_);
+        for (const auto& alert : active_alerts_) {
+            if (alert.type == PerformanceAlert::RISK_LIMIT_BREACH && !worst.count(alert.source)) {
+                cleared.push_back(alert.source);
+            }
+        }
+    }
+    for (const auto& source : cleared) {
+        resolve_alert(PerformanceAlert::RISK_LIMIT_BREACH, source);
+    }
+}
+
+void PerformanceMonitor::generate_alert(PerformanceAlert::AlertType type,
+                                       const std::string& source,
+                                       const std::string& message,
+                                       double severity,
+                                       double observed,
+                                       double threshold) {
+    Timestamp now = Clock::now();
+    PerformanceAlert raised;
+    std::vector<AlertCallback> callbacks;
+
+    {
+        std::lock_guard<std::mutex> lock(alerts_mutex_);
+
+        auto existing = std::find_if(active_alerts_.begin(), active_alerts_.end(),
+            [&](const PerformanceAlert& alert) {
+                return alert.type == type && alert.source == source;
+            });
+
+        // Still in breach - refresh without re-notifying
+        if (existing != active_alerts_.end()) {
+            existing->message = message;
+            existing->severity = severity;
+            existing->observed = observed;
+            existing->threshold = threshold;
+            existing->last_seen = now;
+            return;
+        }
+
+        raised.type = type;
+        raised.message = message;
+        raised.severity = severity;
+        raised.timestamp = now;
+        raised.source = source;
+        raised.observed = observed;
+        raised.threshold = threshold;
+        raised.last_seen = now;
+
+        active_alerts_.push_back(raised);
+        callbacks = alert_callbacks_;
+    }
+
+    LOG_WARN("Performance alert [{}] {} (severity {:.2f})",
+             alert_type_to_string(type), message, severity);
+
+    for (const auto& callback : callbacks) {
+        try {
+            callback(raised);
+        } catch (const std::exception& e) {
+            LOG_ERROR("Alert callback error: {}", e.what());
+        }
+    }
+}
+
+void PerformanceMonitor::resolve_alert(PerformanceAlert::AlertType type, const std::string& source) {
+    std::lock_guard<std::mutex> lock(alerts_mutex_);
+
+    auto existing = std::find_if(active_alerts_.begin(), active_alerts_.end(),
+        [&](const PerformanceAlert& alert) {
+            return alert.type == type && alert.source == source;
+        });
+    if (existing == active_alerts_.end()) return;
+
+    existing->resolved_at = Clock::now();
+    LOG_INFO("Performance alert resolved [{}] {}", alert_type_to_string(type), source);
+
+    alert_history_.push_back(std::move(*existing));
+    active_alerts_.erase(existing);
+
+    if (alert_history_.size() > MAX_ALERT_HISTORY) {
+        alert_history_.pop_front();
+    }
+}
+
+void PerformanceMonitor::cleanup_alerts(const SloConfig& config) {
+    Timestamp now = Clock::now();
+    // An alert not re-evaluated for a few rounds lost its input (venue removed, SLO disabled)
+    Timestamp stale_after = std::chrono::duration_cast<Timestamp>(config.evaluation_interval * 3);
+    Timestamp retention = std::chrono::duration_cast<Timestamp>(config.alert_retention);
+
+    std::lock_guard<std::mutex> lock(alerts_mutex_);
+
+    for (auto it = active_alerts_.begin(); it != active_alerts_.end();) {
+        if (now - it->last_seen > stale_after) {
+            it->resolved_at = now;
+            alert_history_.push_back(std::move(*it));
+            it = active_alerts_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    while (!alert_history_.empty() && now - alert_history_.front().resolved_at > retention) {
+        alert_history_.pop_front();
+    }
+}
+
+void PerformanceMonitor::record_sample(const SloConfig& config) {
+    {
+        std::lock_guard<std::mutex> lock(alerts_mutex_);
+        current_.active_alerts = active_alerts_.size();
+    }
+
+    size_t max_samples = static_cast<size_t>(
+        std::chrono::duration_cast<std::chrono::seconds>(SAMPLE_HISTORY).count() /
+        config.evaluation_interval.count());
+
+    std::lock_guard<std::mutex> lock(samples_mutex_);
+    samples_.push_back(current_);
+    while (samples_.size() > max_samples) {
+        samples_.pop_front();
+    }
+}
+
+std::vector<PerformanceMonitor::PerformanceAlert> PerformanceMonitor::get_active_alerts() const {
+    std::lock_guard<std::mutex> lock(alerts_mutex_);
+    return active_alerts_;
+}
+
+std::vector<PerformanceMonitor::PerformanceAlert> PerformanceMonitor::get_alert_history() const {
+    std::lock_guard<std::mutex> lock(alerts_mutex_);
+    return std::vector<PerformanceAlert>(alert_history_.begin(), alert_history_.end());
+}
+
+std::vector<PerformanceMonitor::EvaluationSample> PerformanceMonitor::get_samples(
+    std::chrono::seconds period) const {
+    Timestamp since = Clock::now() - std::chrono::duration_cast<Timestamp>(period);
+
+    std::lock_guard<std::mutex> lock(samples_mutex_);
+
+    std::vector<EvaluationSample> result;
+    for (const auto& sample : samples_) {
+        if (sample.timestamp >= since) {
+            result.push_back(sample);
+        }
+    }
+    return result;
+}
+
+void PerformanceMonitor::generate_hourly_report() const {
+    log_report("Hourly", std::chrono::hours(1));
+}
+
+void PerformanceMonitor::generate_daily_report() const {
+    log_report("Daily", std::chrono::hours(24));
+}
+
+void PerformanceMonitor::log_report(const char* title, std::chrono::seconds period) const {
+    auto samples = get_samples(period);
+    if (samples.empty()) {
+        LOG_INFO("=== {} Performance Report: no samples ===", title);
+        return;
+    }
+
+    auto config = get_slo_config();
+
+    double worst_tick_to_signal = 0.0;
+    double worst_detection = 0.0;
+    double total_rate = 0.0;
+    double total_cpu = 0.0;
+    double peak_cpu = 0.0;
+    uint64_t peak_memory = 0;
+    size_t latency_breaches = 0;
+
+    for (const auto& sample : samples) {
+        worst_tick_to_signal = std::max(worst_tick_to_signal, sample.tick_to_signal_p99_us);
+        worst_detection = std::max(worst_detection, sample.detection_p99_us);
+        total_rate += sample.messages_per_second;
+        total_cpu += sample.cpu_percent;
+        peak_cpu = std::max(peak_cpu, sample.cpu_percent);
+        peak_memory = std::max(peak_memory, sample.memory_mb);
+
+        if (config.tick_to_signal_p99_us > 0.0 &&
+            sample.tick_to_signal_p99_us > config.tick_to_signal_p99_us) {
+            latency_breaches++;
+        }
+    }
+
+    Timestamp since = Clock::now() - std::chrono::duration_cast<Timestamp>(period);
+    size_t alerts_raised = 0;
+    {
+        std::lock_guard<std::mutex> lock(alerts_mutex_);
+        for (const auto& alert : active_alerts_) {
+            if (alert.timestamp >= since) alerts_raised++;
+        }
+        for (const auto& alert : alert_history_) {
+            if (alert.timestamp >= since) alerts_raised++;
+        }
+    }
+
+    double count = static_cast<double>(samples.size());
+
+    LOG_INFO("=== {} Performance Report ({} evaluations) ===", title, samples.size());
+    LOG_INFO("Worst tick-to-signal p99: {:.0f}us (SLO {:.0f}us, breached in {:.1f}% of windows)",
+             worst_tick_to_signal, config.tick_to_signal_p99_us, latency_breaches * 100.0 / count);
+    LOG_INFO("Worst detection p99: {:.0f}us (SLO {:.0f}us)", worst_detection, config.detection_p99_us);
+    LOG_INFO("Average message rate: {:.1f}/s", total_rate / count);
+    LOG_INFO("CPU: avg {:.1f}%, peak {:.1f}%", total_cpu / count, peak_cpu);
+    LOG_INFO("Peak memory: {} MB", peak_memory);
+    LOG_INFO("Alerts raised: {}", alerts_raised);
+}
+
+void PerformanceMonitor::export_to_csv(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        LOG_ERROR("Failed to open {} for performance export", filename);
+        return;
+    }
+
+    file << "timestamp,tick_to_signal_p99_us,detection_p99_us,messages_per_second,"
+            "cpu_percent,memory_mb,hit_rate,active_alerts\n";
+
+    std::lock_guard<std::mutex> lock(samples_mutex_);
+    for (const auto& sample : samples_) {
+        file << utils::timestamp_to_string(sample.timestamp) << ','
+             << sample.tick_to_signal_p99_us << ','
+             << sample.detection_p99_us << ','
+             << sample.messages_per_second << ','
+             << sample.cpu_percent << ','
+             << sample.memory_mb << ','
+             << sample.hit_rate << ','
+             << sample.active_alerts << '\n';
+    }
+}
+
+void PerformanceMonitor::export_to_json(const std::string& filename) const {
+    auto config = get_slo_config();
+
+    rapidjson::Document doc;
+    doc.SetObject();
+    auto& allocator = doc.GetAllocator();
+
+    rapidjson::Value slo(rapidjson::kObjectType);
+    slo.AddMember("tick_to_signal_p99_us", config.tick_to_signal_p99_us, allocator);
+    slo.AddMember("detection_p99_us", config.detection_p99_us, allocator);
+    slo.AddMember("max_cpu_percent", config.max_cpu_percent, allocator);
+    slo.AddMember("max_memory_mb", config.max_memory_mb, allocator);
+    slo.AddMember("min_hit_rate", config.min_hit_rate, allocator);
+    slo.AddMember("window_seconds", static_cast<int64_t>(config.window.count()), allocator);
+
+    rapidjson::Value floors(rapidjson::kObjectType);
+    for (const auto& [exchange, floor] : config.min_messages_per_second) {
+        floors.AddMember(rapidjson::Value(utils::exchange_to_string(exchange).c_str(), allocator),
+                         floor, allocator);
+    }
+    slo.AddMember("min_messages_per_second", floors, allocator);
+
+    rapidjson::Value samples(rapidjson::kArrayType);
+    {
+        std::lock_guard<std::mutex> lock(samples_mutex_);
+        for (const auto& sample : samples_) {
+            rapidjson::Value entry(rapidjson::kObjectType);
+            entry.AddMember("timestamp_ns", static_cast<int64_t>(sample.timestamp.count()), allocator);
+            entry.AddMember("tick_to_signal_p99_us", sample.tick_to_signal_p99_us, allocator);
+            entry.AddMember("detection_p99_us", sample.detection_p99_us, allocator);
+            entry.AddMember("messages_per_second", sample.messages_per_second, allocator);
+            entry.AddMember("cpu_percent", sample.cpu_percent, allocator);
+            entry.AddMember("memory_mb", sample.memory_mb, allocator);
+            entry.AddMember("hit_rate", sample.hit_rate, allocator);
+            entry.AddMember("active_alerts", static_cast<uint64_t>(sample.active_alerts), allocator);
+            samples.PushBack(entry, allocator);
+        }
+    }
+
+    auto add_alerts = [&](const std::vector<PerformanceAlert>& alerts, const char* name) {
+        rapidjson::Value list(rapidjson::kArrayType);
+        for (const auto& alert : alerts) {
+            rapidjson::Value entry(rapidjson::kObjectType);
+            entry.AddMember("type", rapidjson::StringRef(alert_type_to_string(alert.type)), allocator);
+            entry.AddMember("source", rapidjson::Value(alert.source.c_str(), allocator), allocator);
+            entry.AddMember("message", rapidjson::Value(alert.message.c_str(), allocator), allocator);
+            entry.AddMember("severity", alert.severity, allocator);
+            entry.AddMember("observed", alert.observed, allocator);
+            entry.AddMember("threshold", alert.threshold, allocator);
+            entry.AddMember("raised_ns", static_cast<int64_t>(alert.timestamp.count()), allocator);
+            entry.AddMember("resolved_ns", static_cast<int64_t>(alert.resolved_at.count()), allocator);
+            list.PushBack(entry, allocator);
+        }
+        doc.AddMember(rapidjson::StringRef(name), list, allocator);
+    };
+
+    doc.AddMember("slo", slo, allocator);
+    doc.AddMember("samples", samples, allocator);
+    add_alerts(get_active_alerts(), "active_alerts");
+    add_alerts(get_alert_history(), "alert_history");
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    doc.Accept(writer);
+
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        LOG_ERROR("Failed to open {} for performance export", filename);
+        return;
+    }
+    file << buffer.GetString();
+}
+
+void PerformanceMonitor::print_dashboard() const {
+    auto config = get_slo_config();
+    auto alerts = get_active_alerts();
+
+    EvaluationSample latest{};
+    std::unordered_map<Exchange, double> rates;
+    {
+        std::lock_guard<std::mutex> lock(samples_mutex_);
+        if (!samples_.empty()) latest = samples_.back();
+        rates = venue_rates_;
+    }
+
+    ConsoleDashboard::clear_screen();
+
+    // Latency against the SLOs; the bar shows how much of the budget is used
+    ConsoleDashboard::draw_box(1, 1, 60, 6, "Latency (p99, sliding window)");
+    ConsoleDashboard::draw_metric(2, 3, "Tick-to-signal",
+        format_double("%.0f us", latest.tick_to_signal_p99_us) +
+        format_double(" / %.0f us", config.tick_to_signal_p99_us));
+    ConsoleDashboard::draw_progress_bar(3, 3, 54, config.tick_to_signal_p99_us > 0.0
+        ? latest.tick_to_signal_p99_us * 100.0 / config.tick_to_signal_p99_us : 0.0);
+    ConsoleDashboard::draw_metric(4, 3, "Detection cycle",
+        format_double("%.0f us", latest.detection_p99_us) +
+        format_double(" / %.0f us", config.detection_p99_us));
+    ConsoleDashboard::draw_progress_bar(5, 3, 54, config.detection_p99_us > 0.0
+        ? latest.detection_p99_us * 100.0 / config.detection_p99_us : 0.0);
+
+    // Per-venue message rates
+    int throughput_height = static_cast<int>(rates.size()) + 3;
+    ConsoleDashboard::draw_box(8, 1, 60, throughput_height, "Throughput");
+    int row = 9;
+    ConsoleDashboard::draw_metric(row++, 3, "All venues",
+                                  format_double("%.1f msg/s", latest.messages_per_second));
+    for (const auto& [exchange, rate] : rates) {
+        auto floor = config.min_messages_per_second.find(exchange);
+        bool below = floor != config.min_messages_per_second.end() && rate < floor->second;
+        if (below) ConsoleDashboard::set_color(ConsoleDashboard::RED);
+        ConsoleDashboard::draw_metric(row++, 3, utils::exchange_to_string(exchange),
+                                      format_double("%.1f msg/s", rate));
+        if (below) ConsoleDashboard::reset_color();
+    }
+
+    // System resources
+    row = 8 + throughput_height + 1;
+    ConsoleDashboard::draw_box(row, 1, 60, 6, "System");
+    ConsoleDashboard::draw_metric(row + 1, 3, "CPU", format_double("%.1f%%", latest.cpu_percent));
+    ConsoleDashboard::draw_progress_bar(row + 2, 3, 54, latest.cpu_percent);
+    ConsoleDashboard::draw_metric(row + 3, 3, "Memory", std::to_string(latest.memory_mb) + " MB");
+    ConsoleDashboard::draw_progress_bar(row + 4, 3, 54, config.max_memory_mb > 0
+        ? latest.memory_mb * 100.0 / config.max_memory_mb : 0.0);
+
+    // Active alerts
+    row += 7;
+    int alerts_height = static_cast<int>(std::max<size_t>(alerts.size(), 1)) + 2;
+    ConsoleDashboard::draw_box(row, 1, 60, alerts_height, "Active alerts");
+    if (alerts.empty()) {
+        ConsoleDashboard::set_color(ConsoleDashboard::GREEN);
+        ConsoleDashboard::move_cursor(row + 1, 3);
+        std::cout << "All SLOs met";
+        ConsoleDashboard::reset_color();
+    }
+    for (size_t i = 0; i < alerts.size(); ++i) {
+        ConsoleDashboard::set_color(alerts[i].severity >= 0.5 ? ConsoleDashboard::RED
+                                                              : ConsoleDashboard::YELLOW);
+        ConsoleDashboard::move_cursor(row + 1 + static_cast<int>(i), 3);
+        std::cout << std::string(alert_type_to_string(alerts[i].type)).substr(0, 18) << ' '
+                  << alerts[i].message.substr(0, 36);
+        ConsoleDashboard::reset_color();
+    }
+
+    ConsoleDashboard::move_cursor(row + alerts_height + 1, 1);
+    std::cout << std::flush;
+}
+
+void ConsoleDashboard::clear_screen() {
+    std::cout << "\033[2J\033[H";
+}
+
+void ConsoleDashboard::move_cursor(int row, int col) {
+    std::cout << "\033[" << row << ';' << col << 'H';
+}
+
+void ConsoleDashboard::set_color(int color) {
+    std::cout << "\033[" << color << 'm';
+}
+
+void ConsoleDashboard::reset_color() {
+    std::cout << "\033[0m";
+}
+
+void ConsoleDashboard::draw_box(int row, int col, int width, int height, const std::string& title) {
+    std::string horizontal(static_cast<size_t>(std::max(width - 2, 0)), '-');
+
+    move_cursor(row, col);
+    std::cout << '+' << horizontal << '+';
+
+    if (!title.empty() && width > 6) {
+        move_cursor(row, col + 2);
+        set_color(CYAN);
+        std::cout << ' ' << title.substr(0, static_cast<size_t>(width - 6)) << ' ';
+        reset_color();
+    }
+
+    for (int i = 1; i < height - 1; ++i) {
+        move_cursor(row + i, col);
+        std::cout << '|';
+        move_cursor(row + i, col + width - 1);
+        std::cout << '|';
+    }
+
+    move_cursor(row + height - 1, col);
+    std::cout << '+' << horizontal << '+';
+}
+
+void ConsoleDashboard::draw_progress_bar(int row, int col, int width, double percentage) {
+    int inner = std::max(width - 9, 1);     // Room for brackets and " 100.0%"
+    double clamped = std::clamp(percentage, 0.0, 100.0);
+    int filled = static_cast<int>(inner * clamped / 100.0);
+
+    move_cursor(row, col);
+    set_color(percentage >= 100.0 ? RED : percentage >= 80.0 ? YELLOW : GREEN);
+    std::cout << '[' << std::string(static_cast<size_t>(filled), '#')
+              << std::string(static_cast<size_t>(inner - filled), ' ') << ']';
+    reset_color();
+    std::cout << format_double(" %5.1f%%", percentage);
+}
+
+void ConsoleDashboard::draw_metric(int row, int col, const std::string& label, const std::string& value) {
+    move_cursor(row, col);
+    std::cout << label << ": ";
+    set_color(WHITE);
+    std::cout << value;
+    reset_color();
+}
+
+} // namespace arbitrage
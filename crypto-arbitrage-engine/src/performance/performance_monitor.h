@@ -1,9 +1,16 @@
 #pragma once
 
 #include "core/types.h"
+#include "hdr_histogram.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <atomic>
+#include <unordered_map>
 
 namespace arbitrage {
 
@@ -13,6 +20,12 @@ class MarketDataManager;
 class ArbitrageDetector;
 class RiskManager;
 
+// Evaluates latency / throughput SLOs over sliding windows and raises alerts.
+//
+// Runs on its own low-priority thread and only reads snapshots: cumulative
+// histograms from MetricsCollector, exchange message counters and the risk
+// manager's alert list. It never takes a lock on the market data, detection
+// or risk-check paths.
 class PerformanceMonitor {
 public:
     PerformanceMonitor(MetricsCollector* metrics,
@@ -21,6 +34,23 @@ public:
                       RiskManager* risk_manager);
     ~PerformanceMonitor();
     
+    // Service level objectives; a zero threshold disables that check
+    struct SloConfig {
+        double tick_to_signal_p99_us = 10000.0;     // Newest tick -> opportunity emitted
+        double detection_p99_us = 5000.0;           // One detection cycle
+        uint64_t min_latency_samples = 50;          // Below this a window's p99 is not judged
+        std::unordered_map<Exchange, double> min_messages_per_second;
+        double max_cpu_percent = 80.0;
+        uint64_t max_memory_mb = 1500;
+        double min_hit_rate = 0.0;                  // Executed / detected opportunities
+        std::chrono::seconds window{60};
+        std::chrono::seconds evaluation_interval{5};
+        std::chrono::seconds alert_retention{3600};
+    };
+    
+    void set_slo_config(const SloConfig& config);
+    SloConfig get_slo_config() const;
+    
     // Start/stop monitoring
     void start();
     void stop();
@@ -41,11 +71,23 @@ public:
         
         AlertType type;
         std::string message;
-        double severity;
-        Timestamp timestamp;
+        double severity;            // 0-1
+        Timestamp timestamp;        // First breach
+        
+        std::string source;         // SLO or venue the alert is about
+        double observed = 0.0;
+        double threshold = 0.0;
+        Timestamp last_seen{};      // Most recent evaluation still in breach
+        Timestamp resolved_at{};    // Zero while active
     };
     
+    using AlertCallback = std::function<void(const PerformanceAlert&)>;
+    
+    // Called on the monitor thread when an alert is first raised
+    void register_alert_callback(AlertCallback callback);
+    
     std::vector<PerformanceAlert> get_active_alerts() const;
+    std::vector<PerformanceAlert> get_alert_history() const;
     
     // Performance reports
     void generate_hourly_report() const;
@@ -55,42 +97,103 @@ public:
     void export_to_csv(const std::string& filename) const;
     void export_to_json(const std::string& filename) const;
     
+    // One evaluation of every SLO input
+    struct EvaluationSample {
+        Timestamp timestamp;
+        double tick_to_signal_p99_us;
+        double detection_p99_us;
+        double messages_per_second;     // All venues, over the window
+        double cpu_percent;
+        uint64_t memory_mb;
+        double hit_rate;
+        size_t active_alerts;
+    };
+    
+    std::vector<EvaluationSample> get_samples(std::chrono::seconds period) const;
+
 private:
     MetricsCollector* metrics_;
     MarketDataManager* market_data_;
     ArbitrageDetector* arbitrage_detector_;
     RiskManager* risk_manager_;
     
+    SloConfig config_;
+    mutable std::mutex config_mutex_;
+    
     // Monitoring thread
     std::unique_ptr<std::thread> monitor_thread_;
     std::atomic<bool> running_{false};
+    std::condition_variable wake_;
+    std::mutex wake_mutex_;
     
     // Alert tracking
     std::vector<PerformanceAlert> active_alerts_;
+    std::deque<PerformanceAlert> alert_history_;    // Resolved alerts, oldest first
+    std::vector<AlertCallback> alert_callbacks_;
     mutable std::mutex alerts_mutex_;
     
+    // Sliding windows, monitor thread only. The window is the difference
+    // between the newest snapshot and the oldest one still inside it.
+    struct LatencySnapshot {
+        std::chrono::steady_clock::time_point time;
+        HdrHistogram tick_to_signal;
+        HdrHistogram detection;
+    };
+    
+    struct CounterSnapshot {
+        std::chrono::steady_clock::time_point time;
+        std::unordered_map<Exchange, uint64_t> messages_by_exchange;
+        uint64_t opportunities_detected;
+        uint64_t opportunities_executed;
+    };
+    
+    std::deque<LatencySnapshot> latency_window_;
+    std::deque<CounterSnapshot> counter_window_;
+    EvaluationSample current_{};
+    
+    // Evaluation history for dashboards, reports and export
+    std::deque<EvaluationSample> samples_;
+    std::unordered_map<Exchange, double> venue_rates_;
+    mutable std::mutex samples_mutex_;
+    
     // Monitoring loop
     void monitor_loop();
     
     // Check various performance aspects
-    void check_latency();
-    void check_throughput();
-    void check_system_resources();
-    void check_business_metrics();
+    void check_latency(const SloConfig& config);
+    void check_throughput(const SloConfig& config);
+    void check_system_resources(const SloConfig& config);
+    void check_business_metrics(const SloConfig& config);
     void check_risk_metrics();
     
-    // Generate alert
-    void generate_alert(PerformanceAlert::AlertType type, 
+    // Raise or refresh the alert for (type, source)
+    void generate_alert(PerformanceAlert::AlertType type,
+                       const std::string& source,
                        const std::string& message,
-                       double severity);
+                       double severity,
+                       double observed,
+                       double threshold);
+    void resolve_alert(PerformanceAlert::AlertType type, const std::string& source);
     
     // Clear old alerts
-    void cleanup_alerts();
+    void cleanup_alerts(const SloConfig& config);
+    
+    void record_sample(const SloConfig& config);
+    void log_report(const char* title, std::chrono::seconds period) const;
 };
 
 // Console dashboard for real-time monitoring
 class ConsoleDashboard {
 public:
+    // ANSI foreground colours for set_color()
+    enum Color {
+        RED = 31,
+        GREEN = 32,
+        YELLOW = 33,
+        CYAN = 36,
+        WHITE = 37
+    };
+    
     static void clear_screen();
     static void move_cursor(int row, int col);
     static void set_color(int color);
@@ -101,4 +204,6 @@ public:
     static void draw_metric(int row, int col, const std::string& label, const std::string& value);
 };
 
-} // namespace arbitrage
\ No newline at end of file
+const char* alert_type_to_string(PerformanceMonitor::PerformanceAlert::AlertType type);
+
+} // namespace arbitrage
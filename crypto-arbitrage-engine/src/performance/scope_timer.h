@@ -0,0 +1,68 @@
+#pragma once
+
+#include "metric_ids.h"
+#include "utils/tsc_clock.h"
+
+namespace arbitrage {
+
+// Times the enclosing scope into a built-in latency histogram. The metric
+// id is a template argument, so the destructor is two rdtscp reads, a
+// multiply and a thread-local bucket increment.
+template <metrics::Timer TIMER>
+class ScopeTimer {
+public:
+    ScopeTimer() : start_(TscClock::now()) {}
+
+    ~ScopeTimer() {
+        uint64_t end = TscClock::now();
+        // Guard against a migration onto a core whose TSC reads marginally behind
+        uint64_t ticks = end > start_ ? end - start_ : 0;
+        MetricRegistry::record(metrics::id(TIMER), TscClock::to_nanoseconds(ticks));
+    }
+
+    ScopeTimer(const ScopeTimer&) = delete;
+    ScopeTimer& operator=(const ScopeTimer&) = delete;
+
+private:
+    uint64_t start_;
+};
+
+// RAII timer for histograms registered at runtime (MetricsCollector::register_operation,
+// labelled per-exchange series). Same cost as ScopeTimer plus one id load.
+class MetricTimer {
+public:
+    explicit MetricTimer(MetricId operation)
+        : operation_(operation)
+        , start_(TscClock::now()) {}
+
+    ~MetricTimer() {
+        uint64_t end = TscClock::now();
+        uint64_t ticks = end > start_ ? end - start_ : 0;
+        MetricRegistry::record(operation_, TscClock::to_nanoseconds(ticks));
+    }
+
+    MetricTimer(const MetricTimer&) = delete;
+    MetricTimer& operator=(const MetricTimer&) = delete;
+
+private:
+    MetricId operation_;
+    uint64_t start_;
+};
+
+} // namespace arbitrage
+
+#define ARB_CONCAT_IMPL(a, b) a##b
+#define ARB_CONCAT(a, b) ARB_CONCAT_IMPL(a, b)
+
+// ARB_TIME_SCOPE(DETECT_SPOT) times the rest of the enclosing block;
+// ARB_TIME_SCOPE_ID(id) does the same for a runtime-registered histogram.
+// Compiled out entirely unless built with ENABLE_INSTRUMENTATION.
+#ifdef ARB_ENABLE_INSTRUMENTATION
+#define ARB_TIME_SCOPE(timer) \
+    ::arbitrage::ScopeTimer<::arbitrage::metrics::Timer::timer> ARB_CONCAT(arb_scope_timer_, __LINE__)
+#define ARB_TIME_SCOPE_ID(id) \
+    ::arbitrage::MetricTimer ARB_CONCAT(arb_scope_timer_, __LINE__)(id)
+#else
+#define ARB_TIME_SCOPE(timer) static_cast<void>(0)
+#define ARB_TIME_SCOPE_ID(id) static_cast<void>(0)
+#endif
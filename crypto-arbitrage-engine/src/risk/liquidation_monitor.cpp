@@ -0,0 +1,313 @@
+#include "liquidation_monitor.h"
+#include "core/utils.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <limits>
+
+namespace arbitrage {
+
+// MarginModel implementation
+
+const MarginTier& MarginModel::tier_for(double notional) const {
+    for (const auto& tier : tiers) {
+        if (notional <= tier.max_notional) {
+            return tier;
+        }
+    }
+    return tiers.back();
+}
+
+double MarginModel::initial_margin(double notional, double leverage) const {
+    double max_leverage = tier_for(notional).max_leverage;
+    double effective_leverage = std::clamp(leverage, 1.0, max_leverage);
+    return notional / effective_leverage;
+}
+
+double MarginModel::maintenance_margin(double notional) const {
+    return notional * maintenance_margin_rate(notional);
+}
+
+Price MarginModel::liquidation_price(Side side, Price entry_price, Quantity quantity,
+                                     double leverage) const {
+    double notional = entry_price * quantity;
+    double max_leverage = tier_for(notional).max_leverage;
+    double effective_leverage = std::clamp(leverage, 1.0, max_leverage);
+    double mmr = maintenance_margin_rate(notional);
+
+    if (side == Side::BUY) {
+        return std::max(0.0, entry_price * (1.0 - 1.0 / effective_leverage + mmr));
+    }
+    return entry_price * (1.0 + 1.0 / effective_leverage - mmr);
+}
+
+// LiquidationMonitor implementation
+
+LiquidationMonitor::LiquidationMonitor()
+    : LiquidationMonitor(Config{}) {
+}
+
+LiquidationMonitor::LiquidationMonitor(const Config& config)
+    : config_(config) {
+    for (auto exchange : {Exchange::OKX, Exchange::BINANCE, Exchange::BYBIT}) {
+        margin_models_[exchange] = default_margin_model(exchange);
+    }
+}
+
+void LiquidationMonitor::set_config(const Config& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+}
+
+void LiquidationMonitor::set_margin_model(const MarginModel& model) {
+    if (model.tiers.empty()) {
+        LOG_WARN("Ignoring margin model for {} - no tiers defined",
+                utils::exchange_to_string(model.exchange));
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    MarginModel sorted = model;
+    std::sort(sorted.tiers.begin(), sorted.tiers.end(),
+             [](const MarginTier& a, const MarginTier& b) {
+                 return a.max_notional < b.max_notional;
+             });
+    margin_models_[model.exchange] = std::move(sorted);
+
+    // Liquidation prices depend on the schedule - refresh affected positions
+    for (auto& [key, tracked] : positions_) {
+        if (key.exchange == model.exchange) {
+            recompute_margin(tracked);
+            reindex(tracked);
+        }
+    }
+}
+
+void LiquidationMonitor::set_alert_callback(AlertCallback callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    alert_callback_ = std::move(callback);
+}
+
+void LiquidationMonitor::upsert_position(const PositionInfo& position) {
+    LiquidationStatus alert_status;
+    AlertLevel alert_level = AlertLevel::NONE;
+    AlertCallback callback;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        PositionKey key{position.symbol, position.exchange};
+        auto [it, inserted] = positions_.try_emplace(key);
+        auto& tracked = it->second;
+
+        if (inserted) {
+            tracked.index_it = index_.end();
+        }
+
+        auto& status = tracked.status;
+        status.symbol = position.symbol;
+        status.exchange = position.exchange;
+        status.side = position.side;
+        status.quantity = position.quantity;
+        status.entry_price = position.average_price;
+        status.leverage = position.leverage > 0.0
+            ? position.leverage
+            : margin_model(position.exchange).default_leverage;
+
+        // Until the first tick arrives, the position's own mark is the best estimate
+        if (inserted || status.mark_price <= 0.0) {
+            status.mark_price = position.current_price > 0.0
+                ? position.current_price
+                : position.average_price;
+        }
+
+        recompute_margin(tracked);
+        reindex(tracked);
+
+        // A new or resized position may already sit inside a threshold
+        alert_level = evaluate_alert(tracked);
+        if (alert_level != AlertLevel::NONE && alert_callback_) {
+            alert_status = tracked.status;
+            callback = alert_callback_;
+        }
+    }
+
+    // Invoke outside the lock so handlers may query the monitor
+    if (callback) {
+        callback(alert_status, alert_level);
+    }
+}
+
+void LiquidationMonitor::remove_position(const Symbol& symbol, Exchange exchange) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = positions_.find(PositionKey{symbol, exchange});
+    if (it == positions_.end()) return;
+
+    if (it->second.index_it != index_.end()) {
+        index_.erase(it->second.index_it);
+    }
+    positions_.erase(it);
+}
+
+void LiquidationMonitor::on_mark_price(const Symbol& symbol, Exchange exchange, Price mark_price) {
+    if (mark_price <= 0.0) return;
+
+    LiquidationStatus alert_status;
+    AlertLevel alert_level = AlertLevel::NONE;
+    AlertCallback callback;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = positions_.find(PositionKey{symbol, exchange});
+        if (it == positions_.end()) return;
+
+        auto& tracked = it->second;
+        tracked.status.mark_price = mark_price;
+        tracked.status.distance = calculate_distance(tracked.status.side, mark_price,
+                                                     tracked.status.liquidation_price);
+        reindex(tracked);
+
+        alert_level = evaluate_alert(tracked);
+        if (alert_level != AlertLevel::NONE && alert_callback_) {
+            alert_status = tracked.status;
+            callback = alert_callback_;
+        }
+    }
+
+    // Invoke outside the lock so handlers may query the monitor
+    if (callback) {
+        callback(alert_status, alert_level);
+    }
+}
+
+bool LiquidationMonitor::get_closest(LiquidationStatus& status) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (index_.empty()) return false;
+
+    status = index_.begin()->position->status;
+    return true;
+}
+
+std::vector<LiquidationMonitor::LiquidationStatus>
+LiquidationMonitor::get_positions_within(double max_distance) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<LiquidationStatus> result;
+    for (const auto& entry : index_) {
+        if (entry.distance > max_distance) break;
+        result.push_back(entry.position->status);
+    }
+
+    return result;
+}
+
+size_t LiquidationMonitor::tracked_positions() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return positions_.size();
+}
+
+const MarginModel& LiquidationMonitor::margin_model(Exchange exchange) {
+    auto it = margin_models_.find(exchange);
+    if (it == margin_models_.end()) {
+        it = margin_models_.emplace(exchange, default_margin_model(exchange)).first;
+    }
+    return it->second;
+}
+
+void LiquidationMonitor::recompute_margin(TrackedPosition& tracked) {
+    auto& status = tracked.status;
+    const auto& model = margin_model(status.exchange);
+
+    double notional = status.entry_price * status.quantity;
+    status.liquidation_price = model.liquidation_price(status.side, status.entry_price,
+                                                       status.quantity, status.leverage);
+    status.initial_margin = model.initial_margin(notional, status.leverage);
+    status.maintenance_margin = model.maintenance_margin(notional);
+    status.distance = calculate_distance(status.side, status.mark_price,
+                                         status.liquidation_price);
+}
+
+void LiquidationMonitor::reindex(TrackedPosition& tracked) {
+    if (tracked.index_it != index_.end()) {
+        // Skip the erase/insert when the ordering key did not move
+        if (tracked.index_it->distance == tracked.status.distance) return;
+        index_.erase(tracked.index_it);
+    }
+    tracked.index_it = index_.insert(IndexEntry{tracked.status.distance, &tracked}).first;
+}
+
+LiquidationMonitor::AlertLevel LiquidationMonitor::evaluate_alert(TrackedPosition& tracked) const {
+    double distance = tracked.status.distance;
+
+    AlertLevel level = AlertLevel::NONE;
+    if (distance <= config_.critical_distance) {
+        level = AlertLevel::CRITICAL;
+    } else if (distance <= config_.warning_distance) {
+        level = AlertLevel::WARNING;
+    }
+
+    // Only escalations are reported; de-escalation needs hysteresis to re-arm
+    if (level > tracked.alert_level) {
+        tracked.alert_level = level;
+        return level;
+    }
+
+    if (tracked.alert_level == AlertLevel::CRITICAL &&
+        distance > config_.critical_distance * config_.rearm_factor) {
+        tracked.alert_level = level;
+    } else if (tracked.alert_level == AlertLevel::WARNING &&
+               distance > config_.warning_distance * config_.rearm_factor) {
+        tracked.alert_level = AlertLevel::NONE;
+    }
+
+    return AlertLevel::NONE;
+}
+
+double LiquidationMonitor::calculate_distance(Side side, Price mark_price, Price liquidation_price) {
+    if (mark_price <= constants::math::EPSILON) {
+        return std::numeric_limits<double>::max();
+    }
+
+    // Positive while the position is safe, <= 0 once the mark has crossed liquidation
+    if (side == Side::BUY) {
+        return (mark_price - liquidation_price) / mark_price;
+    }
+    return (liquidation_price - mark_price) / mark_price;
+}
+
+MarginModel LiquidationMonitor::default_margin_model(Exchange exchange) {
+    // Conservative USDT-margined perpetual schedules (BTC tiers)
+    MarginModel model;
+    model.exchange = exchange;
+    model.default_leverage = 3.0;
+
+    switch (exchange) {
+        case Exchange::OKX:
+            model.tiers = {
+                {500000.0, 0.004, 125.0},
+                {3000000.0, 0.005, 100.0},
+                {std::numeric_limits<double>::max(), 0.01, 50.0}
+            };
+            break;
+        case Exchange::BINANCE:
+            model.tiers = {
+                {50000.0, 0.004, 125.0},
+                {600000.0, 0.005, 100.0},
+                {std::numeric_limits<double>::max(), 0.01, 50.0}
+            };
+            break;
+        case Exchange::BYBIT:
+            model.tiers = {
+                {2000000.0, 0.005, 100.0},
+                {std::numeric_limits<double>::max(), 0.01, 50.0}
+            };
+            break;
+    }
+
+    return model;
+}
+
+} // namespace arbitrage
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "core/types.h"
+#include <functional>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace arbitrage {
+
+// Tiered margin schedule for one venue (isolated margin, linear contracts)
+struct MarginTier {
+    double max_notional;              // Upper bound of the tier in USD
+    double maintenance_margin_rate;   // MMR applied inside this tier
+    double max_leverage;              // Highest leverage the venue allows in this tier
+};
+
+struct MarginModel {
+    Exchange exchange;
+    double default_leverage = 1.0;    // Used when a position carries no leverage
+    std::vector<MarginTier> tiers;    // Sorted by max_notional ascending
+
+    const MarginTier& tier_for(double notional) const;
+
+    double maintenance_margin_rate(double notional) const {
+        return tier_for(notional).maintenance_margin_rate;
+    }
+
+    double initial_margin(double notional, double leverage) const;
+    double maintenance_margin(double notional) const;
+
+    // Mark price at which the isolated margin of the position falls to maintenance:
+    //   long:  entry * (1 - 1/leverage + mmr)
+    //   short: entry * (1 + 1/leverage - mmr)
+    Price liquidation_price(Side side, Price entry_price, Quantity quantity, double leverage) const;
+};
+
+// Tracks leveraged positions and keeps them ordered by distance to liquidation.
+// A mark-price tick only touches the positions of that instrument, so the
+// closest position overall is always at the front of the index.
+class LiquidationMonitor {
+public:
+    struct Config {
+        double warning_distance = 0.05;    // 5% from liquidation
+        double critical_distance = 0.02;   // 2% from liquidation
+        double rearm_factor = 1.5;         // Distance must recover past threshold * factor to re-alert
+    };
+
+    struct LiquidationStatus {
+        Symbol symbol;
+        Exchange exchange;
+        Side side;
+        Quantity quantity;
+        Price entry_price;
+        Price mark_price;
+        Price liquidation_price;
+        double leverage;
+        double initial_margin;
+        double maintenance_margin;
+        double distance;                    // (mark - liq) / mark, signed towards safety
+    };
+
+    enum class AlertLevel {
+        NONE,
+        WARNING,
+        CRITICAL
+    };
+
+    using AlertCallback = std::function<void(const LiquidationStatus&, AlertLevel)>;
+
+    LiquidationMonitor();
+    explicit LiquidationMonitor(const Config& config);
+
+    void set_config(const Config& config);
+    void set_margin_model(const MarginModel& model);
+    void set_alert_callback(AlertCallback callback);
+
+    // Position lifecycle (called by RiskManager)
+    void upsert_position(const PositionInfo& position);
+    void remove_position(const Symbol& symbol, Exchange exchange);
+
+    // Mark-price tick - O(log n) index maintenance, O(1) alert check
+    void on_mark_price(const Symbol& symbol, Exchange exchange, Price mark_price);
+
+    // Queries
+    bool get_closest(LiquidationStatus& status) const;
+    std::vector<LiquidationStatus> get_positions_within(double max_distance) const;
+    size_t tracked_positions() const;
+
+private:
+    struct PositionKey {
+        Symbol symbol;
+        Exchange exchange;
+
+        bool operator==(const PositionKey& other) const {
+            return symbol == other.symbol && exchange == other.exchange;
+        }
+    };
+
+    struct PositionKeyHash {
+        std::size_t operator()(const PositionKey& key) const {
+            return std::hash<std::string>{}(key.symbol) ^
+                   (std::hash<int>{}(static_cast<int>(key.exchange)) << 1);
+        }
+    };
+
+    struct TrackedPosition;
+
+    // Index entry ordered by distance, ties broken by address for uniqueness
+    struct IndexEntry {
+        double distance;
+        const TrackedPosition* position;
+
+        bool operator<(const IndexEntry& other) const {
+            if (distance != other.distance) return distance < other.distance;
+            return position < other.position;
+        }
+    };
+
+    using DistanceIndex = std::set<IndexEntry>;
+
+    struct TrackedPosition {
+        LiquidationStatus status;
+        DistanceIndex::iterator index_it;
+        AlertLevel alert_level = AlertLevel::NONE;
+    };
+
+    Config config_;
+    std::unordered_map<Exchange, MarginModel> margin_models_;
+    std::unordered_map<PositionKey, TrackedPosition, PositionKeyHash> positions_;
+    DistanceIndex index_;
+    AlertCallback alert_callback_;
+    mutable std::mutex mutex_;
+
+    // Venues without a configured model get their own default on first use
+    const MarginModel& margin_model(Exchange exchange);
+    void recompute_margin(TrackedPosition& tracked);
+    void reindex(TrackedPosition& tracked);
+    AlertLevel evaluate_alert(TrackedPosition& tracked) const;
+
+    static double calculate_distance(Side side, Price mark_price, Price liquidation_price);
+    static MarginModel default_margin_model(Exchange exchange);
+};
+
+} // namespace arbitrage
@@ -1,7 +1,15 @@
 #include "risk_manager.h"
 #include "market_data/market_data_manager.h"
 #include "core/utils.h"
+#include "core/stats.h"
 #include "utils/logger.h"
+#include "utils/binary_log.h"
+#include "performance/event_trace.h"
+#include "performance/hw_counters.h"
+#include "performance/scope_timer.h"
+#include "utils/cycle_arena.h"
+#include "utils/parallel.h"
+#include "utils/clock.h"
 #include <algorithm>
 #include <numeric>
 
@@ -20,27 +28,42 @@ RiskManager::RiskManager(MarketDataManager* market_data)
     exchange_limits_[Exchange::OKX] = 300000.0;
     exchange_limits_[Exchange::BINANCE] = 400000.0;
     exchange_limits_[Exchange::BYBIT] = 300000.0;
+    
+    liquidation_monitor_.set_alert_callback(
+        [this](const LiquidationMonitor::LiquidationStatus& status,
+               LiquidationMonitor::AlertLevel level) {
+            handle_liquidation_alert(status, level);
+        }
+    );
 }
 
 bool RiskManager::check_opportunity_risk(const ArbitrageOpportunity& opportunity) {
+    ARB_TIME_SCOPE(RISK_CHECK);
+    ARB_HW_SCOPE(RISK_CHECK);
+    ARB_TRACE_SCOPE(RISK, opportunity.legs.empty() ? 0 : trace::instrument_id(opportunity.legs[0].symbol),
+                    opportunity.legs.size());
+    
     // Check execution risk
     if (opportunity.execution_risk > 0.7) {
-        LOG_WARN("Opportunity {} rejected - high execution risk: {}", 
-                opportunity.id, opportunity.execution_risk);
+        LOG_FAST_WARN_EVERY_MS(constants::logging::REPEAT_INTERVAL_MS,
+                               "Opportunity {} rejected - high execution risk: {}",
+                               opportunity.id, opportunity.execution_risk);
         return false;
     }
     
     // Check funding risk for perpetuals
     if (opportunity.funding_risk > constants::MAX_FUNDING_RATE_EXPOSURE) {
-        LOG_WARN("Opportunity {} rejected - high funding risk: {}", 
-                opportunity.id, opportunity.funding_risk);
+        LOG_FAST_WARN_EVERY_MS(constants::logging::REPEAT_INTERVAL_MS,
+                               "Opportunity {} rejected - high funding risk: {}",
+                               opportunity.id, opportunity.funding_risk);
         return false;
     }
     
     // Check liquidity
     if (opportunity.liquidity_score < constants::MIN_LIQUIDITY_SCORE) {
-        LOG_WARN("Opportunity {} rejected - low liquidity: {}", 
-                opportunity.id, opportunity.liquidity_score);
+        LOG_FAST_WARN_EVERY_MS(constants::logging::REPEAT_INTERVAL_MS,
+                               "Opportunity {} rejected - low liquidity: {}",
+                               opportunity.id, opportunity.liquidity_score);
         return false;
     }
     
@@ -56,7 +79,8 @@ bool RiskManager::check_opportunity_risk(const ArbitrageOpportunity& opportunity
     double current_exposure = calculate_total_exposure();
     
     if (current_exposure + additional_exposure > max_portfolio_exposure_) {
-        LOG_WARN("Opportunity {} rejected - would exceed portfolio limit", opportunity.id);
+        LOG_FAST_WARN_EVERY_MS(constants::logging::REPEAT_INTERVAL_MS,
+                               "Opportunity {} rejected - would exceed portfolio limit", opportunity.id);
         return false;
     }
     
@@ -107,13 +131,15 @@ bool RiskManager::check_portfolio_risk() {
     
     // Check VaR
     if (metrics.portfolio_var > max_portfolio_exposure_ * 0.1) {  // 10% of max exposure
-        LOG_WARN("Portfolio VaR exceeds limit: {}", metrics.portfolio_var);
+        LOG_WARN_EVERY_MS(constants::logging::REPEAT_INTERVAL_MS,
+                          "Portfolio VaR exceeds limit: {}", metrics.portfolio_var);
         return false;
     }
     
     // Check correlation risk
     if (metrics.correlation_risk > constants::MAX_CORRELATION_RISK) {
-        LOG_WARN("Portfolio correlation risk too high: {}", metrics.correlation_risk);
+        LOG_WARN_EVERY_MS(constants::logging::REPEAT_INTERVAL_MS,
+                          "Portfolio correlation risk too high: {}", metrics.correlation_risk);
         return false;
     }
     
@@ -126,6 +152,10 @@ void RiskManager::add_position(const PositionInfo& position) {
     PositionKey key{position.symbol, position.exchange};
     positions_[key] = position;
     
+    if (position.type != InstrumentType::SPOT) {
+        liquidation_monitor_.upsert_position(position);
+    }
+    
     LOG_INFO("Added position: {} {} @ {} on {}", 
             position.side == Side::BUY ? "BUY" : "SELL",
             position.quantity,
@@ -139,6 +169,10 @@ void RiskManager::update_position(const Symbol& symbol, Exchange exchange,
     
     PositionKey key{symbol, exchange};
     positions_[key] = position;
+    
+    if (position.type != InstrumentType::SPOT) {
+        liquidation_monitor_.upsert_position(position);
+    }
 }
 
 void RiskManager::close_position(const Symbol& symbol, Exchange exchange) {
@@ -153,12 +187,49 @@ void RiskManager::close_position(const Symbol& symbol, Exchange exchange) {
         record_pnl(pnl);
         
         positions_.erase(it);
+        liquidation_monitor_.remove_position(symbol, exchange);
         
         LOG_INFO("Closed position: {} on {} - P&L: {}", 
                 symbol, utils::exchange_to_string(exchange), pnl);
     }
 }
 
+void RiskManager::on_mark_price(const Symbol& symbol, Exchange exchange, Price mark_price) {
+    liquidation_monitor_.on_mark_price(symbol, exchange, mark_price);
+}
+
+void RiskManager::handle_liquidation_alert(const LiquidationMonitor::LiquidationStatus& status,
+                                          LiquidationMonitor::AlertLevel level) {
+    bool critical = level == LiquidationMonitor::AlertLevel::CRITICAL;
+    
+    Alert alert;
+    alert.type = Alert::LIQUIDATION_WARNING;
+    alert.severity = critical ? 1.0 : 0.6;
+    alert.timestamp = Clock::now();
+    alert.message = status.symbol + " on " + utils::exchange_to_string(status.exchange) +
+                    " is " + std::to_string(status.distance * 100.0) +
+                    "% from liquidation at " + std::to_string(status.liquidation_price);
+    
+    if (critical) {
+        LOG_ERROR("Liquidation CRITICAL: {}", alert.message);
+    } else {
+        LOG_WARN("Liquidation warning: {}", alert.message);
+    }
+    
+    std::lock_guard<std::mutex> lock(alerts_mutex_);
+    active_alerts_.push_back(std::move(alert));
+    
+    // Keep only recent alerts
+    if (active_alerts_.size() > 100) {
+        active_alerts_.erase(active_alerts_.begin());
+    }
+}
+
+std::vector<RiskManager::Alert> RiskManager::get_active_alerts() const {
+    std::lock_guard<std::mutex> lock(alerts_mutex_);
+    return active_alerts_;
+}
+
 RiskMetrics RiskManager::calculate_risk_metrics() const {
     // Check cache
     auto now = std::chrono::steady_clock::now();
@@ -167,6 +238,7 @@ RiskMetrics RiskManager::calculate_risk_metrics() const {
     }
     
     RiskMetrics metrics{};
+    CycleArena::Scope evaluation(CycleArena::local());
     
     // Calculate portfolio VaR
     metrics.portfolio_var = calculate_portfolio_var();
@@ -204,14 +276,12 @@ double RiskManager::calculate_portfolio_var(double confidence_level) const {
         return 0.0;
     }
     
-    // Sort returns
-    std::vector<double> sorted_returns = returns_history_;
-    std::sort(sorted_returns.begin(), sorted_returns.end());
-    
-    // Calculate VaR at confidence level
-    size_t index = static_cast<size_t>((1.0 - confidence_level) * sorted_returns.size());
+    // Select the return at the VaR quantile; no full sort needed
+    CycleArena::Scope evaluation(CycleArena::local());
+    std::pmr::vector<double> returns(returns_history_.begin(), returns_history_.end(),
+                                     evaluation.resource());
     
-    double var_percentage = -sorted_returns[index];
+    double var_percentage = -stats::select_quantile(returns, 1.0 - confidence_level);
     
     // Apply to current portfolio value
     double portfolio_value = calculate_total_exposure();
@@ -247,8 +317,9 @@ double RiskManager::calculate_sharpe_ratio() const {
         return 0.0;
     }
     
-    double mean_return = utils::calculate_mean(returns_history_);
-    double std_dev = utils::calculate_std_dev(returns_history_);
+    stats::Moments moments = stats::moments(returns_history_);
+    double mean_return = moments.mean;
+    double std_dev = moments.std_dev();
     
     if (std_dev < constants::math::EPSILON) {
         return 0.0;
@@ -264,6 +335,96 @@ double RiskManager::calculate_sharpe_ratio() const {
     return (annual_return - risk_free_rate) / annual_std_dev;
 }
 
+namespace {
+
+// Loss of one position under a scenario; positive is a loss
+double stress_position_loss(const PositionInfo& position,
+                            const RiskManager::StressTestScenario& scenario) {
+    double direction = position.side == Side::BUY ? 1.0 : -1.0;
+    double loss = 0.0;
+    
+    auto shock = scenario.price_shocks.find(position.symbol);
+    if (shock != scenario.price_shocks.end()) {
+        double multiplier = scenario.volatility_multiplier > 0.0 ? scenario.volatility_multiplier : 1.0;
+        double price_change = position.current_price * shock->second / 100.0 * multiplier;
+        loss -= price_change * position.quantity * direction;
+    }
+    
+    // Longs pay positive funding
+    if (position.type == InstrumentType::PERPETUAL) {
+        loss += position.quantity * position.current_price * scenario.funding_rate_shock * direction;
+    }
+    
+    return loss;
+}
+
+struct StressAccumulator {
+    double total_loss = 0.0;
+    double worst_loss = 0.0;
+    size_t worst_index = 0;
+    bool has_worst = false;
+};
+
+} // namespace
+
+std::vector<RiskManager::StressTestResult> RiskManager::run_stress_tests(
+    const std::vector<StressTestScenario>& scenarios) const {
+    
+    CycleArena::Scope evaluation(CycleArena::local());
+    std::pmr::vector<PositionInfo> positions(evaluation.resource());
+    {
+        std::lock_guard<std::mutex> lock(positions_mutex_);
+        positions.reserve(positions_.size());
+        for (const auto& [key, position] : positions_) {
+            positions.push_back(position);
+        }
+    }
+    
+    // Scenarios fan out across the pool; large books also split per scenario
+    constexpr size_t POSITION_GRAIN = 256;
+    std::vector<StressTestResult> results(scenarios.size());
+    
+    parallel_for(IndexRange{0, scenarios.size()}, 1, [&](IndexRange range) {
+        for (size_t i = range.begin; i < range.end; ++i) {
+            const auto& scenario = scenarios[i];
+            
+            auto totals = parallel_reduce(
+                IndexRange{0, positions.size()}, POSITION_GRAIN, StressAccumulator{},
+                [&](IndexRange part, StressAccumulator acc) {
+                    for (size_t p = part.begin; p < part.end; ++p) {
+                        double loss = stress_position_loss(positions[p], scenario);
+                        acc.total_loss += loss;
+                        if (!acc.has_worst || loss > acc.worst_loss) {
+                            acc.worst_loss = loss;
+                            acc.worst_index = p;
+                            acc.has_worst = true;
+                        }
+                    }
+                    return acc;
+                },
+                [](StressAccumulator a, const StressAccumulator& b) {
+                    a.total_loss += b.total_loss;
+                    if (b.has_worst && (!a.has_worst || b.worst_loss > a.worst_loss)) {
+                        a.worst_loss = b.worst_loss;
+                        a.worst_index = b.worst_index;
+                        a.has_worst = true;
+                    }
+                    return a;
+                });
+            
+            auto& result = results[i];
+            result.scenario_name = scenario.name;
+            result.portfolio_loss = totals.total_loss;
+            result.worst_position_loss = totals.has_worst ? totals.worst_loss : 0.0;
+            result.worst_position_symbol = totals.has_worst ? positions[totals.worst_index].symbol : Symbol{};
+            // Same budget as the VaR check in check_portfolio_risk()
+            result.breaches_limits = totals.total_loss > max_portfolio_exposure_ * 0.1;
+        }
+    });
+    
+    return results;
+}
+
 void RiskManager::record_pnl(double pnl) {
     pnl_history_.push_back(pnl);
     
@@ -317,27 +478,17 @@ void VaRCalculator::add_return(double daily_return) {
 double VaRCalculator::calculate_var(double confidence_level) const {
     if (returns_.empty()) return 0.0;
     
-    std::vector<double> sorted = returns_;
-    std::sort(sorted.begin(), sorted.end());
-    
-    size_t index = static_cast<size_t>((1.0 - confidence_level) * sorted.size());
-    return -sorted[index];
+    CycleArena::Scope evaluation(CycleArena::local());
+    std::pmr::vector<double> returns(returns_.begin(), returns_.end(), evaluation.resource());
+    return -stats::select_quantile(returns, 1.0 - confidence_level);
 }
 
 double VaRCalculator::calculate_cvar(double confidence_level) const {
     if (returns_.empty()) return 0.0;
     
-    std::vector<double> sorted = returns_;
-    std::sort(sorted.begin(), sorted.end());
-    
-    size_t cutoff_index = static_cast<size_t>((1.0 - confidence_level) * sorted.size());
-    
-    double sum = 0.0;
-    for (size_t i = 0; i <= cutoff_index; ++i) {
-        sum += sorted[i];
-    }
-    
-    return -sum / (cutoff_index + 1);
+    CycleArena::Scope evaluation(CycleArena::local());
+    std::pmr::vector<double> returns(returns_.begin(), returns_.end(), evaluation.resource());
+    return -stats::lower_tail_mean(returns, 1.0 - confidence_level);
 }
 
 // PositionSizer implementation
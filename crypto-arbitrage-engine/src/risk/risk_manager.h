@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/types.h"
+#include "liquidation_monitor.h"
 #include <memory>
 #include <unordered_map>
 #include <mutex>
@@ -28,6 +29,14 @@ public:
         exchange_limits_[exchange] = limit;
     }
     
+    void set_margin_model(const MarginModel& model) {
+        liquidation_monitor_.set_margin_model(model);
+    }
+    
+    void set_liquidation_config(const LiquidationMonitor::Config& config) {
+        liquidation_monitor_.set_config(config);
+    }
+    
     // Risk checks
     bool check_opportunity_risk(const ArbitrageOpportunity& opportunity);
     bool check_position_limit(const Symbol& symbol, double size);
@@ -40,6 +49,19 @@ public:
                         const PositionInfo& position);
     void close_position(const Symbol& symbol, Exchange exchange);
     
+    // Mark-price feed for leveraged positions
+    void on_mark_price(const Symbol& symbol, Exchange exchange, Price mark_price);
+    
+    // Liquidation distance
+    bool get_closest_liquidation(LiquidationMonitor::LiquidationStatus& status) const {
+        return liquidation_monitor_.get_closest(status);
+    }
+    
+    std::vector<LiquidationMonitor::LiquidationStatus> get_positions_near_liquidation(
+        double max_distance) const {
+        return liquidation_monitor_.get_positions_within(max_distance);
+    }
+    
     // Risk metrics calculation
     RiskMetrics calculate_risk_metrics() const;
     double calculate_portfolio_var(double confidence_level = 0.95) const;
@@ -76,7 +98,8 @@ public:
             EXCHANGE_EXPOSURE_WARNING,
             CORRELATION_RISK_WARNING,
             VAR_BREACH,
-            DRAWDOWN_WARNING
+            DRAWDOWN_WARNING,
+            LIQUIDATION_WARNING
         };
         
         Type type;
@@ -131,6 +154,12 @@ private:
     std::vector<Alert> active_alerts_;
     mutable std::mutex alerts_mutex_;
     
+    // Margin and liquidation tracking for leveraged legs
+    LiquidationMonitor liquidation_monitor_;
+    
+    void handle_liquidation_alert(const LiquidationMonitor::LiquidationStatus& status,
+                                  LiquidationMonitor::AlertLevel level);
+    
     // Helper methods
     double calculate_position_exposure(const PositionInfo& position) const;
     double calculate_total_exposure() const;
@@ -24,15 +24,19 @@ double PerpetualPricer::calculate_fair_funding_rate(const Symbol& underlying,
     return 0.0;
 }
 
-std::vector<PerpetualPricer::FundingArbitrage> 
-PerpetualPricer::find_funding_arbitrage(double min_spread_bps) const {
-    std::vector<FundingArbitrage> opportunities;
+std::pmr::vector<PerpetualPricer::FundingArbitrage> 
+PerpetualPricer::find_funding_arbitrage(double min_spread_bps,
+                                        std::pmr::memory_resource* resource) const {
+    std::pmr::vector<FundingArbitrage> opportunities(resource);
     
-    std::vector<Symbol> symbols = {"BTC-USDT", "ETH-USDT", "SOL-USDT"};
+    std::pmr::vector<Symbol> symbols({"BTC-USDT", "ETH-USDT", "SOL-USDT"}, resource);
+    
+    // Compare funding rates across exchanges
+    std::pmr::vector<std::pair<Exchange, double>> funding_rates(resource);
+    funding_rates.reserve(3);
     
     for (const auto& symbol : symbols) {
-        // Compare funding rates across exchanges
-        std::vector<std::pair<Exchange, double>> funding_rates;
+        funding_rates.clear();
         
         for (auto exchange : {Exchange::OKX, Exchange::BINANCE, Exchange::BYBIT}) {
             double rate = get_funding_rate(symbol, exchange);
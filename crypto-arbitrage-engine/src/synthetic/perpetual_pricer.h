@@ -24,8 +24,9 @@ public:
         double required_capital;
     };
     
-    std::vector<FundingArbitrage> find_funding_arbitrage(
-        double min_spread_bps = 10.0) const;
+    std::pmr::vector<FundingArbitrage> find_funding_arbitrage(
+        double min_spread_bps = 10.0,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
     
     // Calculate synthetic spot using perpetual and funding
     Price calculate_synthetic_spot(const Symbol& underlying,
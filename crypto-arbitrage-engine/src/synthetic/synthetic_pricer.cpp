@@ -1,6 +1,7 @@
 #include "synthetic_pricer.h"
 #include "market_data/market_data_manager.h"
 #include "core/utils.h"
+#include "utils/clock.h"
 
 namespace arbitrage {
 
@@ -35,12 +36,13 @@ double SyntheticPricer::calculate_implied_funding_rate(const Symbol& underlying,
     return basis_bps * 365 * 3 / 10000;
 }
 
-std::vector<SyntheticPricer::SyntheticArbitrage> 
-SyntheticPricer::find_arbitrage_opportunities(double min_profit_bps) const {
-    std::vector<SyntheticArbitrage> opportunities;
+std::pmr::vector<SyntheticPricer::SyntheticArbitrage> 
+SyntheticPricer::find_arbitrage_opportunities(double min_profit_bps,
+                                              std::pmr::memory_resource* resource) const {
+    std::pmr::vector<SyntheticArbitrage> opportunities(resource);
     
     // Check common symbols
-    std::vector<Symbol> symbols = {"BTC-USDT", "ETH-USDT", "SOL-USDT"};
+    std::pmr::vector<Symbol> symbols({"BTC-USDT", "ETH-USDT", "SOL-USDT"}, resource);
     
     for (const auto& symbol : symbols) {
         // Check spot vs perpetual arbitrage
@@ -101,7 +103,7 @@ double SyntheticPricer::get_funding_rate(const Symbol& symbol, Exchange exchange
 }
 
 double SyntheticPricer::calculate_time_to_expiry(Timestamp expiry) const {
-    auto now = utils::get_current_timestamp();
+    auto now = Clock::now();
     auto diff = expiry - now;
     auto days = std::chrono::duration_cast<std::chrono::hours>(diff).count() / 24.0;
     return days / 365.25;
@@ -2,6 +2,7 @@
 
 #include "core/types.h"
 #include <memory>
+#include <memory_resource>
 #include <vector>
 
 namespace arbitrage {
@@ -50,8 +51,11 @@ public:
         double execution_risk;
     };
     
-    std::vector<SyntheticArbitrage> find_arbitrage_opportunities(
-        double min_profit_bps = 5.0) const;
+    // Results and scratch come from resource; pass a cycle arena to keep
+    // the detection pass off the heap
+    std::pmr::vector<SyntheticArbitrage> find_arbitrage_opportunities(
+        double min_profit_bps = 5.0,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
     
 protected:
     MarketDataManager* market_data_;
@@ -0,0 +1,323 @@
+#include "alloc_tracker.h"
+#include "thread_registry.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <malloc.h>
+#include <mutex>
+#include <new>
+
+namespace arbitrage {
+
+namespace {
+
+thread_local uint8_t thread_stage = 0;
+
+} // namespace
+
+uint8_t AllocTracker::current_stage() {
+    return thread_stage;
+}
+
+uint8_t AllocTracker::exchange_stage(uint8_t stage) {
+    uint8_t previous = thread_stage;
+    thread_stage = stage;
+    return previous;
+}
+
+std::string_view AllocTracker::stage_name(size_t stage) {
+    if (stage == 0 || stage >= STAGE_COUNT) return "untagged";
+    return trace::EVENT_NAMES[stage - 1];
+}
+
+#ifdef ARB_TRACK_ALLOCATIONS
+
+namespace {
+
+constexpr size_t MAX_THREAD_SLOTS = 256;
+
+struct StageCounters {
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> deallocations{0};
+    std::atomic<uint64_t> bytes_allocated{0};
+    std::atomic<uint64_t> bytes_freed{0};
+};
+
+// Counters of one live thread. Only the owner writes, so updates are a
+// relaxed load and store rather than a locked read-modify-write.
+struct alignas(64) ThreadSlot {
+    std::atomic<bool> in_use{false};
+    std::atomic<pid_t> tid{0};
+    StageCounters stages[AllocTracker::STAGE_COUNT];
+};
+
+// Static storage only: the hooks run before main and while threads exit,
+// so nothing here may itself allocate or need construction order
+ThreadSlot thread_slots[MAX_THREAD_SLOTS];
+StageCounters shared_stages[AllocTracker::STAGE_COUNT];     // Slots exhausted, or thread exiting
+StageCounters retired_stages[AllocTracker::STAGE_COUNT];    // Folded in from exited threads
+
+// Taken only on thread exit and by readers, so a retiring thread is never
+// counted twice or missed
+std::mutex retire_mutex;
+
+thread_local ThreadSlot* thread_slot = nullptr;
+thread_local bool thread_retired = false;
+
+void bump(std::atomic<uint64_t>& counter, uint64_t value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+void retire_slot(ThreadSlot* slot) {
+    std::lock_guard<std::mutex> lock(retire_mutex);
+    for (size_t stage = 0; stage < AllocTracker::STAGE_COUNT; ++stage) {
+        auto& live = slot->stages[stage];
+        auto& retired = retired_stages[stage];
+        retired.allocations.fetch_add(live.allocations.exchange(0, std::memory_order_relaxed),
+                                      std::memory_order_relaxed);
+        retired.deallocations.fetch_add(live.deallocations.exchange(0, std::memory_order_relaxed),
+                                        std::memory_order_relaxed);
+        retired.bytes_allocated.fetch_add(live.bytes_allocated.exchange(0, std::memory_order_relaxed),
+                                          std::memory_order_relaxed);
+        retired.bytes_freed.fetch_add(live.bytes_freed.exchange(0, std::memory_order_relaxed),
+                                      std::memory_order_relaxed);
+    }
+    slot->tid.store(0, std::memory_order_relaxed);
+    slot->in_use.store(false, std::memory_order_release);
+}
+
+// Hands the slot back on thread exit. Plain struct rather than a
+// std::function: registering it must not call operator new.
+struct ThreadSlotOwner {
+    ThreadSlot* slot = nullptr;
+
+    ~ThreadSlotOwner() {
+        thread_retired = true;
+        thread_slot = nullptr;
+        if (slot) {
+            retire_slot(slot);
+        }
+    }
+};
+
+ThreadSlot* claim_slot() {
+    for (auto& slot : thread_slots) {
+        bool expected = false;
+        if (!slot.in_use.load(std::memory_order_relaxed) &&
+            slot.in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            slot.tid.store(ThreadRegistry::current_tid(), std::memory_order_relaxed);
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+void count(bool allocation, size_t bytes) {
+    StageCounters* counters = nullptr;
+    ThreadSlot* slot = thread_slot;
+
+    if (!slot && !thread_retired) {
+        // First allocation on this thread; guard against the owner's own
+        // registration re-entering
+        thread_retired = true;
+        slot = claim_slot();
+        if (slot) {
+            thread_local ThreadSlotOwner owner;
+            owner.slot = slot;
+            thread_slot = slot;
+        }
+        thread_retired = false;
+    }
+
+    if (slot) {
+        counters = &slot->stages[thread_stage];
+        if (allocation) {
+            bump(counters->allocations, 1);
+            bump(counters->bytes_allocated, bytes);
+        } else {
+            bump(counters->deallocations, 1);
+            bump(counters->bytes_freed, bytes);
+        }
+        return;
+    }
+
+    counters = &shared_stages[thread_stage];
+    if (allocation) {
+        counters->allocations.fetch_add(1, std::memory_order_relaxed);
+        counters->bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+    } else {
+        counters->deallocations.fetch_add(1, std::memory_order_relaxed);
+        counters->bytes_freed.fetch_add(bytes, std::memory_order_relaxed);
+    }
+}
+
+void add(AllocTracker::Stats& total, const StageCounters& counters) {
+    total.allocations += counters.allocations.load(std::memory_order_relaxed);
+    total.deallocations += counters.deallocations.load(std::memory_order_relaxed);
+    total.bytes_allocated += counters.bytes_allocated.load(std::memory_order_relaxed);
+    total.bytes_freed += counters.bytes_freed.load(std::memory_order_relaxed);
+}
+
+// Usable size is counted on both sides so allocated - freed is live heap
+void* allocate(size_t size) {
+    void* pointer = std::malloc(size ? size : 1);
+    if (pointer) {
+        count(true, malloc_usable_size(pointer));
+    }
+    return pointer;
+}
+
+void* allocate_aligned(size_t size, std::align_val_t alignment) {
+    size_t align = std::max(static_cast<size_t>(alignment), sizeof(void*));
+    void* pointer = nullptr;
+    if (posix_memalign(&pointer, align, size ? size : 1) != 0) {
+        return nullptr;
+    }
+    count(true, malloc_usable_size(pointer));
+    return pointer;
+}
+
+template <typename Allocate>
+void* allocate_or_throw(Allocate allocate_once) {
+    for (;;) {
+        if (void* pointer = allocate_once()) {
+            return pointer;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void deallocate(void* pointer) {
+    if (!pointer) return;
+    count(false, malloc_usable_size(pointer));
+    std::free(pointer);
+}
+
+} // namespace
+
+bool AllocTracker::enabled() {
+    return true;
+}
+
+AllocTracker::Stats AllocTracker::current_thread() {
+    Stats total;
+    if (ThreadSlot* slot = thread_slot) {
+        for (const auto& stage : slot->stages) {
+            add(total, stage);
+        }
+    }
+    return total;
+}
+
+std::array<AllocTracker::Stats, AllocTracker::STAGE_COUNT> AllocTracker::stage_totals() {
+    std::array<Stats, STAGE_COUNT> totals{};
+    std::lock_guard<std::mutex> lock(retire_mutex);
+
+    for (size_t stage = 0; stage < STAGE_COUNT; ++stage) {
+        add(totals[stage], retired_stages[stage]);
+        add(totals[stage], shared_stages[stage]);
+    }
+    for (const auto& slot : thread_slots) {
+        if (!slot.in_use.load(std::memory_order_acquire)) continue;
+        for (size_t stage = 0; stage < STAGE_COUNT; ++stage) {
+            add(totals[stage], slot.stages[stage]);
+        }
+    }
+    return totals;
+}
+
+std::vector<AllocTracker::ThreadStats> AllocTracker::thread_totals() {
+    std::vector<ThreadStats> threads;
+    std::lock_guard<std::mutex> lock(retire_mutex);
+
+    for (const auto& slot : thread_slots) {
+        if (!slot.in_use.load(std::memory_order_acquire)) continue;
+
+        ThreadStats thread{slot.tid.load(std::memory_order_relaxed), {}};
+        for (const auto& stage : slot.stages) {
+            add(thread.stats, stage);
+        }
+        threads.push_back(thread);
+    }
+    return threads;
+}
+
+} // namespace arbitrage
+
+// Replacement global allocation functions. Every form funnels into malloc /
+// posix_memalign and free so that sized and aligned deletes stay consistent.
+
+void* operator new(size_t size) {
+    return arbitrage::allocate_or_throw([size] { return arbitrage::allocate(size); });
+}
+
+void* operator new[](size_t size) {
+    return arbitrage::allocate_or_throw([size] { return arbitrage::allocate(size); });
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return arbitrage::allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return arbitrage::allocate(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    return arbitrage::allocate_or_throw([=] { return arbitrage::allocate_aligned(size, alignment); });
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return arbitrage::allocate_or_throw([=] { return arbitrage::allocate_aligned(size, alignment); });
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return arbitrage::allocate_aligned(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return arbitrage::allocate_aligned(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept { arbitrage::deallocate(pointer); }
+void operator delete[](void* pointer) noexcept { arbitrage::deallocate(pointer); }
+void operator delete(void* pointer, size_t) noexcept { arbitrage::deallocate(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { arbitrage::deallocate(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { arbitrage::deallocate(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { arbitrage::deallocate(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { arbitrage::deallocate(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { arbitrage::deallocate(pointer); }
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept { arbitrage::deallocate(pointer); }
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept { arbitrage::deallocate(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    arbitrage::deallocate(pointer);
+}
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept {
+    arbitrage::deallocate(pointer);
+}
+
+#else
+
+bool AllocTracker::enabled() {
+    return false;
+}
+
+AllocTracker::Stats AllocTracker::current_thread() {
+    return {};
+}
+
+std::array<AllocTracker::Stats, AllocTracker::STAGE_COUNT> AllocTracker::stage_totals() {
+    return {};
+}
+
+std::vector<AllocTracker::ThreadStats> AllocTracker::thread_totals() {
+    return {};
+}
+
+} // namespace arbitrage
+
+#endif
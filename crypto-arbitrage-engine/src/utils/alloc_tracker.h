@@ -0,0 +1,89 @@
+#pragma once
+
+#include "performance/event_trace_format.h"
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <sys/types.h>
+#include <vector>
+
+namespace arbitrage {
+
+// Allocation counts from the replaced global operator new / delete.
+//
+// Built with TRACK_ALLOCATIONS, every allocation is counted against the
+// calling thread and against the pipeline stage that thread is in. The
+// stage is a thread-local marker set by ARB_TRACE_SCOPE (trace::Event ids),
+// so untagged code lands in stage 0 ("untagged"). Counting is a few relaxed
+// load/stores into a slot owned by the thread, so it is cheap enough for
+// canary hosts but is meant for diagnosis and benchmarks, not production.
+class AllocTracker {
+public:
+    // Stage 0 is untagged; stage i + 1 is trace::Event i
+    static constexpr size_t STAGE_COUNT = static_cast<size_t>(trace::Event::COUNT) + 1;
+
+    struct Stats {
+        uint64_t allocations = 0;
+        uint64_t deallocations = 0;
+        uint64_t bytes_allocated = 0;
+        uint64_t bytes_freed = 0;
+    };
+
+    struct ThreadStats {
+        pid_t tid;
+        Stats stats;
+    };
+
+    // True when the operator new / delete hooks are compiled in
+    static bool enabled();
+
+    static std::string_view stage_name(size_t stage);
+
+    // Calling thread only; cheap enough for scoped checks
+    static Stats current_thread();
+
+    // Aggregates across live and exited threads
+    static std::array<Stats, STAGE_COUNT> stage_totals();
+    static std::vector<ThreadStats> thread_totals();     // Live threads only
+
+    // Stage marker, maintained by AllocStageScope
+    static uint8_t current_stage();
+    static uint8_t exchange_stage(uint8_t stage);
+};
+
+// Tags allocations in the enclosing scope with a pipeline stage
+class AllocStageScope {
+public:
+    explicit AllocStageScope(trace::Event event)
+        : previous_(AllocTracker::exchange_stage(static_cast<uint8_t>(static_cast<size_t>(event) + 1))) {}
+
+    ~AllocStageScope() { AllocTracker::exchange_stage(previous_); }
+
+    AllocStageScope(const AllocStageScope&) = delete;
+    AllocStageScope& operator=(const AllocStageScope&) = delete;
+
+private:
+    uint8_t previous_;
+};
+
+// Counts the calling thread's allocations since construction. Benchmarks
+// and zero-allocation paths check allocations() == 0 after the measured work.
+class AllocCounter {
+public:
+    AllocCounter() : start_(AllocTracker::current_thread()) {}
+
+    uint64_t allocations() const {
+        return AllocTracker::current_thread().allocations - start_.allocations;
+    }
+
+    uint64_t bytes() const {
+        return AllocTracker::current_thread().bytes_allocated - start_.bytes_allocated;
+    }
+
+    void restart() { start_ = AllocTracker::current_thread(); }
+
+private:
+    AllocTracker::Stats start_;
+};
+
+} // namespace arbitrage
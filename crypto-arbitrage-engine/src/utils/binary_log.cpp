@@ -0,0 +1,233 @@
+#include "binary_log.h"
+#include "utils/clock.h"
+#include <spdlog/details/os.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace arbitrage {
+
+std::atomic<bool> BinaryLog::active_{false};
+
+namespace {
+
+struct BinaryLogState {
+    std::mutex mutex;                               // Guards buffers
+    std::vector<binlog::StagingBuffer*> buffers;
+
+    // Writer thread only
+    std::vector<binlog::StagingBuffer*> snapshot;
+    std::unordered_map<const binlog::Site*, uint32_t> site_ids;
+    std::ofstream file;
+    uint64_t retired_dropped = 0;
+    uint64_t reported_dropped = 0;
+    uint64_t anchor_sequence = 0;                   // Clock mapping last written; 0: none
+    std::string scratch;
+    std::atomic<size_t> sites{0};
+};
+
+BinaryLogState& state() {
+    static BinaryLogState* instance = new BinaryLogState();     // Threads may log during exit
+    return *instance;
+}
+
+// Retires the calling thread's buffer when the thread exits
+struct BufferRetirer {
+    ~BufferRetirer() {
+        if (binlog::current_buffer) {
+            binlog::current_buffer->retire();
+            binlog::current_buffer = nullptr;
+        }
+    }
+};
+
+thread_local BufferRetirer retirer;
+
+template<typename T>
+void write_pod(std::ofstream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void write_site(BinaryLogState& log, const binlog::Site* site, uint32_t id) {
+    std::string_view file = site->file;
+    std::string_view format = site->format;
+
+    binlog::SiteEntry entry{};
+    entry.id = id;
+    entry.line = static_cast<uint32_t>(site->line);
+    entry.level = static_cast<uint8_t>(site->level);
+    entry.arg_count = site->arg_count;
+    entry.file_length = static_cast<uint16_t>(std::min<size_t>(file.size(), UINT16_MAX));
+    entry.format_length = static_cast<uint32_t>(format.size());
+
+    write_pod(log.file, binlog::EntryTag::SITE);
+    write_pod(log.file, entry);
+    log.file.write(reinterpret_cast<const char*>(site->types), site->arg_count);
+    log.file.write(file.data(), entry.file_length);
+    log.file.write(format.data(), entry.format_length);
+}
+
+// Records drained after an anchor map through it, as Clock::to_wall() maps
+// them for the text log
+void write_anchor(BinaryLogState& log) {
+    Clock::Anchor anchor;
+    if (!Clock::current_anchor(anchor) || anchor.sequence == log.anchor_sequence) {
+        return;
+    }
+    log.anchor_sequence = anchor.sequence;
+
+    binlog::AnchorEntry entry{};
+    entry.tsc = anchor.tsc;
+    entry.wall_ns = anchor.wall_ns;
+    entry.ticks_per_nanosecond = anchor.ticks_per_nanosecond;
+    write_pod(log.file, binlog::EntryTag::ANCHOR);
+    write_pod(log.file, entry);
+}
+
+} // namespace
+
+void BinaryLog::start(const std::string& binary_file) {
+    auto& log = state();
+    if (!binary_file.empty()) {
+        std::filesystem::path path(binary_file);
+        std::error_code error;
+        if (path.has_parent_path()) {
+            std::filesystem::create_directories(path.parent_path(), error);
+        }
+
+        log.file.open(binary_file, std::ios::binary | std::ios::trunc);
+        if (!log.file.is_open()) {
+            LOG_ERROR("Failed to open binary log {}, formatting LOG_FAST records instead", binary_file);
+        } else {
+            binlog::LogFileHeader header{};
+            std::memcpy(header.magic, binlog::LOG_MAGIC, sizeof(header.magic));
+            header.version = binlog::LOG_VERSION;
+            header.ticks_per_nanosecond = TscClock::ticks_per_nanosecond();
+            header.anchor_tsc = Clock::ticks();
+            header.anchor_wall_ns = Clock::to_wall(header.anchor_tsc).count();
+            write_pod(log.file, header);
+            LOG_INFO("LOG_FAST records -> {} (decode with log_decoder)", binary_file);
+        }
+    }
+
+    active_.store(true, std::memory_order_release);
+}
+
+binlog::StagingBuffer* BinaryLog::register_thread() {
+    (void)retirer;      // Instantiates the thread-exit hook for this thread
+
+    auto* buffer = new binlog::StagingBuffer(spdlog::details::os::thread_id());
+    auto& log = state();
+    std::lock_guard<std::mutex> lock(log.mutex);
+    log.buffers.push_back(buffer);
+    return buffer;
+}
+
+bool BinaryLog::drain(const Emit& emit) {
+    auto& log = state();
+    {
+        std::lock_guard<std::mutex> lock(log.mutex);
+        log.snapshot = log.buffers;
+    }
+
+    bool binary = log.file.is_open();
+    bool wrote = false;
+    uint64_t dropped = log.retired_dropped;
+
+    if (binary) {
+        write_anchor(log);
+    }
+
+    for (binlog::StagingBuffer* buffer : log.snapshot) {
+        // Read first: a retired buffer gets no records after the flag
+        bool retired = buffer->retired();
+
+        size_t records = buffer->drain([&](const binlog::StagingBuffer::RecordHeader& header,
+                                           const char* payload, size_t payload_size) {
+            const binlog::Site* site = header.site;
+
+            if (binary) {
+                auto [entry, added] = log.site_ids.try_emplace(site, static_cast<uint32_t>(log.site_ids.size()));
+                if (added) {
+                    write_site(log, site, entry->second);
+                    log.sites.store(log.site_ids.size(), std::memory_order_relaxed);
+                }
+
+                binlog::RecordEntry record{};
+                record.site = entry->second;
+                record.payload_size = static_cast<uint32_t>(payload_size);
+                record.thread_id = buffer->thread_id();
+                record.tsc = header.tsc;
+                write_pod(log.file, binlog::EntryTag::RECORD);
+                write_pod(log.file, record);
+                log.file.write(payload, static_cast<std::streamsize>(payload_size));
+                return;
+            }
+
+            if (log.site_ids.try_emplace(site, static_cast<uint32_t>(log.site_ids.size())).second) {
+                log.sites.store(log.site_ids.size(), std::memory_order_relaxed);
+            }
+            log.scratch.clear();
+            binlog::format_record(log.scratch, site->format, site->types, site->arg_count,
+                                  payload, payload_size);
+
+            auto time = spdlog::log_clock::time_point(
+                std::chrono::duration_cast<spdlog::log_clock::duration>(Clock::to_wall(header.tsc)));
+            emit(site->level, time, buffer->thread_id(), log.scratch);
+        });
+
+        wrote = wrote || records > 0;
+        dropped += buffer->dropped();
+
+        if (retired) {
+            log.retired_dropped += buffer->dropped();
+            std::lock_guard<std::mutex> lock(log.mutex);
+            log.buffers.erase(std::find(log.buffers.begin(), log.buffers.end(), buffer));
+            delete buffer;
+        }
+    }
+
+    if (dropped != log.reported_dropped) {
+        emit(spdlog::level::warn, spdlog::log_clock::now(), spdlog::details::os::thread_id(),
+             "LOG_FAST staging buffers full: dropped " + std::to_string(dropped - log.reported_dropped) +
+             " records");
+        log.reported_dropped = dropped;
+        wrote = true;
+    }
+
+    if (binary && wrote) {
+        log.file.flush();
+    }
+    return wrote;
+}
+
+void BinaryLog::stop(const Emit& emit) {
+    // Later LOG_FAST calls format synchronously; pick up what raced in
+    active_.store(false, std::memory_order_release);
+    drain(emit);
+
+    auto& log = state();
+    if (log.file.is_open()) {
+        log.file.close();
+    }
+}
+
+BinaryLog::Stats BinaryLog::stats() {
+    auto& log = state();
+    std::lock_guard<std::mutex> lock(log.mutex);
+    Stats stats;
+    stats.active = active();
+    stats.dropped = log.retired_dropped;
+    for (const auto* buffer : log.buffers) {
+        stats.dropped += buffer->dropped();
+    }
+    stats.threads = log.buffers.size();
+    stats.sites = log.sites.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace arbitrage
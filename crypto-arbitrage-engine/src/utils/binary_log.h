@@ -0,0 +1,342 @@
+#pragma once
+
+#include "binary_log_format.h"
+#include "logger.h"
+#include "tsc_clock.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace arbitrage {
+namespace binlog {
+
+// One LOG_FAST call site. Sites are static constexpr objects, so a site's
+// address is its id and nothing is registered at runtime; the format
+// string and argument types are only read by the log writer.
+struct Site {
+    spdlog::level::level_enum level;
+    const char* format;
+    const char* file;
+    int line;
+    const ArgType* types;
+    uint8_t arg_count;
+};
+
+template<typename T>
+constexpr ArgType arg_type() {
+    using U = std::decay_t<T>;
+    if constexpr (std::is_same_v<U, bool>) {
+        return ArgType::BOOL;
+    } else if constexpr (std::is_same_v<U, char>) {
+        return ArgType::CHAR;
+    } else if constexpr (std::is_enum_v<U>) {
+        return std::is_signed_v<std::underlying_type_t<U>> ? ArgType::INT : ArgType::UINT;
+    } else if constexpr (std::is_integral_v<U>) {
+        return std::is_signed_v<U> ? ArgType::INT : ArgType::UINT;
+    } else if constexpr (std::is_floating_point_v<U>) {
+        return ArgType::DOUBLE;
+    } else {
+        static_assert(std::is_convertible_v<const U&, std::string_view>,
+                      "LOG_FAST arguments must be numbers, bools, chars, enums or strings");
+        return ArgType::STRING;
+    }
+}
+
+// One spare entry so a site without arguments still has an array
+template<typename... Args>
+inline constexpr ArgType ARG_TYPES[sizeof...(Args) + 1] = {arg_type<Args>()..., ArgType::INT};
+
+template<typename... Args>
+struct TypeList {
+    static constexpr uint8_t size = sizeof...(Args);
+    static constexpr const ArgType* types = ARG_TYPES<Args...>;
+};
+
+// Unevaluated only: names the argument types of a call site
+template<typename... Args>
+TypeList<std::decay_t<Args>...> type_list(const Args&...);
+
+consteval size_t field_count(std::string_view format) {
+    size_t count = 0;
+    for (size_t i = 0; i < format.size(); ++i) {
+        if (format[i] == '{') {
+            if (i + 1 < format.size() && format[i + 1] == '{') {
+                ++i;
+            } else {
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+// Longer strings are cut; keeps every record well inside a staging buffer
+inline constexpr size_t MAX_STRING_ARG = 1024;
+
+template<typename T>
+size_t encoded_size(const T& value) {
+    if constexpr (arg_type<T>() == ArgType::STRING) {
+        return sizeof(uint32_t) + std::min(std::string_view(value).size(), MAX_STRING_ARG);
+    } else {
+        return sizeof(uint64_t);
+    }
+}
+
+template<typename T>
+char* encode(char* out, const T& value) {
+    constexpr ArgType type = arg_type<T>();
+    if constexpr (type == ArgType::STRING) {
+        std::string_view text(value);
+        auto length = static_cast<uint32_t>(std::min(text.size(), MAX_STRING_ARG));
+        std::memcpy(out, &length, sizeof(length));
+        std::memcpy(out + sizeof(length), text.data(), length);
+        return out + sizeof(length) + length;
+    } else {
+        uint64_t bits;
+        if constexpr (type == ArgType::DOUBLE) {
+            double widened = static_cast<double>(value);
+            std::memcpy(&bits, &widened, sizeof(bits));
+        } else if constexpr (type == ArgType::INT) {
+            bits = static_cast<uint64_t>(static_cast<int64_t>(value));
+        } else {
+            bits = static_cast<uint64_t>(value);
+        }
+        std::memcpy(out, &bits, sizeof(bits));
+        return out + sizeof(bits);
+    }
+}
+
+// Enums go to the synchronous fallback as numbers, as the writer prints them
+template<typename T>
+decltype(auto) plain(const T& value) {
+    if constexpr (std::is_enum_v<T>) {
+        return static_cast<std::underlying_type_t<T>>(value);
+    } else {
+        return (value);
+    }
+}
+
+// Per-thread single-producer byte ring of encoded records.
+//
+// Records are 8-byte aligned and never wrap: when one does not fit before
+// the end, the producer leaves a zero size word and starts again at the
+// front. The log writer is the only consumer.
+class StagingBuffer {
+public:
+    static constexpr size_t CAPACITY = 256 * 1024;
+
+    struct RecordHeader {
+        uint32_t size;              // Whole record, header included; 0 marks a wrap
+        uint32_t reserved;
+        const Site* site;
+        uint64_t tsc;
+    };
+
+    explicit StagingBuffer(uint64_t thread_id) : thread_id_(thread_id) {}
+
+    StagingBuffer(const StagingBuffer&) = delete;
+    StagingBuffer& operator=(const StagingBuffer&) = delete;
+
+    // Producer: space for size bytes (a multiple of 8), or nullptr if the
+    // writer has fallen behind; the record is then dropped and counted
+    char* reserve(size_t size) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t offset = tail & MASK;
+        size_t skip = offset + size > CAPACITY ? CAPACITY - offset : 0;
+
+        if (tail + skip + size - cached_head_ > CAPACITY) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail + skip + size - cached_head_ > CAPACITY) {
+                dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+        }
+
+        if (skip > 0) {
+            uint32_t wrap = 0;
+            std::memcpy(data_ + offset, &wrap, sizeof(wrap));
+        }
+        pending_ = skip + size;
+        return data_ + (skip > 0 ? 0 : offset);
+    }
+
+    // Producer: publish the last reserved record
+    void commit() {
+        tail_.store(tail_.load(std::memory_order_relaxed) + pending_, std::memory_order_release);
+    }
+
+    // Consumer: hand every published record to visit, then release the space
+    template<typename Visit>
+    size_t drain(Visit&& visit) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t tail = tail_.load(std::memory_order_acquire);
+        size_t records = 0;
+
+        while (head != tail) {
+            size_t offset = head & MASK;
+            RecordHeader header;
+            std::memcpy(&header.size, data_ + offset, sizeof(header.size));
+            if (header.size == 0) {
+                head += CAPACITY - offset;
+                continue;
+            }
+            std::memcpy(&header, data_ + offset, sizeof(header));
+            visit(header, data_ + offset + sizeof(header), header.size - sizeof(header));
+            head += header.size;
+            records++;
+        }
+
+        head_.store(head, std::memory_order_release);
+        return records;
+    }
+
+    uint64_t thread_id() const { return thread_id_; }
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    // Set by the owning thread as it exits; the writer frees the buffer
+    // once it has drained it
+    void retire() { retired_.store(true, std::memory_order_release); }
+    bool retired() const { return retired_.load(std::memory_order_acquire); }
+
+private:
+    static constexpr size_t MASK = CAPACITY - 1;
+    static_assert((CAPACITY & MASK) == 0, "capacity must be a power of two");
+
+    uint64_t thread_id_;
+    std::atomic<uint64_t> dropped_{0};      // Written by the producer only
+    std::atomic<bool> retired_{false};
+
+    alignas(64) std::atomic<size_t> tail_{0};
+    size_t cached_head_ = 0;
+    size_t pending_ = 0;
+
+    alignas(64) std::atomic<size_t> head_{0};
+
+    alignas(64) char data_[CAPACITY];
+};
+
+inline thread_local StagingBuffer* current_buffer = nullptr;
+
+} // namespace binlog
+
+// Deferred-format ("NanoLog style") logging for hot paths.
+//
+// LOG_FAST_* copies the raw arguments and a TSC stamp into the calling
+// thread's staging buffer, typically tens of nanoseconds; no formatting,
+// no allocation and no shared cache line. The async log writer drains the
+// buffers and either formats the records into the normal sinks or, with a
+// binary log file configured, appends them raw for tools/log_decoder.
+// Records reach the sinks at the writer's pace, so they can interleave
+// slightly out of order with LOG_* messages.
+//
+// Without async logging the macros format synchronously like LOG_*.
+class BinaryLog {
+public:
+    struct Stats {
+        bool active = false;
+        uint64_t dropped = 0;           // Staging buffer full
+        size_t threads = 0;             // Live staging buffers
+        size_t sites = 0;               // Distinct call sites seen by the writer
+    };
+
+    // Formatted record for the text sinks
+    using Emit = std::function<void(spdlog::level::level_enum level, spdlog::log_clock::time_point time,
+                                    uint64_t thread_id, std::string_view text)>;
+
+    // Called by Logger::enable_async(); an empty path formats records in
+    // the writer instead of writing them raw
+    static void start(const std::string& binary_file);
+
+    // Log writer only: drain every staging buffer; returns whether
+    // anything was written
+    static bool drain(const Emit& emit);
+
+    // Log writer only, on exit: switch LOG_FAST to synchronous formatting,
+    // drain once more and close the binary file
+    static void stop(const Emit& emit);
+
+    static bool active() { return active_.load(std::memory_order_acquire); }
+
+    static binlog::StagingBuffer* thread_buffer() {
+        if (!binlog::current_buffer) {
+            binlog::current_buffer = register_thread();
+        }
+        return binlog::current_buffer;
+    }
+
+    static Stats stats();
+
+private:
+    static binlog::StagingBuffer* register_thread();
+
+    static std::atomic<bool> active_;
+};
+
+namespace binlog {
+
+template<typename... Args>
+void write(const Site& site, const Args&... args) {
+    if (!BinaryLog::active()) {
+        Logger::log(site.level, site.format, plain(args)...);
+        return;
+    }
+
+    size_t size = sizeof(StagingBuffer::RecordHeader) + (size_t{0} + ... + encoded_size(args));
+    size = (size + 7) & ~size_t{7};
+
+    StagingBuffer* buffer = BinaryLog::thread_buffer();
+    char* out = buffer->reserve(size);
+    if (!out) {
+        return;
+    }
+
+    StagingBuffer::RecordHeader header{static_cast<uint32_t>(size), 0, &site, TscClock::now()};
+    std::memcpy(out, &header, sizeof(header));
+    [[maybe_unused]] char* cursor = out + sizeof(header);
+    ((cursor = encode(cursor, args)), ...);
+    buffer->commit();
+}
+
+} // namespace binlog
+} // namespace arbitrage
+
+// Format must be a string literal; the placeholder count is checked
+// against the arguments at compile time
+#define ARB_LOG_FAST_EMIT(level, format, ...)                                                   \
+    do {                                                                                        \
+        using ArbLogTypes = decltype(::arbitrage::binlog::type_list(__VA_ARGS__));             \
+        static_assert(::arbitrage::binlog::field_count(format) == ArbLogTypes::size,            \
+                      "LOG_FAST placeholder count does not match its arguments");               \
+        static constexpr ::arbitrage::binlog::Site arb_log_site{                                \
+            level, format, __FILE__, __LINE__, ArbLogTypes::types, ArbLogTypes::size};          \
+        ::arbitrage::binlog::write(arb_log_site __VA_OPT__(,) __VA_ARGS__);                     \
+    } while (0)
+
+#define ARB_LOG_FAST(level, format, ...)                                                        \
+    do {                                                                                        \
+        if constexpr (ARB_LOG_COMPILED(level)) {                                                \
+            if (::arbitrage::Logger::should_log(level)) {                                       \
+                ARB_LOG_FAST_EMIT(level, format __VA_OPT__(,) __VA_ARGS__);                     \
+            }                                                                                   \
+        }                                                                                       \
+    } while (0)
+
+#define LOG_FAST_TRACE(...) ARB_LOG_FAST(spdlog::level::trace, __VA_ARGS__)
+#define LOG_FAST_DEBUG(...) ARB_LOG_FAST(spdlog::level::debug, __VA_ARGS__)
+#define LOG_FAST_INFO(...) ARB_LOG_FAST(spdlog::level::info, __VA_ARGS__)
+#define LOG_FAST_WARN(...) ARB_LOG_FAST(spdlog::level::warn, __VA_ARGS__)
+#define LOG_FAST_ERROR(...) ARB_LOG_FAST(spdlog::level::err, __VA_ARGS__)
+#define LOG_FAST_CRITICAL(...) ARB_LOG_FAST(spdlog::level::critical, __VA_ARGS__)
+
+#define LOG_FAST_INFO_EVERY_N(n, ...) \
+    ARB_LOG_LIMITED(ARB_LOG_FAST_EMIT, LogEveryN, n, spdlog::level::info, __VA_ARGS__)
+#define LOG_FAST_WARN_EVERY_N(n, ...) \
+    ARB_LOG_LIMITED(ARB_LOG_FAST_EMIT, LogEveryN, n, spdlog::level::warn, __VA_ARGS__)
+#define LOG_FAST_INFO_EVERY_MS(ms, ...) \
+    ARB_LOG_LIMITED(ARB_LOG_FAST_EMIT, LogEveryInterval, ms, spdlog::level::info, __VA_ARGS__)
+#define LOG_FAST_WARN_EVERY_MS(ms, ...) \
+    ARB_LOG_LIMITED(ARB_LOG_FAST_EMIT, LogEveryInterval, ms, spdlog::level::warn, __VA_ARGS__)
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <spdlog/fmt/fmt.h>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+namespace arbitrage {
+namespace binlog {
+
+// How one LOG_FAST argument is encoded. Values are part of the file
+// format: append only.
+enum class ArgType : uint8_t {
+    INT,            // int64_t; signed integers and enums
+    UINT,           // uint64_t
+    DOUBLE,
+    BOOL,           // uint64_t 0 / 1
+    CHAR,           // uint64_t
+    STRING,         // uint32_t length, then the bytes
+};
+
+// Binary log file layout (native endianness):
+//   LogFileHeader
+//   { EntryTag, SiteEntry | RecordEntry | AnchorEntry, variable part }...
+// A site is written once, before the first record that uses it. An anchor
+// is written whenever the engine clock re-anchors (about once a second);
+// the records after it map to wall time through it, as the text log does.
+// Version 1 files have no anchors.
+inline constexpr char LOG_MAGIC[8] = {'A', 'R', 'B', 'B', 'L', 'O', 'G', '\0'};
+inline constexpr uint32_t LOG_VERSION = 2;
+
+enum class EntryTag : uint8_t {
+    SITE = 1,
+    RECORD = 2,
+    ANCHOR = 3,
+};
+
+struct LogFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    double ticks_per_nanosecond;    // Converts record tsc deltas to time
+    uint64_t anchor_tsc;            // Taken together with anchor_wall_ns
+    int64_t anchor_wall_ns;         // system_clock, nanoseconds since epoch
+};
+
+// The engine clock's tick -> wall mapping from this point on
+struct AnchorEntry {
+    uint64_t tsc;
+    int64_t wall_ns;                // system_clock, nanoseconds since epoch
+    double ticks_per_nanosecond;
+};
+
+// Followed by arg_count ArgType bytes, the file name and the format string
+struct SiteEntry {
+    uint32_t id;
+    uint32_t line;
+    uint8_t level;                  // spdlog::level::level_enum
+    uint8_t arg_count;
+    uint16_t file_length;
+    uint32_t format_length;
+};
+
+// Followed by payload_size bytes of encoded arguments
+struct RecordEntry {
+    uint32_t site;
+    uint32_t payload_size;
+    uint64_t thread_id;
+    uint64_t tsc;
+};
+
+namespace detail {
+
+template<typename T>
+inline void append_value(std::string& out, std::string_view field, const T& value) {
+    try {
+        fmt::format_to(std::back_inserter(out), fmt::runtime(field), value);
+    } catch (const std::exception&) {
+        out.append(field);          // Spec does not fit the argument type
+    }
+}
+
+} // namespace detail
+
+// Format one record: replacement fields of format take the encoded
+// arguments in order ("{}", "{:.2f}"; explicit indices are not supported).
+// Returns false if the payload is shorter than the types say.
+inline bool format_record(std::string& out, std::string_view format, const ArgType* types,
+                          size_t arg_count, const char* payload, size_t payload_size) {
+    size_t arg = 0;
+    size_t offset = 0;
+
+    for (size_t i = 0; i < format.size(); ++i) {
+        char c = format[i];
+        if ((c == '{' || c == '}') && i + 1 < format.size() && format[i + 1] == c) {
+            out += c;
+            ++i;
+            continue;
+        }
+        if (c != '{') {
+            out += c;
+            continue;
+        }
+
+        size_t close = format.find('}', i);
+        if (close == std::string_view::npos || arg >= arg_count) {
+            out.append(format.substr(i));
+            break;
+        }
+        std::string_view field = format.substr(i, close - i + 1);
+        i = close;
+
+        ArgType type = types[arg++];
+        if (type == ArgType::STRING) {
+            uint32_t length;
+            if (offset + sizeof(length) > payload_size) return false;
+            std::memcpy(&length, payload + offset, sizeof(length));
+            offset += sizeof(length);
+            if (offset + length > payload_size) return false;
+            detail::append_value(out, field, std::string_view(payload + offset, length));
+            offset += length;
+            continue;
+        }
+
+        uint64_t bits;
+        if (offset + sizeof(bits) > payload_size) return false;
+        std::memcpy(&bits, payload + offset, sizeof(bits));
+        offset += sizeof(bits);
+
+        switch (type) {
+            case ArgType::INT: detail::append_value(out, field, static_cast<int64_t>(bits)); break;
+            case ArgType::UINT: detail::append_value(out, field, bits); break;
+            case ArgType::BOOL: detail::append_value(out, field, bits != 0); break;
+            case ArgType::CHAR: detail::append_value(out, field, static_cast<char>(bits)); break;
+            case ArgType::DOUBLE: {
+                double value;
+                std::memcpy(&value, &bits, sizeof(value));
+                detail::append_value(out, field, value);
+                break;
+            }
+            default: out.append(field); break;
+        }
+    }
+    return true;
+}
+
+} // namespace binlog
+} // namespace arbitrage
@@ -0,0 +1,176 @@
+#include "clock.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <cmath>
+
+namespace arbitrage {
+
+std::atomic<uint64_t> Clock::sequence_{0};
+std::atomic<uint64_t> Clock::anchor_tsc_{0};
+std::atomic<int64_t> Clock::anchor_wall_ns_{0};
+std::atomic<uint64_t> Clock::multiplier_{0};
+uint64_t Clock::reanchor_ticks_ = UINT64_MAX;
+uint64_t Clock::base_multiplier_ = 0;
+uint64_t Clock::system_anchor_tsc_ = 0;
+int64_t Clock::system_anchor_ns_ = 0;
+
+namespace {
+
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+} // namespace
+
+int64_t Clock::system_now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+void Clock::calibrate() {
+    TscClock::calibrate();
+
+    // Without a TSC, ticks are steady_clock nanoseconds
+    double ticks_per_ns = TscClock::is_tsc() ? TscClock::ticks_per_nanosecond() : 1.0;
+    base_multiplier_ = static_cast<uint64_t>(static_cast<double>(uint64_t(1) << SHIFT) / ticks_per_ns);
+    reanchor_ticks_ = static_cast<uint64_t>(static_cast<double>(REANCHOR_INTERVAL_NS) * ticks_per_ns);
+
+    uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    system_anchor_tsc_ = ticks();
+    system_anchor_ns_ = system_now_ns();
+    anchor_tsc_.store(system_anchor_tsc_, std::memory_order_relaxed);
+    anchor_wall_ns_.store(system_anchor_ns_, std::memory_order_relaxed);
+    multiplier_.store(base_multiplier_, std::memory_order_relaxed);
+    sequence_.store(sequence + 2, std::memory_order_release);
+
+    LOG_INFO("Clock anchored: {} ticks/ns, re-anchored every {} ms",
+             ticks_per_ns, REANCHOR_INTERVAL_NS / 1'000'000);
+}
+
+bool Clock::read_mapping(Mapping& mapping) {
+    while (true) {
+        mapping.sequence = sequence_.load(std::memory_order_acquire);
+        if (mapping.sequence & 1) {
+            cpu_relax();
+            continue;
+        }
+        mapping.tsc = anchor_tsc_.load(std::memory_order_relaxed);
+        mapping.wall_ns = anchor_wall_ns_.load(std::memory_order_relaxed);
+        mapping.multiplier = multiplier_.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) == mapping.sequence) {
+            return mapping.multiplier != 0;
+        }
+    }
+}
+
+int64_t Clock::map(const Mapping& mapping, Ticks ticks) {
+    // Stamps taken just before a re-anchor land behind the anchor
+    if (ticks >= mapping.tsc) {
+        return mapping.wall_ns + static_cast<int64_t>(
+            (static_cast<uint128>(ticks - mapping.tsc) * mapping.multiplier) >> SHIFT);
+    }
+    return mapping.wall_ns - static_cast<int64_t>(
+        (static_cast<uint128>(mapping.tsc - ticks) * mapping.multiplier) >> SHIFT);
+}
+
+void Clock::reanchor(const Mapping& current) {
+    // One thread re-anchors; the others keep using the current mapping
+    uint64_t sequence = current.sequence;
+    if (!sequence_.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire)) {
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Ticks now = ticks();
+    int64_t system_ns = system_now_ns();
+    int64_t mapped_ns = map(current, now);
+
+    // The startup calibration is short; track the rate system_clock sees
+    if (now > system_anchor_tsc_ && system_ns > system_anchor_ns_) {
+        double measured = static_cast<double>(system_ns - system_anchor_ns_) /
+                          static_cast<double>(now - system_anchor_tsc_) *
+                          static_cast<double>(uint64_t(1) << SHIFT);
+        double base = static_cast<double>(base_multiplier_);
+        if (std::abs(measured - base) <= base * MAX_RATE_CHANGE_PPM * 1e-6) {
+            base_multiplier_ = static_cast<uint64_t>(measured);
+        }
+    }
+    system_anchor_tsc_ = now;
+    system_anchor_ns_ = system_ns;
+    int64_t error_ns = system_ns - mapped_ns;
+
+    // Continue from the current mapping so readers never see a step back;
+    // steer towards system_clock over the next interval
+    int64_t wall_ns = mapped_ns;
+    double slew = 0.0;
+    if (error_ns > STEP_THRESHOLD_NS) {
+        wall_ns = system_ns;
+    } else {
+        slew = std::clamp(static_cast<double>(error_ns) / static_cast<double>(REANCHOR_INTERVAL_NS),
+                          -MAX_SLEW_PPM * 1e-6, MAX_SLEW_PPM * 1e-6);
+    }
+
+    anchor_tsc_.store(now, std::memory_order_relaxed);
+    anchor_wall_ns_.store(wall_ns, std::memory_order_relaxed);
+    multiplier_.store(static_cast<uint64_t>(static_cast<double>(base_multiplier_) * (1.0 + slew)),
+                      std::memory_order_relaxed);
+    sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+Timestamp Clock::now() {
+    thread_local int64_t last_ns = 0;
+
+    Mapping mapping;
+    int64_t ns;
+    if (!read_mapping(mapping)) {
+        ns = system_now_ns();
+    } else {
+        Ticks now = ticks();
+        if (now > mapping.tsc && now - mapping.tsc > reanchor_ticks_) {
+            reanchor(mapping);
+            read_mapping(mapping);
+        }
+        ns = map(mapping, now);
+    }
+
+    // Per-thread monotonic, whatever system_clock does
+    ns = std::max(ns, last_ns);
+    last_ns = ns;
+    return Timestamp(ns);
+}
+
+Timestamp Clock::to_wall(Ticks stamp) {
+    if (stamp == 0) {
+        return Timestamp(0);
+    }
+
+    Mapping mapping;
+    if (!read_mapping(mapping)) {
+        Ticks now = ticks();
+        uint64_t age = now > stamp ? TscClock::to_nanoseconds(now - stamp) : 0;
+        return Timestamp(system_now_ns() - static_cast<int64_t>(age));
+    }
+    return Timestamp(map(mapping, stamp));
+}
+
+bool Clock::current_anchor(Anchor& anchor) {
+    Mapping mapping;
+    if (!read_mapping(mapping)) {
+        return false;
+    }
+    anchor.sequence = mapping.sequence;
+    anchor.tsc = mapping.tsc;
+    anchor.wall_ns = mapping.wall_ns;
+    anchor.ticks_per_nanosecond = static_cast<double>(uint64_t(1) << SHIFT) /
+                                  static_cast<double>(mapping.multiplier);
+    return true;
+}
+
+} // namespace arbitrage
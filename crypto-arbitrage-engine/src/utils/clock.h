@@ -0,0 +1,90 @@
+#pragma once
+
+#include "core/types.h"
+#include "tsc_clock.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace arbitrage {
+
+// Engine clock service.
+//
+// - ticks(): one rdtscp (TscClock), for in-process latency stamps; convert
+//   intervals with TscClock::to_nanoseconds().
+// - now() / to_wall(): wall-clock Timestamps (nanoseconds since the Unix
+//   epoch, comparable with exchange timestamps) derived from ticks through
+//   a tick -> wall mapping. The mapping is re-anchored against
+//   system_clock about once a second by whichever thread first notices it
+//   is due. Each re-anchor re-measures the tick rate against system_clock
+//   and slews out the remaining offset (at most MAX_SLEW_PPM); only a
+//   forward error beyond STEP_THRESHOLD steps the clock.
+// - now() never goes backwards on a thread, even when system_clock is
+//   stepped back; a clock that runs ahead is slewed back into line.
+//
+// Until calibrate() runs, now() reads system_clock directly.
+class Clock {
+public:
+    using Ticks = uint64_t;
+
+    // Calibrate TscClock and take the first anchor; call once at startup
+    // before worker threads run
+    static void calibrate();
+
+    static Ticks ticks() { return TscClock::now(); }
+
+    static Timestamp now();
+
+    // Wall time of an earlier ticks() stamp; 0 maps to Timestamp{0}
+    static Timestamp to_wall(Ticks ticks);
+
+    static bool calibrated() { return multiplier_.load(std::memory_order_acquire) != 0; }
+
+    // The tick -> wall mapping to_wall() uses right now, for code that
+    // converts stamps elsewhere (the binary log). sequence changes with
+    // every re-anchor.
+    struct Anchor {
+        uint64_t sequence;
+        Ticks tsc;
+        int64_t wall_ns;
+        double ticks_per_nanosecond;
+    };
+
+    // False before calibrate()
+    static bool current_anchor(Anchor& anchor);
+
+private:
+    static constexpr unsigned SHIFT = 32;
+    static constexpr int64_t REANCHOR_INTERVAL_NS = 1'000'000'000;
+    static constexpr double MAX_SLEW_PPM = 500.0;
+    static constexpr double MAX_RATE_CHANGE_PPM = 1000.0;  // Larger jumps are clock steps, not drift
+    static constexpr int64_t STEP_THRESHOLD_NS = 100'000'000;
+
+    struct Mapping {
+        uint64_t sequence;
+        uint64_t tsc;
+        int64_t wall_ns;
+        uint64_t multiplier;    // ns per tick, 32.32 fixed point
+    };
+
+    static bool read_mapping(Mapping& mapping);
+    static int64_t map(const Mapping& mapping, Ticks ticks);
+    static void reanchor(const Mapping& current);
+    static int64_t system_now_ns();
+
+    // Seqlock: odd while the single re-anchoring thread rewrites the mapping
+    alignas(64) static std::atomic<uint64_t> sequence_;
+    static std::atomic<uint64_t> anchor_tsc_;
+    static std::atomic<int64_t> anchor_wall_ns_;
+    static std::atomic<uint64_t> multiplier_;
+
+    static uint64_t reanchor_ticks_;    // Written at calibrate() only
+
+    // Re-anchoring thread only: measured tick rate and the previous
+    // system_clock reading it was measured from
+    static uint64_t base_multiplier_;
+    static uint64_t system_anchor_tsc_;
+    static int64_t system_anchor_ns_;
+};
+
+} // namespace arbitrage
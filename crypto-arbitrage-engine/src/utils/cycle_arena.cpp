@@ -0,0 +1,44 @@
+#include "cycle_arena.h"
+#include <algorithm>
+#include <bit>
+
+namespace arbitrage {
+
+CycleArena::CycleArena(size_t initial_capacity)
+    : buffer_(std::make_unique_for_overwrite<std::byte[]>(std::max<size_t>(initial_capacity, 1)))
+    , capacity_(std::max<size_t>(initial_capacity, 1)) {
+    resource_.emplace(buffer_.get(), capacity_, &upstream_);
+}
+
+void CycleArena::reset() {
+    size_t spilled = upstream_.bytes;
+    if (spilled == 0 || capacity_ >= MAX_CAPACITY) {
+        resource_->release();
+        upstream_.bytes = 0;
+        return;
+    }
+
+    // Size the buffer for the whole of the last cycle, rounded up
+    size_t grown = std::min(MAX_CAPACITY, std::bit_ceil(capacity_ + spilled));
+    resource_.reset();
+    buffer_ = std::make_unique_for_overwrite<std::byte[]>(grown);
+    capacity_ = grown;
+    upstream_.bytes = 0;
+    resource_.emplace(buffer_.get(), capacity_, &upstream_);
+}
+
+CycleArena& CycleArena::local() {
+    thread_local CycleArena arena;
+    return arena;
+}
+
+void* CycleArena::SpillResource::do_allocate(size_t bytes_requested, size_t alignment) {
+    bytes += bytes_requested;
+    return std::pmr::new_delete_resource()->allocate(bytes_requested, alignment);
+}
+
+void CycleArena::SpillResource::do_deallocate(void* p, size_t bytes_requested, size_t alignment) {
+    std::pmr::new_delete_resource()->deallocate(p, bytes_requested, alignment);
+}
+
+} // namespace arbitrage
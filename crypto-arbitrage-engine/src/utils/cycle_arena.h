@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+namespace arbitrage {
+
+// Reset-able monotonic arena for the temporaries of one unit of work: a
+// detection cycle, a parsed frame, a risk evaluation.
+//
+// Allocation is a pointer bump into an owned buffer and deallocation is a
+// no-op; reset() drops everything at once. Containers opt in through
+// std::pmr (std::pmr::vector<T> v(arena.resource())) and must not outlive
+// the reset. A cycle that overflows the buffer spills to the heap, and the
+// next reset grows the buffer to cover it, so steady-state cycles never
+// reach malloc. Not thread-safe: one arena per thread of work.
+class CycleArena {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 64 * 1024;
+    static constexpr size_t MAX_CAPACITY = 16 * 1024 * 1024;
+
+    explicit CycleArena(size_t initial_capacity = DEFAULT_CAPACITY);
+
+    CycleArena(const CycleArena&) = delete;
+    CycleArena& operator=(const CycleArena&) = delete;
+
+    std::pmr::memory_resource* resource() noexcept { return &*resource_; }
+
+    // Releases every allocation made since the last reset
+    void reset();
+
+    size_t capacity() const noexcept { return capacity_; }
+
+    // Bytes that went past the buffer to the heap since the last reset
+    size_t spilled_bytes() const noexcept { return upstream_.bytes; }
+
+    // The calling thread's arena, for work that may run on any thread
+    static CycleArena& local();
+
+    // Marks one unit of work; the arena is reset when the outermost scope
+    // exits, so nested scopes on the same arena are free
+    class Scope {
+    public:
+        explicit Scope(CycleArena& arena) noexcept : arena_(arena) { arena_.depth_++; }
+        ~Scope() {
+            if (--arena_.depth_ == 0) {
+                arena_.reset();
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        std::pmr::memory_resource* resource() noexcept { return arena_.resource(); }
+
+    private:
+        CycleArena& arena_;
+    };
+
+private:
+    // Heap fallback that records how far a cycle overflowed
+    struct SpillResource : std::pmr::memory_resource {
+        size_t bytes = 0;
+
+        void* do_allocate(size_t bytes_requested, size_t alignment) override;
+        void do_deallocate(void* p, size_t bytes_requested, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+    std::unique_ptr<std::byte[]> buffer_;
+    size_t capacity_;
+    SpillResource upstream_;
+    std::optional<std::pmr::monotonic_buffer_resource> resource_;
+    uint32_t depth_ = 0;
+};
+
+} // namespace arbitrage
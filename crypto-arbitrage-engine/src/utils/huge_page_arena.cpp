@@ -0,0 +1,310 @@
+#include "huge_page_arena.h"
+#include "utils/logger.h"
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/mman.h>
+
+namespace arbitrage {
+
+namespace {
+
+constexpr size_t SMALL_PAGE_SIZE = 4096;
+
+size_t round_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// Bump allocator over the mapped region. The pool resource above it
+// recycles small blocks itself but passes blocks larger than its biggest
+// pool straight through, so freed ranges go on a free list (coalesced,
+// first fit) and are reused before the bump pointer moves on.
+class RegionResource : public std::pmr::memory_resource {
+public:
+    RegionResource(char* base, size_t size) : base_(base), size_(size) {}
+
+    // Bytes handed out and not returned (alignment padding included)
+    size_t used() const {
+        return used_.load(std::memory_order_relaxed) - free_bytes_.load(std::memory_order_relaxed);
+    }
+    size_t fallback() const { return fallback_.load(std::memory_order_relaxed); }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (void* block = take_free(bytes, alignment)) {
+                return block;
+            }
+
+            size_t offset = round_up(used_.load(std::memory_order_relaxed), alignment);
+            if (offset + bytes <= size_) {
+                used_.store(offset + bytes, std::memory_order_relaxed);
+                return base_ + offset;
+            }
+        }
+
+        fallback_.fetch_add(bytes, std::memory_order_relaxed);
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        char* address = static_cast<char*>(p);
+        if (address >= base_ && address < base_ + size_) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            give_back(static_cast<size_t>(address - base_), bytes);
+            return;
+        }
+
+        fallback_.fetch_sub(bytes, std::memory_order_relaxed);
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    // First free range that fits once aligned; the unused ends stay free
+    void* take_free(size_t bytes, size_t alignment) {
+        for (auto it = free_.begin(); it != free_.end(); ++it) {
+            size_t begin = it->first;
+            size_t end = begin + it->second;
+            size_t start = round_up(begin, alignment);
+            if (start + bytes > end) continue;
+
+            free_.erase(it);
+            if (start > begin) {
+                free_.emplace(begin, start - begin);
+            }
+            if (start + bytes < end) {
+                free_.emplace(start + bytes, end - start - bytes);
+            }
+            free_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+            return base_ + start;
+        }
+        return nullptr;
+    }
+
+    void give_back(size_t offset, size_t bytes) {
+        size_t freed = bytes;
+
+        auto next = free_.lower_bound(offset);
+        if (next != free_.end() && offset + bytes == next->first) {
+            bytes += next->second;
+            next = free_.erase(next);
+        }
+        if (next != free_.begin()) {
+            auto previous = std::prev(next);
+            if (previous->first + previous->second == offset) {
+                offset = previous->first;
+                bytes += previous->second;
+                free_.erase(previous);
+            }
+        }
+
+        // A range ending at the bump pointer goes back to it
+        if (offset + bytes == used_.load(std::memory_order_relaxed)) {
+            used_.store(offset, std::memory_order_relaxed);
+            free_bytes_.fetch_sub(bytes - freed, std::memory_order_relaxed);
+            return;
+        }
+        free_.emplace(offset, bytes);
+        free_bytes_.fetch_add(freed, std::memory_order_relaxed);
+    }
+
+    char* base_;
+    size_t size_;
+    std::mutex mutex_;
+    std::map<size_t, size_t> free_;         // Offset -> length, never adjacent
+    std::atomic<size_t> used_{0};           // Bump pointer
+    std::atomic<size_t> free_bytes_{0};     // On free_, below the bump pointer
+    std::atomic<size_t> fallback_{0};       // Live bytes served by the heap
+};
+
+struct ArenaState {
+    std::mutex mutex;
+    bool configured = false;
+    HugePageArena::Backing backing = HugePageArena::Backing::DISABLED;
+    char* base = nullptr;
+    size_t size = 0;
+    bool locked = false;
+
+    std::unique_ptr<RegionResource> region;
+    std::unique_ptr<std::pmr::synchronized_pool_resource> pool;
+    std::atomic<std::pmr::memory_resource*> resource{std::pmr::new_delete_resource()};
+};
+
+ArenaState& state() {
+    static ArenaState* instance = new ArenaState();     // Outlives pools destroyed at exit
+    return *instance;
+}
+
+void* map_hugetlb(size_t size) {
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE;
+#ifdef MAP_HUGE_2MB
+    flags |= MAP_HUGE_2MB;
+#endif
+    void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+    return address == MAP_FAILED ? nullptr : address;
+}
+
+// Maps size bytes aligned to a huge page boundary, so khugepaged can back
+// every 2 MiB of it
+void* map_transparent(size_t size) {
+    size_t padded = size + HugePageArena::HUGE_PAGE_SIZE;
+    void* raw = mmap(nullptr, padded, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        return nullptr;
+    }
+
+    char* start = static_cast<char*>(raw);
+    char* aligned = reinterpret_cast<char*>(
+        round_up(reinterpret_cast<uintptr_t>(start), HugePageArena::HUGE_PAGE_SIZE));
+    if (aligned > start) {
+        munmap(start, aligned - start);
+    }
+    char* end = aligned + size;
+    if (end < start + padded) {
+        munmap(end, start + padded - end);
+    }
+
+    if (madvise(aligned, size, MADV_HUGEPAGE) != 0) {
+        LOG_WARN("madvise(MADV_HUGEPAGE) failed: {}", std::strerror(errno));
+    }
+
+    // Pre-fault; with THP available each first touch brings in a 2 MiB page
+    for (size_t offset = 0; offset < size; offset += SMALL_PAGE_SIZE) {
+        aligned[offset] = 0;
+    }
+    return aligned;
+}
+
+// AnonHugePages summed over the mappings inside [base, base + size)
+size_t transparent_huge_bytes(const char* base, size_t size) {
+    std::ifstream smaps("/proc/self/smaps");
+    auto begin = reinterpret_cast<uintptr_t>(base);
+    auto end = begin + size;
+
+    size_t total_kb = 0;
+    bool inside = false;
+    std::string line;
+    while (std::getline(smaps, line)) {
+        if (line.empty()) continue;
+
+        // Mapping headers start with "start-end"; field lines with a name
+        size_t dash = line.find('-');
+        if (dash != std::string::npos && dash < line.find(' ') &&
+            std::isxdigit(static_cast<unsigned char>(line[0]))) {
+            uintptr_t start = std::stoull(line.substr(0, dash), nullptr, 16);
+            inside = start >= begin && start < end;
+        } else if (inside && line.rfind("AnonHugePages:", 0) == 0) {
+            total_kb += std::stoull(line.substr(14));
+        }
+    }
+    return total_kb * 1024;
+}
+
+} // namespace
+
+void HugePageArena::configure(const Config& config) {
+    auto& arena = state();
+    std::lock_guard<std::mutex> lock(arena.mutex);
+    if (arena.configured) {
+        return;
+    }
+    arena.configured = true;
+
+    if (!config.enabled || config.size_bytes == 0) {
+        return;
+    }
+
+    size_t size = round_up(config.size_bytes, HUGE_PAGE_SIZE);
+    void* base = map_hugetlb(size);
+    Backing backing = Backing::HUGETLB;
+    if (!base) {
+        LOG_INFO("No explicit huge pages for a {} MiB arena ({}), using transparent huge pages",
+                 size >> 20, std::strerror(errno));
+        base = map_transparent(size);
+        backing = Backing::TRANSPARENT;
+    }
+
+    if (!base) {
+        LOG_WARN("Failed to map huge page arena: {}", std::strerror(errno));
+        return;
+    }
+
+    arena.base = static_cast<char*>(base);
+    arena.size = size;
+    arena.backing = backing;
+
+    if (config.lock) {
+        if (mlock(base, size) == 0) {
+            arena.locked = true;
+        } else {
+            LOG_WARN("Failed to mlock huge page arena: {}", std::strerror(errno));
+        }
+    }
+
+    std::pmr::pool_options options;
+    options.largest_required_pool_block = HUGE_PAGE_SIZE / 2;
+    arena.region = std::make_unique<RegionResource>(arena.base, size);
+    arena.pool = std::make_unique<std::pmr::synchronized_pool_resource>(options, arena.region.get());
+    arena.resource.store(arena.pool.get(), std::memory_order_release);
+
+    size_t huge_bytes = backing == Backing::HUGETLB
+        ? size
+        : transparent_huge_bytes(arena.base, size);
+    LOG_INFO("Huge page arena: {} MiB, {} backing, {} MiB on huge pages{}",
+             size >> 20, backing_name(backing), huge_bytes >> 20,
+             arena.locked ? ", locked" : "");
+}
+
+std::pmr::memory_resource* HugePageArena::resource() {
+    return state().resource.load(std::memory_order_acquire);
+}
+
+HugePageArena::Stats HugePageArena::stats() {
+    auto& arena = state();
+    std::lock_guard<std::mutex> lock(arena.mutex);
+    Stats stats;
+    if (!arena.region) {
+        return stats;
+    }
+
+    stats.backing = arena.backing;
+    stats.reserved_bytes = arena.size;
+    stats.huge_page_bytes = arena.backing == Backing::HUGETLB
+        ? arena.size
+        : transparent_huge_bytes(arena.base, arena.size);
+    stats.used_bytes = arena.region->used();
+    stats.fallback_bytes = arena.region->fallback();
+    stats.locked = arena.locked;
+    return stats;
+}
+
+const char* HugePageArena::backing_name(Backing backing) {
+    switch (backing) {
+        case Backing::HUGETLB: return "hugetlb";
+        case Backing::TRANSPARENT: return "transparent";
+        default: return "disabled";
+    }
+}
+
+void HugePageArena::advise(void* address, size_t length) {
+    auto& arena = state();
+    std::lock_guard<std::mutex> lock(arena.mutex);
+    if (arena.backing != Backing::DISABLED) {
+        madvise(address, length, MADV_HUGEPAGE);
+    }
+}
+
+} // namespace arbitrage
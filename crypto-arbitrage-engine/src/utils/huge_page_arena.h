@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace arbitrage {
+
+// Process-wide region of 2 MiB pages for long-lived hot structures: order
+// books, the top-of-book table, pool chunks.
+//
+// configure() maps the whole region once at startup, with MAP_HUGETLB when
+// the system has huge pages reserved and otherwise as ordinary anonymous
+// memory advised with MADV_HUGEPAGE (transparent huge pages). The region is
+// pre-faulted, so no page fault lands on the hot path, and optionally
+// mlock()ed. resource() hands out blocks from it through a synchronized pool
+// resource, so freed blocks are reused for the same size class; blocks over
+// half a huge page bypass the pools and are recycled through the region's
+// own free list. Allocations the region cannot fit fall back to the heap and
+// are counted.
+//
+// Until configure() runs, or when disabled, resource() is the ordinary
+// new/delete resource, so callers need no special casing.
+class HugePageArena {
+public:
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    struct Config {
+        bool enabled = false;
+        size_t size_bytes = 64 * 1024 * 1024;     // Rounded up to whole huge pages
+        bool lock = false;                        // mlock() the region
+    };
+
+    enum class Backing {
+        DISABLED,
+        HUGETLB,            // Explicit huge pages from the hugetlbfs pool
+        TRANSPARENT,        // madvise(MADV_HUGEPAGE); actual coverage in Stats
+    };
+
+    struct Stats {
+        Backing backing = Backing::DISABLED;
+        size_t reserved_bytes = 0;
+        size_t huge_page_bytes = 0;         // Portion actually backed by huge pages
+        size_t used_bytes = 0;              // Carved from the region and not freed
+        size_t fallback_bytes = 0;          // Served by the heap once the region ran out
+        bool locked = false;
+    };
+
+    // Call once at startup, before the structures that should live in the
+    // region are created; later calls are ignored
+    static void configure(const Config& config);
+
+    static std::pmr::memory_resource* resource();
+
+    // Huge-page coverage is read from /proc/self/smaps for transparent
+    // backing, so this is not for the hot path
+    static Stats stats();
+
+    static const char* backing_name(Backing backing);
+
+    // Ask for transparent huge pages on a range mapped elsewhere (pool
+    // reservations); no-op unless the arena is enabled
+    static void advise(void* address, size_t length);
+};
+
+} // namespace arbitrage
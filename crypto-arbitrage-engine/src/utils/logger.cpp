@@ -1,12 +1,148 @@
 #include "logger.h"
 #include "core/constants.h"
+#include "core/ring_buffer.h"
+#include "utils/binary_log.h"
+#include "utils/thread_registry.h"
+#include "utils/wait_strategy.h"
+#include <spdlog/details/os.h>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <filesystem>
+#include <thread>
 
 namespace arbitrage {
 
 std::shared_ptr<spdlog::logger> Logger::logger_;
 std::once_flag Logger::init_flag_;
+std::atomic<bool> Logger::async_{false};
+
+namespace {
+
+struct AsyncRecord {
+    AsyncRecord() = default;
+    
+    // Stamped on the calling thread, so the writer's delay does not skew
+    // timestamps or %t
+    AsyncRecord(spdlog::level::level_enum level_, std::string_view message, bool truncated = false)
+        : time(spdlog::log_clock::now())
+        , thread_id(spdlog::details::os::thread_id())
+        , level(level_)
+        , length(static_cast<uint32_t>(std::min(message.size(), sizeof(text)))) {
+        std::memcpy(text, message.data(), length);
+        if (truncated || message.size() > sizeof(text)) {
+            std::memcpy(text + length - 3, "...", 3);
+        }
+    }
+    
+    spdlog::log_clock::time_point time;
+    size_t thread_id = 0;
+    spdlog::level::level_enum level = spdlog::level::info;
+    uint32_t length = 0;
+    char text[constants::logging::ASYNC_MESSAGE_SIZE];
+};
+
+using AsyncQueue = MpscRing<AsyncRecord, constants::logging::ASYNC_QUEUE_SIZE>;
+
+// Producers check the queue depth this often; past half full they wake
+// the writer instead of leaving it to its flush interval
+constexpr uint32_t DEPTH_CHECK_INTERVAL = 64;
+
+thread_local bool on_writer_thread = false;
+
+struct AsyncState {
+    std::unique_ptr<AsyncQueue> queue;
+    WakeSignal signal;
+    std::thread writer;
+    std::atomic<bool> stopping{false};
+    std::mutex shutdown_mutex;
+    
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> truncated{0};
+    
+    // flush(): callers take a ticket, the writer completes tickets after
+    // draining everything queued before them
+    std::atomic<uint64_t> flush_requested{0};
+    std::atomic<uint64_t> flush_completed{0};
+};
+
+AsyncState& async_state() {
+    static AsyncState* instance = new AsyncState();     // Threads may log during exit
+    return *instance;
+}
+
+void write_message(spdlog::logger& logger, spdlog::level::level_enum level,
+                   spdlog::log_clock::time_point time, size_t thread_id, std::string_view text) {
+    spdlog::details::log_msg message(time, spdlog::source_loc{}, logger.name(), level,
+                                     spdlog::string_view_t(text.data(), text.size()));
+    message.thread_id = thread_id;              // %t shows the producer, not the writer
+    
+    for (const auto& sink : logger.sinks()) {
+        if (sink->should_log(message.level)) {
+            sink->log(message);
+        }
+    }
+}
+
+void write_record(spdlog::logger& logger, const AsyncRecord& record) {
+    write_message(logger, record.level, record.time, record.thread_id,
+                  std::string_view(record.text, record.length));
+}
+
+void writer_loop(std::shared_ptr<spdlog::logger> logger) {
+    on_writer_thread = true;
+    ThreadRegistry::instance().register_current_thread("log-writer", ThreadRole::LOGGER);
+    
+    auto& state = async_state();
+    WaitStrategy wait(WaitStrategy::for_role(ThreadRole::LOGGER));
+    auto interval = std::chrono::milliseconds(constants::logging::ASYNC_FLUSH_INTERVAL_MS);
+    AsyncRecord record;
+    uint64_t reported_drops = 0;
+    
+    BinaryLog::Emit emit = [&logger](spdlog::level::level_enum level, spdlog::log_clock::time_point time,
+                                     uint64_t thread_id, std::string_view text) {
+        write_message(*logger, level, time, static_cast<size_t>(thread_id), text);
+    };
+    
+    while (true) {
+        uint32_t seen = state.signal.epoch();
+        uint64_t flush_ticket = state.flush_requested.load(std::memory_order_acquire);
+        bool stopping = state.stopping.load(std::memory_order_acquire);
+        
+        bool wrote = false;
+        while (state.queue->pop(record)) {
+            write_record(*logger, record);
+            wrote = true;
+        }
+        
+        if (BinaryLog::drain(emit)) {
+            wrote = true;
+        }
+        
+        uint64_t drops = state.dropped.load(std::memory_order_relaxed);
+        if (drops != reported_drops) {
+            std::string notice = "Async log queue full: dropped " +
+                                 std::to_string(drops - reported_drops) + " messages";
+            write_record(*logger, AsyncRecord(spdlog::level::warn, notice));
+            reported_drops = drops;
+            wrote = true;
+        }
+        
+        if (wrote || flush_ticket != state.flush_completed.load(std::memory_order_relaxed)) {
+            logger->flush();
+            state.flush_completed.store(flush_ticket, std::memory_order_release);
+        }
+        
+        if (stopping) {
+            BinaryLog::stop(emit);
+            return;
+        }
+        
+        wait.wait(state.signal, seen, WaitStrategy::Clock::now() + interval);
+    }
+}
+
+} // namespace
 
 void Logger::initialize() {
     // Default initialization
@@ -103,10 +239,94 @@ void Logger::set_level(const std::string& level) {
     logger_->flush_on(log_level);
 }
 
+void Logger::enable_async(const std::string& binary_log_file) {
+    const auto& logger = get();
+    auto& state = async_state();
+    std::lock_guard<std::mutex> lock(state.shutdown_mutex);
+    if (state.queue) {
+        return;
+    }
+    
+    state.queue = std::make_unique<AsyncQueue>();
+    BinaryLog::start(binary_log_file);
+    state.writer = std::thread(writer_loop, logger);
+    async_.store(true, std::memory_order_release);
+    
+    // Drain on every exit path, not only a clean return from main
+    std::atexit(&Logger::shutdown);
+    
+    LOG_INFO("Async logging: {} slots of {} bytes", AsyncQueue::capacity(), sizeof(AsyncRecord));
+}
+
+void Logger::submit(spdlog::level::level_enum level, std::string_view text, bool truncated) {
+    auto& state = async_state();
+    
+    if (!state.queue->try_emplace(level, text, truncated)) {
+        // Never block a hot thread on the log; the writer reports the gap
+        state.dropped.fetch_add(1, std::memory_order_relaxed);
+        state.signal.notify_one();
+        return;
+    }
+    
+    if (truncated || text.size() > constants::logging::ASYNC_MESSAGE_SIZE) {
+        state.truncated.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    // Errors are written promptly; otherwise the writer only needs waking
+    // when the queue is filling faster than its flush interval drains it
+    thread_local uint32_t submitted = 0;
+    if (level >= spdlog::level::err ||
+        (++submitted % DEPTH_CHECK_INTERVAL == 0 && state.queue->size() > AsyncQueue::capacity() / 2)) {
+        state.signal.notify_one();
+    }
+}
+
 void Logger::flush() {
-    if (logger_) {
+    if (!logger_) {
+        return;
+    }
+    
+    auto& state = async_state();
+    if (!async_.load(std::memory_order_acquire) || on_writer_thread) {
         logger_->flush();
+        return;
+    }
+    
+    uint64_t ticket = state.flush_requested.fetch_add(1, std::memory_order_acq_rel) + 1;
+    state.signal.notify_one();
+    while (state.flush_completed.load(std::memory_order_acquire) < ticket &&
+           !state.stopping.load(std::memory_order_acquire)) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+void Logger::shutdown() {
+    auto& state = async_state();
+    std::lock_guard<std::mutex> lock(state.shutdown_mutex);
+    if (!state.writer.joinable()) {
+        return;
+    }
+    
+    // Later messages (static destructors, leaky singletons) go out directly
+    // while the writer drains what is already queued
+    async_.store(false, std::memory_order_release);
+    
+    state.stopping.store(true, std::memory_order_release);
+    state.signal.notify_one();
+    state.writer.join();
+}
+
+Logger::AsyncStats Logger::async_stats() {
+    auto& state = async_state();
+    AsyncStats stats;
+    stats.enabled = async_.load(std::memory_order_acquire);
+    stats.dropped = state.dropped.load(std::memory_order_relaxed);
+    stats.truncated = state.truncated.load(std::memory_order_relaxed);
+    if (state.queue) {
+        stats.queue_depth = state.queue->size();
+        stats.queue_capacity = AsyncQueue::capacity();
     }
+    return stats;
 }
 
 } // namespace arbitrage
\ No newline at end of file
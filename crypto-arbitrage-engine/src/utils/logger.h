@@ -4,66 +4,233 @@
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/rotating_file_sink.h>
+#include "core/constants.h"
+#include "utils/tsc_clock.h"
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <string>
+#include <string_view>
 
 namespace arbitrage {
 
+// Engine logger over spdlog.
+//
+// Synchronous by default: the calling thread formats and writes to the
+// sinks. In async mode the calling thread only formats the message into a
+// stack buffer and pushes a fixed-size record onto a preallocated MPSC
+// ring; a dedicated writer thread (role "logger", so it can be pinned)
+// applies the pattern, writes the sinks and flushes. A full ring never
+// blocks the caller: the record is dropped and counted, and the writer
+// reports the drop count in the log itself.
 class Logger {
 private:
     static std::shared_ptr<spdlog::logger> logger_;
     static std::once_flag init_flag_;
+    static std::atomic<bool> async_;
     
     static void initialize();
     
+    // Async mode: queue one formatted message for the writer thread
+    static void submit(spdlog::level::level_enum level, std::string_view text, bool truncated);
+    
 public:
+    struct AsyncStats {
+        bool enabled = false;
+        uint64_t dropped = 0;               // Ring full at submit
+        uint64_t truncated = 0;             // Longer than ASYNC_MESSAGE_SIZE
+        size_t queue_depth = 0;
+        size_t queue_capacity = 0;
+    };
+    
     static void init(const std::string& log_file, const std::string& log_level);
     
-    static std::shared_ptr<spdlog::logger> get() {
+    // Switch to async mode and start the writer thread. Call after thread
+    // placement and wait strategies are configured so the writer picks up
+    // its role's settings; later calls are ignored. The writer also drains
+    // LOG_FAST records (utils/binary_log.h), raw into binary_log_file if
+    // one is given.
+    static void enable_async(const std::string& binary_log_file = {});
+    
+    static const std::shared_ptr<spdlog::logger>& get() {
         std::call_once(init_flag_, &Logger::initialize);
         return logger_;
     }
     
+    static bool should_log(spdlog::level::level_enum level) {
+        return get()->should_log(level);
+    }
+    
+    template<typename... Args>
+    static void log(spdlog::level::level_enum level, std::string_view fmt, Args&&... args) {
+        const auto& logger = get();
+        if (!logger->should_log(level)) {
+            return;
+        }
+        
+        if (!async_.load(std::memory_order_acquire)) {
+            logger->log(level, fmt::runtime(fmt), std::forward<Args>(args)...);
+            return;
+        }
+        
+        char buffer[constants::logging::ASYNC_MESSAGE_SIZE];
+        try {
+            auto result = fmt::format_to_n(buffer, sizeof(buffer), fmt::runtime(fmt),
+                                           std::forward<Args>(args)...);
+            size_t length = std::min(result.size, sizeof(buffer));
+            submit(level, std::string_view(buffer, length), result.size > sizeof(buffer));
+        } catch (const std::exception&) {
+            submit(level, fmt, false);      // Bad format string: keep the raw text
+        }
+    }
+    
     template<typename... Args>
-    static void trace(const std::string& fmt, Args&&... args) {
-        get()->trace(fmt, std::forward<Args>(args)...);
+    static void trace(std::string_view fmt, Args&&... args) {
+        log(spdlog::level::trace, fmt, std::forward<Args>(args)...);
     }
     
     template<typename... Args>
-    static void debug(const std::string& fmt, Args&&... args) {
-        get()->debug(fmt, std::forward<Args>(args)...);
+    static void debug(std::string_view fmt, Args&&... args) {
+        log(spdlog::level::debug, fmt, std::forward<Args>(args)...);
     }
     
     template<typename... Args>
-    static void info(const std::string& fmt, Args&&... args) {
-        get()->info(fmt, std::forward<Args>(args)...);
+    static void info(std::string_view fmt, Args&&... args) {
+        log(spdlog::level::info, fmt, std::forward<Args>(args)...);
     }
     
     template<typename... Args>
-    static void warn(const std::string& fmt, Args&&... args) {
-        get()->warn(fmt, std::forward<Args>(args)...);
+    static void warn(std::string_view fmt, Args&&... args) {
+        log(spdlog::level::warn, fmt, std::forward<Args>(args)...);
     }
     
     template<typename... Args>
-    static void error(const std::string& fmt, Args&&... args) {
-        get()->error(fmt, std::forward<Args>(args)...);
+    static void error(std::string_view fmt, Args&&... args) {
+        log(spdlog::level::err, fmt, std::forward<Args>(args)...);
     }
     
     template<typename... Args>
-    static void critical(const std::string& fmt, Args&&... args) {
-        get()->critical(fmt, std::forward<Args>(args)...);
+    static void critical(std::string_view fmt, Args&&... args) {
+        log(spdlog::level::critical, fmt, std::forward<Args>(args)...);
     }
     
     static void set_level(const std::string& level);
+    
+    // In async mode, waits until everything queued so far is written
     static void flush();
+    
+    // Drain the async queue, stop the writer and fall back to synchronous
+    // logging. Runs at exit; safe to call more than once.
+    static void shutdown();
+    
+    static AsyncStats async_stats();
+};
+
+// Per-call-site state for LOG_*_EVERY_N: admits the 1st, (n+1)th, ...
+// call; n of 0 or 1 admits every call. Shared by every thread reaching the
+// site.
+class LogEveryN {
+public:
+    bool admit(uint64_t n, uint64_t& suppressed) {
+        uint64_t count = count_.fetch_add(1, std::memory_order_relaxed);
+        if (n > 1 && count % n != 0) {
+            return false;
+        }
+        suppressed = count == 0 || n <= 1 ? 0 : n - 1;
+        return true;
+    }
+    
+private:
+    std::atomic<uint64_t> count_{0};
+};
+
+// Per-call-site state for LOG_*_EVERY_MS: at most one call per interval,
+// counting the ones in between
+class LogEveryInterval {
+public:
+    bool admit(uint64_t interval_ms, uint64_t& suppressed) {
+        uint64_t last = last_.load(std::memory_order_relaxed);     // Before now: last <= now
+        uint64_t now = TscClock::now();
+        if ((last != 0 && TscClock::to_nanoseconds(now - last) < interval_ms * 1000000) ||
+            !last_.compare_exchange_strong(last, now, std::memory_order_relaxed)) {
+            suppressed_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        suppressed = suppressed_.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+    
+private:
+    std::atomic<uint64_t> last_{0};
+    std::atomic<uint64_t> suppressed_{0};
 };
 
+} // namespace arbitrage
+
+// Build-time floor (CMake LOG_MIN_LEVEL, an spdlog level number): log
+// statements below it compile to nothing, arguments included
+#ifndef ARB_LOG_MIN_LEVEL
+#define ARB_LOG_MIN_LEVEL SPDLOG_LEVEL_TRACE
+#endif
+
+#define ARB_LOG_COMPILED(level) (static_cast<int>(level) >= ARB_LOG_MIN_LEVEL)
+
+#define ARB_LOG_EMIT(level, ...) ::arbitrage::Logger::log(level, __VA_ARGS__)
+
+// Arguments are only evaluated when the runtime level lets the message
+// through
+#define ARB_LOG(level, ...)                                                                     \
+    do {                                                                                        \
+        if constexpr (ARB_LOG_COMPILED(level)) {                                                \
+            if (::arbitrage::Logger::should_log(level)) {                                       \
+                ARB_LOG_EMIT(level, __VA_ARGS__);                                               \
+            }                                                                                   \
+        }                                                                                       \
+    } while (0)
+
+// Rate-limited variants: a per-call-site limiter decides, and an admitted
+// message carries the number of calls dropped since the previous one.
+// emit is ARB_LOG_EMIT or ARB_LOG_FAST_EMIT; format must be a literal.
+#define ARB_LOG_LIMITED(emit, limiter, limit, level, format, ...)                               \
+    do {                                                                                        \
+        if constexpr (ARB_LOG_COMPILED(level)) {                                                \
+            if (::arbitrage::Logger::should_log(level)) {                                       \
+                static ::arbitrage::limiter arb_log_limiter;                                    \
+                uint64_t arb_log_suppressed = 0;                                                \
+                if (arb_log_limiter.admit(limit, arb_log_suppressed)) {                         \
+                    if (arb_log_suppressed == 0) {                                              \
+                        emit(level, format __VA_OPT__(,) __VA_ARGS__);                          \
+                    } else {                                                                    \
+                        emit(level, format " ({} similar suppressed)" __VA_OPT__(,) __VA_ARGS__, \
+                             arb_log_suppressed);                                               \
+                    }                                                                           \
+                }                                                                               \
+            }                                                                                   \
+        }                                                                                       \
+    } while (0)
+
 // Convenience macros
-#define LOG_TRACE(...) arbitrage::Logger::trace(__VA_ARGS__)
-#define LOG_DEBUG(...) arbitrage::Logger::debug(__VA_ARGS__)
-#define LOG_INFO(...) arbitrage::Logger::info(__VA_ARGS__)
-#define LOG_WARN(...) arbitrage::Logger::warn(__VA_ARGS__)
-#define LOG_ERROR(...) arbitrage::Logger::error(__VA_ARGS__)
-#define LOG_CRITICAL(...) arbitrage::Logger::critical(__VA_ARGS__)
+#define LOG_TRACE(...) ARB_LOG(spdlog::level::trace, __VA_ARGS__)
+#define LOG_DEBUG(...) ARB_LOG(spdlog::level::debug, __VA_ARGS__)
+#define LOG_INFO(...) ARB_LOG(spdlog::level::info, __VA_ARGS__)
+#define LOG_WARN(...) ARB_LOG(spdlog::level::warn, __VA_ARGS__)
+#define LOG_ERROR(...) ARB_LOG(spdlog::level::err, __VA_ARGS__)
+#define LOG_CRITICAL(...) ARB_LOG(spdlog::level::critical, __VA_ARGS__)
+
+#define LOG_DEBUG_EVERY_N(n, ...) \
+    ARB_LOG_LIMITED(ARB_LOG_EMIT, LogEveryN, n, spdlog::level::debug, __VA_ARGS__)
+#define LOG_INFO_EVERY_N(n, ...) \
+    ARB_LOG_LIMITED(ARB_LOG_EMIT, LogEveryN, n, spdlog::level::info, __VA_ARGS__)
+#define LOG_WARN_EVERY_N(n, ...) \
+    ARB_LOG_LIMITED(ARB_LOG_EMIT, LogEveryN, n, spdlog::level::warn, __VA_ARGS__)
+#define LOG_ERROR_EVERY_N(n, ...) \
+    ARB_LOG_LIMITED(ARB_LOG_EMIT, LogEveryN, n, spdlog::level::err, __VA_ARGS__)
 
-} // namespace arbitrage
\ No newline at end of file
+#define LOG_DEBUG_EVERY_MS(ms, ...) \
+    ARB_LOG_LIMITED(ARB_LOG_EMIT, LogEveryInterval, ms, spdlog::level::debug, __VA_ARGS__)
+#define LOG_INFO_EVERY_MS(ms, ...) \
+    ARB_LOG_LIMITED(ARB_LOG_EMIT, LogEveryInterval, ms, spdlog::level::info, __VA_ARGS__)
+#define LOG_WARN_EVERY_MS(ms, ...) \
+    ARB_LOG_LIMITED(ARB_LOG_EMIT, LogEveryInterval, ms, spdlog::level::warn, __VA_ARGS__)
+#define LOG_ERROR_EVERY_MS(ms, ...) \
+    ARB_LOG_LIMITED(ARB_LOG_EMIT, LogEveryInterval, ms, spdlog::level::err, __VA_ARGS__)
@@ -1,134 +1,438 @@
 #pragma once
 
 #include <memory>
+#include <new>
 #include <vector>
-#include <stack>
 #include <mutex>
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <type_traits>
+#include <unordered_set>
+#include <sys/mman.h>
 #include "core/constants.h"
+#include "utils/huge_page_arena.h"
 
 namespace arbitrage {
 
-template<typename T>
+// Intrusive lock-free (Treiber) stack.
+//
+// The head packs a 48-bit node pointer with a 16-bit modification tag, so a
+// pop that raced with another pop and re-push of the same node fails its
+// CAS instead of corrupting the list (ABA). Node needs a
+// std::atomic<Node*> next member, and nodes must stay readable for as long
+// as the stack is in use: they are only freed together with their owner.
+template<typename Node>
+class TaggedStack {
+public:
+    static_assert(sizeof(void*) == 8, "TaggedStack packs pointers into 48 bits");
+    
+    void push(Node* node) {
+        push_chain(node, node);
+    }
+    
+    // Push first..last, already linked through next, with one CAS
+    void push_chain(Node* first, Node* last) {
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        do {
+            last->next.store(unpack(head), std::memory_order_relaxed);
+        } while (!head_.compare_exchange_weak(head, pack(first, head), std::memory_order_release,
+                                              std::memory_order_relaxed));
+    }
+    
+    Node* pop() {
+        uint64_t head = head_.load(std::memory_order_acquire);
+        while (Node* node = unpack(head)) {
+            // May be stale if node was popped meanwhile; the tag then fails the CAS
+            Node* next = node->next.load(std::memory_order_relaxed);
+            if (head_.compare_exchange_weak(head, pack(next, head), std::memory_order_acquire,
+                                            std::memory_order_acquire)) {
+                return node;
+            }
+        }
+        return nullptr;
+    }
+    
+    // Detach every node at once
+    Node* pop_all() {
+        uint64_t head = head_.load(std::memory_order_acquire);
+        while (unpack(head) &&
+               !head_.compare_exchange_weak(head, pack(nullptr, head), std::memory_order_acquire,
+                                            std::memory_order_acquire)) {
+        }
+        return unpack(head);
+    }
+    
+    bool empty() const {
+        return unpack(head_.load(std::memory_order_acquire)) == nullptr;
+    }
+
+private:
+    static constexpr uint64_t POINTER_BITS = 48;
+    static constexpr uint64_t POINTER_MASK = (uint64_t{1} << POINTER_BITS) - 1;
+    
+    static Node* unpack(uint64_t head) {
+        return reinterpret_cast<Node*>(head & POINTER_MASK);
+    }
+    
+    // New head value: node plus the previous tag incremented
+    static uint64_t pack(Node* node, uint64_t previous) {
+        uint64_t tag = (previous >> POINTER_BITS) + 1;
+        return (tag << POINTER_BITS) | (reinterpret_cast<uint64_t>(node) & POINTER_MASK);
+    }
+    
+    std::atomic<uint64_t> head_{0};
+};
+
+// What an ObjectPool does to an object when it comes back
+enum class PoolReset {
+    ON_RELEASE,     // Assign T{} on the releasing thread
+    NONE            // Hand the object out again as it was left
+};
+
+namespace detail {
+
+// Pools that still exist. A thread's magazine cache may outlive its pool,
+// so caches only flush back into pools found here.
+struct PoolRegistry {
+    std::mutex mutex;
+    std::unordered_set<uint64_t> live;
+    uint64_t next_id = 1;
+    
+    static PoolRegistry& instance() {
+        static PoolRegistry* registry = new PoolRegistry();     // Outlives thread-exit flushes
+        return *registry;
+    }
+};
+
+} // namespace detail
+
+// Object pool with per-thread magazines (Bonwick & Adams, "Magazines and
+// Vmem", 2001).
+//
+// Each thread keeps two magazines of up to MAGAZINE_SIZE free objects, so
+// acquire and release on the same thread are an array pop / push. Full and
+// empty magazines are exchanged with the pool through lock-free tagged
+// stacks, which is how objects freed on one thread reach another; only
+// growth takes a lock. Objects are constructed once, when a chunk is added,
+// and destroyed with the pool, which must outlive every handle.
+//
+// The fast path is per (T, Reset) type: a thread that alternates between
+// two pools of the same type flushes its cache on every switch.
+template<typename T, PoolReset Reset = PoolReset::ON_RELEASE>
 class ObjectPool {
 public:
     using value_type = T;
     using pointer = T*;
     using const_pointer = const T*;
     
-    explicit ObjectPool(size_t initial_size = constants::memory::INITIAL_POOL_SIZE)
-        : allocated_count_(0) {
-        pool_.reserve(initial_size);
+    static constexpr uint32_t MAGAZINE_SIZE = 32;
+    
+    struct Deleter {
+        ObjectPool* pool = nullptr;
         
-        for (size_t i = 0; i < initial_size; ++i) {
-            pool_.push(std::make_unique<T>());
+        void operator()(T* ptr) const {
+            pool->release(ptr);
         }
-    }
+    };
     
-    ~ObjectPool() = default;
+    using Handle = std::unique_ptr<T, Deleter>;
     
-    // Get an object from the pool
-    std::unique_ptr<T, std::function<void(T*)>> acquire() {
-        std::unique_lock<std::mutex> lock(mutex_);
-        
-        if (pool_.empty()) {
-            // Allocate new object if pool is empty
-            allocated_count_++;
-            return std::unique_ptr<T, std::function<void(T*)>>(
-                new T(),
-                [this](T* ptr) { release(ptr); }
-            );
+    explicit ObjectPool(size_t initial_size = constants::memory::INITIAL_POOL_SIZE) {
+        {
+            auto& registry = detail::PoolRegistry::instance();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            id_ = registry.next_id++;
+            registry.live.insert(id_);
         }
         
-        auto obj = std::move(pool_.top());
-        pool_.pop();
+        for (size_t created = 0; created < initial_size; created += MAGAZINE_SIZE) {
+            Magazine* magazine = grow();
+            depot_objects_.fetch_add(magazine->count, std::memory_order_relaxed);
+            full_.push(magazine);
+        }
+    }
+    
+    ~ObjectPool() {
+        {
+            auto& registry = detail::PoolRegistry::instance();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            registry.live.erase(id_);
+        }
         
-        return std::unique_ptr<T, std::function<void(T*)>>(
-            obj.release(),
-            [this](T* ptr) { release(ptr); }
-        );
+        for (auto& chunk : chunks_) {
+            for (size_t i = 0; i < chunk.count; ++i) {
+                chunk.objects()[i].~T();
+            }
+            resource_->deallocate(chunk.storage, sizeof(T) * chunk.count, alignof(T));
+        }
+    }
+    
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+    
+    // Get an object from the pool
+    Handle acquire() {
+        return Handle(acquire_raw(), Deleter{this});
+    }
+    
+    T* acquire_raw() {
+        Cache& cache = bind_cache();
+        Magazine* loaded = cache.loaded;
+        if (loaded->count > 0) {
+            return loaded->items[--loaded->count];
+        }
+        return acquire_slow(cache);
     }
     
-    // Return an object to the pool
+    // Return an object to the pool, from any thread
     void release(T* ptr) {
         if (!ptr) return;
         
-        std::unique_lock<std::mutex> lock(mutex_);
-        
-        // Reset the object before returning to pool
-        if constexpr (std::is_class_v<T>) {
+        if constexpr (Reset == PoolReset::ON_RELEASE && std::is_class_v<T>) {
             *ptr = T{};  // Reset to default state
         }
         
-        pool_.push(std::unique_ptr<T>(ptr));
+        Cache& cache = bind_cache();
+        Magazine* loaded = cache.loaded;
+        if (loaded->count < MAGAZINE_SIZE) {
+            loaded->items[loaded->count++] = ptr;
+            return;
+        }
+        release_slow(cache, ptr);
     }
     
+    // Free objects in the shared depot; excludes those cached by threads
     size_t available() const {
-        std::unique_lock<std::mutex> lock(mutex_);
-        return pool_.size();
+        return depot_objects_.load(std::memory_order_relaxed);
     }
     
+    // Objects constructed so far
     size_t allocated() const {
-        return allocated_count_.load();
+        return allocated_count_.load(std::memory_order_relaxed);
     }
-    
+
 private:
-    mutable std::mutex mutex_;
-    std::stack<std::unique_ptr<T>> pool_;
-    std::atomic<size_t> allocated_count_;
+    struct Magazine {
+        T* items[MAGAZINE_SIZE];
+        uint32_t count = 0;
+        std::atomic<Magazine*> next{nullptr};
+    };
+    
+    struct Chunk {
+        void* storage;
+        size_t count;
+        
+        T* objects() const { return static_cast<T*>(storage); }
+    };
+    
+    // A thread's magazines for the pool it last used
+    struct Cache {
+        uint64_t pool_id = 0;
+        ObjectPool* pool = nullptr;
+        Magazine* loaded = nullptr;
+        Magazine* previous = nullptr;
+        
+        ~Cache() { detach(); }
+        
+        // Hand both magazines back, if the pool still exists
+        void detach() {
+            if (pool_id == 0) return;
+            
+            auto& registry = detail::PoolRegistry::instance();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            if (registry.live.count(pool_id)) {
+                pool->return_magazine(loaded);
+                pool->return_magazine(previous);
+            }
+            pool_id = 0;
+            pool = nullptr;
+            loaded = previous = nullptr;
+        }
+    };
+    
+    static Cache& local_cache() {
+        thread_local Cache cache;
+        return cache;
+    }
+    
+    Cache& bind_cache() {
+        Cache& cache = local_cache();
+        if (cache.pool_id != id_) {
+            cache.detach();
+            cache.loaded = take_empty();
+            cache.previous = take_empty();
+            cache.pool = this;
+            cache.pool_id = id_;
+        }
+        return cache;
+    }
+    
+    T* acquire_slow(Cache& cache) {
+        if (cache.previous->count > 0) {
+            std::swap(cache.loaded, cache.previous);
+        } else {
+            Magazine* full = full_.pop();
+            if (full) {
+                depot_objects_.fetch_sub(full->count, std::memory_order_relaxed);
+            } else {
+                full = grow();
+            }
+            empty_.push(cache.previous);
+            cache.previous = cache.loaded;
+            cache.loaded = full;
+        }
+        return cache.loaded->items[--cache.loaded->count];
+    }
+    
+    void release_slow(Cache& cache, T* ptr) {
+        if (cache.previous->count < MAGAZINE_SIZE) {
+            std::swap(cache.loaded, cache.previous);
+        } else {
+            depot_objects_.fetch_add(cache.previous->count, std::memory_order_relaxed);
+            full_.push(cache.previous);
+            cache.previous = cache.loaded;
+            cache.loaded = take_empty();
+        }
+        cache.loaded->items[cache.loaded->count++] = ptr;
+    }
+    
+    void return_magazine(Magazine* magazine) {
+        if (!magazine) return;
+        
+        if (magazine->count > 0) {
+            depot_objects_.fetch_add(magazine->count, std::memory_order_relaxed);
+            full_.push(magazine);
+        } else {
+            empty_.push(magazine);
+        }
+    }
+    
+    Magazine* take_empty() {
+        if (Magazine* magazine = empty_.pop()) {
+            return magazine;
+        }
+        
+        std::lock_guard<std::mutex> lock(growth_mutex_);
+        magazines_.push_back(std::make_unique<Magazine>());
+        return magazines_.back().get();
+    }
+    
+    // Construct a chunk of objects; returns them as a full magazine
+    Magazine* grow() {
+        void* storage = resource_->allocate(sizeof(T) * MAGAZINE_SIZE, alignof(T));
+        T* objects = static_cast<T*>(storage);
+        
+        size_t constructed = 0;
+        try {
+            for (; constructed < MAGAZINE_SIZE; ++constructed) {
+                ::new (static_cast<void*>(objects + constructed)) T();
+            }
+        } catch (...) {
+            for (size_t i = 0; i < constructed; ++i) {
+                objects[i].~T();
+            }
+            resource_->deallocate(storage, sizeof(T) * MAGAZINE_SIZE, alignof(T));
+            throw;
+        }
+        
+        Magazine* magazine = take_empty();
+        for (uint32_t i = 0; i < MAGAZINE_SIZE; ++i) {
+            magazine->items[i] = objects + i;
+        }
+        magazine->count = MAGAZINE_SIZE;
+        
+        std::lock_guard<std::mutex> lock(growth_mutex_);
+        chunks_.push_back({storage, MAGAZINE_SIZE});
+        allocated_count_.fetch_add(MAGAZINE_SIZE, std::memory_order_relaxed);
+        return magazine;
+    }
+    
+    uint64_t id_ = 0;
+    
+    // Chunk memory; huge pages when the arena was configured before the pool
+    std::pmr::memory_resource* resource_ = HugePageArena::resource();
+    
+    TaggedStack<Magazine> full_;        // Magazines holding free objects (possibly partial)
+    TaggedStack<Magazine> empty_;
+    std::atomic<size_t> depot_objects_{0};
+    std::atomic<size_t> allocated_count_{0};
+    
+    // Growth only; every chunk and magazine lives until the pool is destroyed
+    std::mutex growth_mutex_;
+    std::vector<Chunk> chunks_;
+    std::vector<std::unique_ptr<Magazine>> magazines_;
 };
 
-// Fixed-size memory pool for high-frequency allocations
-template<size_t BlockSize, size_t NumBlocks>
+// Fixed-size memory pool for high-frequency allocations.
+//
+// Blocks are carved from chunks of BlocksPerChunk inside one address range
+// reserved up front (MaxChunks chunks, committed lazily by the kernel as
+// they are touched), so owns() is a single range check. Free blocks sit on
+// a tagged lock-free stack: allocate and deallocate from any thread are a
+// CAS each, and only adding a chunk takes a lock. allocate() returns
+// nullptr once all MaxChunks chunks are in use. With the huge page arena
+// enabled the range is advised for transparent huge pages.
+//
+// Every allocate and deallocate is a CAS on the shared head, so on one
+// thread it costs more than a thread-caching malloc (memory_pool_bench);
+// per-thread hot paths want ObjectPool.
+template<size_t BlockSize, size_t BlocksPerChunk, size_t MaxChunks = 64>
 class FixedMemoryPool {
 public:
     static_assert(BlockSize >= sizeof(void*), "Block size must be at least pointer size");
+    static_assert(BlockSize % alignof(std::max_align_t) == 0, "Block size must keep blocks aligned");
     
-    FixedMemoryPool() : free_list_(nullptr), allocated_count_(0) {
-        // Allocate aligned memory
-        storage_ = aligned_alloc<char>(BlockSize * NumBlocks, constants::simd::ALIGNMENT);
-        
-        if (!storage_) {
+    static constexpr size_t CHUNK_BYTES = BlockSize * BlocksPerChunk;
+    
+    FixedMemoryPool() {
+        void* base = mmap(nullptr, CHUNK_BYTES * MaxChunks, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (base == MAP_FAILED) {
             throw std::bad_alloc();
         }
+        base_ = static_cast<char*>(base);
+        HugePageArena::advise(base_, CHUNK_BYTES * MaxChunks);
         
-        // Initialize free list
-        for (size_t i = 0; i < NumBlocks; ++i) {
-            auto block = reinterpret_cast<FreeBlock*>(storage_ + i * BlockSize);
-            block->next = free_list_;
-            free_list_ = block;
-        }
+        // The first chunk is carved eagerly, as the fixed pool used to be
+        std::lock_guard<std::mutex> lock(growth_mutex_);
+        add_chunk();
     }
     
     ~FixedMemoryPool() {
-        aligned_free(storage_);
+        munmap(base_, CHUNK_BYTES * MaxChunks);
     }
     
+    FixedMemoryPool(const FixedMemoryPool&) = delete;
+    FixedMemoryPool& operator=(const FixedMemoryPool&) = delete;
+    
     void* allocate() {
-        std::unique_lock<std::mutex> lock(mutex_);
-        
-        if (!free_list_) {
-            return nullptr;  // Pool exhausted
+        FreeBlock* block = free_list_.pop();
+        if (!block) {
+            block = grow();
+            if (!block) {
+                return nullptr;  // Pool exhausted
+            }
         }
         
-        auto block = free_list_;
-        free_list_ = free_list_->next;
-        allocated_count_++;
-        
+        allocated_count_.fetch_add(1, std::memory_order_relaxed);
         return block;
     }
     
+    // ptr must come from this pool (see owns()); any thread
     void deallocate(void* ptr) {
         if (!ptr) return;
         
-        std::unique_lock<std::mutex> lock(mutex_);
-        
-        auto block = reinterpret_cast<FreeBlock*>(ptr);
-        block->next = free_list_;
-        free_list_ = block;
-        allocated_count_--;
+        // No placement new: its plain initialising store would race with a
+        // concurrent pop() reading a stale next; push() stores next atomically
+        free_list_.push(static_cast<FreeBlock*>(ptr));
+        allocated_count_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    
+    bool owns(const void* ptr) const {
+        auto address = reinterpret_cast<uintptr_t>(ptr);
+        auto base = reinterpret_cast<uintptr_t>(base_);
+        return address >= base && address < base + CHUNK_BYTES * MaxChunks;
     }
     
     size_t allocated() const {
@@ -136,35 +440,60 @@ public:
     }
     
     size_t available() const {
-        return NumBlocks - allocated_count_.load();
+        size_t blocks = capacity();
+        size_t used = allocated_count_.load();
+        return blocks > used ? blocks - used : 0;
     }
     
-    static constexpr size_t block_size() { return BlockSize; }
-    static constexpr size_t capacity() { return NumBlocks; }
+    // Blocks in chunks added so far
+    size_t capacity() const {
+        return chunk_count_.load(std::memory_order_relaxed) * BlocksPerChunk;
+    }
     
+    static constexpr size_t block_size() { return BlockSize; }
+    static constexpr size_t max_capacity() { return BlocksPerChunk * MaxChunks; }
+
 private:
     struct FreeBlock {
-        FreeBlock* next;
+        std::atomic<FreeBlock*> next{nullptr};
     };
     
-    char* storage_;
-    FreeBlock* free_list_;
-    mutable std::mutex mutex_;
-    std::atomic<size_t> allocated_count_;
-    
-    template<typename T>
-    static T* aligned_alloc(size_t size, size_t alignment) {
-        void* ptr = nullptr;
-        if (posix_memalign(&ptr, alignment, size) != 0) {
+    FreeBlock* grow() {
+        std::lock_guard<std::mutex> lock(growth_mutex_);
+        
+        // Another thread may have grown, or blocks been freed, while we waited
+        if (FreeBlock* block = free_list_.pop()) {
+            return block;
+        }
+        if (chunk_count_.load(std::memory_order_relaxed) == MaxChunks) {
             return nullptr;
         }
-        return static_cast<T*>(ptr);
+        
+        add_chunk();
+        return free_list_.pop();
     }
     
-    template<typename T>
-    static void aligned_free(T* ptr) {
-        free(ptr);
+    // Caller holds growth_mutex_
+    void add_chunk() {
+        char* chunk = base_ + chunk_count_.load(std::memory_order_relaxed) * CHUNK_BYTES;
+        
+        FreeBlock* first = ::new (chunk) FreeBlock();
+        FreeBlock* last = first;
+        for (size_t i = 1; i < BlocksPerChunk; ++i) {
+            FreeBlock* block = ::new (chunk + i * BlockSize) FreeBlock();
+            last->next.store(block, std::memory_order_relaxed);
+            last = block;
+        }
+        
+        free_list_.push_chain(first, last);
+        chunk_count_.fetch_add(1, std::memory_order_relaxed);
     }
+    
+    char* base_ = nullptr;
+    TaggedStack<FreeBlock> free_list_;
+    std::atomic<size_t> allocated_count_{0};
+    std::atomic<size_t> chunk_count_{0};
+    std::mutex growth_mutex_;
 };
 
 // Memory pool allocator for STL containers
@@ -225,7 +554,7 @@ public:
     bool operator!=(const PoolAllocator& other) const {
         return !(*this == other);
     }
-    
+
 private:
     static ObjectPool<T>* get_pool() {
         static ObjectPool<T> pool;
@@ -276,14 +605,19 @@ public:
         return ::operator new(size);
     }
     
-    static void deallocate(void* ptr, size_t size) {
+    // Routed by address alone: a block goes back to the pool whose range
+    // holds it, and anything else (an allocate() that fell back to
+    // operator new) to the heap. size is not trusted, so a caller passing
+    // a different size than it allocated cannot send a pool block to
+    // operator delete.
+    static void deallocate(void* ptr, [[maybe_unused]] size_t size) {
         if (!ptr) return;
         
-        if (size <= SmallPool::block_size()) {
+        if (small_pool().owns(ptr)) {
             small_pool().deallocate(ptr);
-        } else if (size <= MediumPool::block_size()) {
+        } else if (medium_pool().owns(ptr)) {
             medium_pool().deallocate(ptr);
-        } else if (size <= LargePool::block_size()) {
+        } else if (large_pool().owns(ptr)) {
             large_pool().deallocate(ptr);
         } else {
             ::operator delete(ptr);
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "thread_pool.h"
+
+namespace arbitrage {
+
+// Half-open index range [begin, end)
+struct IndexRange {
+    size_t begin = 0;
+    size_t end = 0;
+
+    size_t size() const { return end > begin ? end - begin : 0; }
+    bool empty() const { return end <= begin; }
+};
+
+namespace detail {
+
+// State shared by every chunk of one parallel call; lives on the caller's
+// frame, so chunk tasks only capture a pointer to it
+struct ForkJoinState {
+    ThreadPool& pool;
+    TaskLatch latch{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    explicit ForkJoinState(ThreadPool& pool) : pool(pool) {}
+
+    void capture_exception() {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) {
+            error = std::current_exception();
+        }
+        failed.store(true, std::memory_order_relaxed);
+    }
+
+    // Joins, then rethrows the first exception from any chunk
+    void join() {
+        latch.wait(pool);
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+template<typename F>
+struct ParallelForState : ForkJoinState {
+    F& body;
+    size_t grain;
+
+    ParallelForState(ThreadPool& pool, F& body, size_t grain)
+        : ForkJoinState(pool), body(body), grain(grain) {}
+};
+
+// Runs range, splitting off the upper half as a pool task while it is above
+// split_limit. A chunk that was stolen halves its own split_limit (down to
+// the grain): a thief is evidence of idle workers, so we cut finer.
+template<typename F>
+void run_chunk(ParallelForState<F>* state, IndexRange range, size_t split_limit, int spawner) {
+    if (state->pool.current_worker_index() != spawner) {
+        split_limit = std::max(state->grain, split_limit / 2);
+    }
+
+    int self = state->pool.current_worker_index();
+    while (range.size() > split_limit) {
+        size_t middle = range.begin + range.size() / 2;
+        IndexRange upper{middle, range.end};
+        range.end = middle;
+
+        state->latch.add();
+        state->pool.execute([state, upper, split_limit, self] {
+            run_chunk(state, upper, split_limit, self);
+            state->latch.count_down();
+        });
+    }
+
+    if (state->failed.load(std::memory_order_relaxed)) return;
+
+    try {
+        state->body(range);
+    } catch (...) {
+        state->capture_exception();
+    }
+}
+
+} // namespace detail
+
+// Calls fn(IndexRange) over disjoint chunks of range covering it exactly.
+//
+// The range is split recursively: first down to about four chunks per
+// thread, then finer where chunks get stolen, never below grain items. The
+// calling thread runs chunks too and, while waiting, any other pool work,
+// so parallel loops may nest inside pool tasks. Chunking never allocates;
+// the first exception thrown by fn is rethrown here after all chunks stop.
+template<typename F>
+void parallel_for(ThreadPool& pool, IndexRange range, size_t grain, F&& fn) {
+    if (range.empty()) return;
+    grain = std::max<size_t>(grain, 1);
+
+    if (range.size() <= grain || pool.num_threads() == 0) {
+        fn(range);
+        return;
+    }
+
+    size_t chunks = 4 * (pool.num_threads() + 1);
+    size_t split_limit = std::max(grain, (range.size() + chunks - 1) / chunks);
+
+    detail::ParallelForState<std::remove_reference_t<F>> state(pool, fn, grain);
+    detail::run_chunk(&state, range, split_limit, pool.current_worker_index());
+    state.join();
+}
+
+template<typename F>
+void parallel_for(IndexRange range, size_t grain, F&& fn) {
+    parallel_for(GlobalThreadPool::instance(), range, grain, std::forward<F>(fn));
+}
+
+// Folds range in chunks: body(IndexRange, T init) -> T accumulates one
+// chunk, combine(T, T) -> T merges partials. Partials are combined in index
+// order, so combine needs to be associative but not commutative, and the
+// result does not depend on scheduling.
+template<typename T, typename Body, typename Combine>
+T parallel_reduce(ThreadPool& pool, IndexRange range, size_t grain, T identity,
+                  Body&& body, Combine&& combine) {
+    if (range.empty()) return identity;
+    grain = std::max<size_t>(grain, 1);
+
+    if (range.size() <= grain || pool.num_threads() == 0) {
+        return body(range, identity);
+    }
+
+    size_t target_chunks = 4 * (pool.num_threads() + 1);
+    size_t chunk_size = std::max(grain, (range.size() + target_chunks - 1) / target_chunks);
+    size_t chunk_count = (range.size() + chunk_size - 1) / chunk_size;
+
+    std::vector<T> partials(chunk_count, identity);
+    parallel_for(pool, IndexRange{0, chunk_count}, 1, [&](IndexRange chunks) {
+        for (size_t chunk = chunks.begin; chunk < chunks.end; ++chunk) {
+            size_t begin = range.begin + chunk * chunk_size;
+            IndexRange part{begin, std::min(range.end, begin + chunk_size)};
+            partials[chunk] = body(part, partials[chunk]);
+        }
+    });
+
+    T result = std::move(identity);
+    for (auto& partial : partials) {
+        result = combine(std::move(result), std::move(partial));
+    }
+    return result;
+}
+
+template<typename T, typename Body, typename Combine>
+T parallel_reduce(IndexRange range, size_t grain, T identity, Body&& body, Combine&& combine) {
+    return parallel_reduce(GlobalThreadPool::instance(), range, grain, std::move(identity),
+                           std::forward<Body>(body), std::forward<Combine>(combine));
+}
+
+// Runs every callable, the first on the calling thread and the rest on the
+// pool, and returns when all have finished. Rethrows the first exception.
+template<typename First, typename... Rest>
+void parallel_invoke(ThreadPool& pool, First&& first, Rest&&... rest) {
+    detail::ForkJoinState state(pool);
+
+    auto spawn = [&state](auto& fn) {
+        state.latch.add();
+        state.pool.execute([&state, &fn] {
+            try {
+                fn();
+            } catch (...) {
+                state.capture_exception();
+            }
+            state.latch.count_down();
+        });
+    };
+    (spawn(rest), ...);
+
+    try {
+        first();
+    } catch (...) {
+        state.capture_exception();
+    }
+    state.join();
+}
+
+} // namespace arbitrage
@@ -0,0 +1,29 @@
+#include "task.h"
+#include "memory_pool.h"
+
+namespace arbitrage {
+
+namespace {
+
+// The pool resets a task before releasing its node, so nodes come back
+// empty and need no reset here
+using NodePool = ObjectPool<TaskNode, PoolReset::NONE>;
+
+NodePool& node_pool() {
+    static NodePool* pool = new NodePool();     // Outlives thread caches at exit
+    return *pool;
+}
+
+} // namespace
+
+TaskNode* TaskNode::acquire() {
+    TaskNode* node = node_pool().acquire_raw();
+    node->next = nullptr;
+    return node;
+}
+
+void TaskNode::release(TaskNode* node) {
+    node_pool().release(node);
+}
+
+} // namespace arbitrage
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace arbitrage {
+
+// Move-only type-erased void() callable with inline storage.
+//
+// Callables up to INLINE_SIZE bytes (a lambda capturing a few pointers and
+// indices) are stored in place; larger ones fall back to one heap
+// allocation. Unlike std::function the target need not be copyable, so a
+// std::packaged_task can be held directly.
+class Task {
+public:
+    static constexpr size_t INLINE_SIZE = 48;
+
+    Task() noexcept = default;
+
+    template<typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task>>>
+    Task(F&& f) {
+        using Fn = std::decay_t<F>;
+        if constexpr (fits_inline<Fn>()) {
+            ::new (static_cast<void*>(storage_)) Fn(std::forward<F>(f));
+            ops_ = &INLINE_OPS<Fn>;
+        } else {
+            ::new (static_cast<void*>(storage_)) Fn*(new Fn(std::forward<F>(f)));
+            ops_ = &HEAP_OPS<Fn>;
+        }
+    }
+
+    Task(Task&& other) noexcept : ops_(other.ops_) {
+        if (ops_) {
+            ops_->move(storage_, other.storage_);
+            other.ops_ = nullptr;
+        }
+    }
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            reset();
+            if (other.ops_) {
+                other.ops_->move(storage_, other.storage_);
+                ops_ = other.ops_;
+                other.ops_ = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() { reset(); }
+
+    void operator()() { ops_->invoke(storage_); }
+
+    explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+    void reset() noexcept {
+        if (ops_) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+    // True when F is stored without a heap allocation
+    template<typename F>
+    static constexpr bool fits_inline() {
+        return sizeof(F) <= INLINE_SIZE && alignof(F) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible_v<F>;
+    }
+
+private:
+    struct Ops {
+        void (*invoke)(void* storage);
+        void (*move)(void* target, void* source) noexcept;     // Leaves source destroyed
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    template<typename Fn>
+    static constexpr Ops INLINE_OPS = {
+        [](void* storage) { (*static_cast<Fn*>(storage))(); },
+        [](void* target, void* source) noexcept {
+            ::new (target) Fn(std::move(*static_cast<Fn*>(source)));
+            static_cast<Fn*>(source)->~Fn();
+        },
+        [](void* storage) noexcept { static_cast<Fn*>(storage)->~Fn(); },
+    };
+
+    template<typename Fn>
+    static constexpr Ops HEAP_OPS = {
+        [](void* storage) { (**static_cast<Fn**>(storage))(); },
+        [](void* target, void* source) noexcept {
+            ::new (target) Fn*(*static_cast<Fn**>(source));
+        },
+        [](void* storage) noexcept { delete *static_cast<Fn**>(storage); },
+    };
+
+    alignas(std::max_align_t) unsigned char storage_[INLINE_SIZE];
+    const Ops* ops_ = nullptr;
+};
+
+// Queue entry for a pool task. Nodes are recycled through an ObjectPool
+// (per-thread magazines, lock-free depot), so steady-state submission does
+// not allocate.
+struct alignas(64) TaskNode {
+    Task task;
+    TaskNode* next = nullptr;       // Intrusive link for the injection queue and caches
+
+    static TaskNode* acquire();
+    static void release(TaskNode* node);
+};
+
+} // namespace arbitrage
@@ -0,0 +1,274 @@
+#include "thread_placement.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <linux/mempolicy.h>
+#include <mutex>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace arbitrage {
+
+namespace {
+
+struct PlacementState {
+    std::mutex mutex;
+    ThreadPlacement::Config config;
+    std::vector<std::string> report;
+    std::atomic<uint32_t> next_slot[THREAD_ROLE_COUNT] = {};
+};
+
+PlacementState& state() {
+    static PlacementState* instance = new PlacementState();     // Threads may register during exit
+    return *instance;
+}
+
+// Parses a kernel cpu list such as "2-5,8"
+std::vector<int> parse_cpu_list(const std::string& list) {
+    std::vector<int> cpus;
+    size_t position = 0;
+    while (position < list.size()) {
+        size_t comma = list.find(',', position);
+        std::string range = list.substr(position, comma == std::string::npos ? std::string::npos
+                                                                             : comma - position);
+        size_t dash = range.find('-');
+        try {
+            int first = std::stoi(range.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        } catch (const std::exception&) {
+        }
+        if (comma == std::string::npos) break;
+        position = comma + 1;
+    }
+    return cpus;
+}
+
+std::vector<int> read_cpu_list(const char* path) {
+    std::ifstream file(path);
+    std::string list;
+    std::getline(file, list);
+    return parse_cpu_list(list);
+}
+
+// NUMA node of a cpu from sysfs, -1 if unknown
+int node_of_cpu(int cpu) {
+    std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    DIR* directory = opendir(path.c_str());
+    if (!directory) return -1;
+
+    int node = -1;
+    while (dirent* entry = readdir(directory)) {
+        if (std::strncmp(entry->d_name, "node", 4) == 0 && entry->d_name[4] >= '0' &&
+            entry->d_name[4] <= '9') {
+            node = std::atoi(entry->d_name + 4);
+            break;
+        }
+    }
+    closedir(directory);
+    return node;
+}
+
+bool prefer_node(int node) {
+    // Node ids from sysfs can exceed one word's bits; the kernel reads
+    // maxnode - 1 bits, hence the + 1
+    constexpr size_t BITS = sizeof(unsigned long) * 8;
+    std::vector<unsigned long> mask(static_cast<size_t>(node) / BITS + 1, 0);
+    mask[node / BITS] |= 1UL << (node % BITS);
+    return ::syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask.data(), mask.size() * BITS + 1) == 0;
+}
+
+std::string join(const std::vector<int>& values) {
+    std::string text;
+    for (int value : values) {
+        if (!text.empty()) text += ",";
+        text += std::to_string(value);
+    }
+    return text;
+}
+
+std::vector<std::string> validate(const ThreadPlacement::Config& config) {
+    std::vector<std::string> report;
+
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    sched_getaffinity(0, sizeof(allowed), &allowed);
+    auto isolated = read_cpu_list("/sys/devices/system/cpu/isolated");
+    auto nohz = read_cpu_list("/sys/devices/system/cpu/nohz_full");
+
+    int fifo_min = sched_get_priority_min(SCHED_FIFO);
+    int fifo_max = sched_get_priority_max(SCHED_FIFO);
+    rlimit rtprio{};
+    getrlimit(RLIMIT_RTPRIO, &rtprio);
+    bool privileged = geteuid() == 0;
+
+    // core -> roles using it; sharing only matters if one of them is
+    // latency-critical (io, detector, pool or real-time)
+    std::vector<std::vector<std::string>> users(CPU_SETSIZE);
+    std::vector<bool> critical(CPU_SETSIZE, false);
+
+    for (size_t i = 0; i < THREAD_ROLE_COUNT; ++i) {
+        const auto& policy = config.roles[i];
+        const char* role = thread_role_to_string(static_cast<ThreadRole>(i));
+        if (policy.cores.empty() && policy.fifo_priority == 0) continue;
+
+        std::string line = std::string(role) + ": cores [" + join(policy.cores) + "]";
+        if (policy.fifo_priority > 0) line += ", SCHED_FIFO " + std::to_string(policy.fifo_priority);
+        if (policy.numa_local) line += ", NUMA-local memory";
+        report.push_back(line);
+
+        for (int core : policy.cores) {
+            if (core < 0 || core >= CPU_SETSIZE || !CPU_ISSET(core, &allowed)) {
+                report.push_back("WARN " + std::string(role) + ": core " + std::to_string(core) +
+                                 " is offline or outside this process's cpuset");
+                continue;
+            }
+            bool latency_critical = policy.fifo_priority > 0 ||
+                                    i == static_cast<size_t>(ThreadRole::IO) ||
+                                    i == static_cast<size_t>(ThreadRole::DETECTOR) ||
+                                    i == static_cast<size_t>(ThreadRole::POOL);
+            users[core].push_back(role);
+            critical[core] = critical[core] || latency_critical;
+
+            bool is_isolated = std::find(isolated.begin(), isolated.end(), core) != isolated.end();
+            if (!is_isolated && latency_critical) {
+                report.push_back("NOTE " + std::string(role) + ": core " + std::to_string(core) +
+                                 " is not in isolcpus; the scheduler may still place other tasks there");
+            }
+            if (is_isolated && std::find(nohz.begin(), nohz.end(), core) == nohz.end()) {
+                report.push_back("NOTE " + std::string(role) + ": core " + std::to_string(core) +
+                                 " is isolated but still takes scheduler ticks (not nohz_full)");
+            }
+        }
+
+        if (policy.fifo_priority > 0) {
+            if (policy.fifo_priority < fifo_min || policy.fifo_priority > fifo_max) {
+                report.push_back("WARN " + std::string(role) + ": SCHED_FIFO priority must be " +
+                                 std::to_string(fifo_min) + "-" + std::to_string(fifo_max));
+            } else if (!privileged && rtprio.rlim_cur != RLIM_INFINITY &&
+                       static_cast<rlim_t>(policy.fifo_priority) > rtprio.rlim_cur) {
+                report.push_back("WARN " + std::string(role) + ": RLIMIT_RTPRIO is " +
+                                 std::to_string(rtprio.rlim_cur) +
+                                 "; SCHED_FIFO will be refused without CAP_SYS_NICE");
+            }
+            if (policy.cores.empty()) {
+                report.push_back("WARN " + std::string(role) +
+                                 ": SCHED_FIFO without dedicated cores can starve other threads");
+            }
+        }
+
+        if (policy.numa_local && policy.cores.size() > 1) {
+            int node = node_of_cpu(policy.cores.front());
+            for (int core : policy.cores) {
+                if (node_of_cpu(core) != node) {
+                    report.push_back("NOTE " + std::string(role) +
+                                     ": cores span NUMA nodes; each thread prefers its own core's node");
+                    break;
+                }
+            }
+        }
+    }
+
+    for (int core = 0; core < CPU_SETSIZE; ++core) {
+        if (users[core].size() > 1 && critical[core]) {
+            std::string roles;
+            for (const auto& role : users[core]) {
+                if (!roles.empty()) roles += ", ";
+                roles += role;
+            }
+            report.push_back("WARN core " + std::to_string(core) + " is shared by " + roles);
+        }
+    }
+
+    return report;
+}
+
+} // namespace
+
+void ThreadPlacement::configure(const Config& config) {
+    auto report = validate(config);
+
+    auto& placement = state();
+    {
+        std::lock_guard<std::mutex> lock(placement.mutex);
+        placement.config = config;
+        placement.report = report;
+        for (auto& slot : placement.next_slot) {
+            slot.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    if (report.empty()) {
+        LOG_INFO("Thread placement: no roles pinned");
+        return;
+    }
+
+    LOG_INFO("Thread placement:");
+    for (const auto& line : report) {
+        if (line.rfind("WARN", 0) == 0) {
+            LOG_WARN("  {}", line);
+        } else {
+            LOG_INFO("  {}", line);
+        }
+    }
+}
+
+int ThreadPlacement::apply_current(ThreadRole role, const std::string& name) {
+    auto& placement = state();
+    RolePolicy policy;
+    {
+        std::lock_guard<std::mutex> lock(placement.mutex);
+        policy = placement.config.roles[static_cast<size_t>(role)];
+    }
+
+    int core = -1;
+    if (!policy.cores.empty()) {
+        uint32_t slot = placement.next_slot[static_cast<size_t>(role)].fetch_add(1, std::memory_order_relaxed);
+        core = policy.cores[slot % policy.cores.size()];
+
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(core, &cpus);
+        int result = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+        if (result != 0) {
+            LOG_WARN("Failed to pin {} to core {}: {}", name, core, std::strerror(result));
+            core = -1;
+        }
+    }
+
+    if (policy.fifo_priority > 0) {
+        sched_param param{};
+        param.sched_priority = policy.fifo_priority;
+        int result = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (result != 0) {
+            LOG_WARN("Failed to set SCHED_FIFO {} for {}: {}", policy.fifo_priority, name,
+                     std::strerror(result));
+        }
+    }
+
+    if (policy.numa_local && core >= 0) {
+        int node = node_of_cpu(core);
+        if (node >= 0 && !prefer_node(node)) {
+            LOG_WARN("Failed to prefer NUMA node {} for {}: {}", node, name, std::strerror(errno));
+        }
+    }
+
+    return core;
+}
+
+std::vector<std::string> ThreadPlacement::validation_report() {
+    auto& placement = state();
+    std::lock_guard<std::mutex> lock(placement.mutex);
+    return placement.report;
+}
+
+} // namespace arbitrage
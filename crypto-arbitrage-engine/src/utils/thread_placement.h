@@ -0,0 +1,45 @@
+#pragma once
+
+#include "thread_registry.h"
+#include <string>
+#include <vector>
+
+namespace arbitrage {
+
+// Per-role CPU placement for engine threads, applied as each thread
+// registers with ThreadRegistry.
+//
+// A role lists the cores its threads may use; successive threads of the
+// role take one core each, round-robin, so three io threads on [2, 3, 4]
+// get a dedicated core apiece. A role can also ask for SCHED_FIFO at a
+// given priority and for NUMA-local memory, i.e. a preferred memory policy
+// on the node of its core so the data the thread first touches stays
+// local. Failures (no CAP_SYS_NICE, core outside the cpuset) are logged
+// and leave the thread where it was; placement never stops the engine.
+class ThreadPlacement {
+public:
+    struct RolePolicy {
+        std::vector<int> cores;         // Empty: leave unpinned
+        int fifo_priority = 0;          // > 0: SCHED_FIFO at this priority
+        bool numa_local = false;        // Prefer memory on the core's node
+    };
+
+    struct Config {
+        RolePolicy roles[THREAD_ROLE_COUNT];
+    };
+
+    // Install the policy and log a validation report: unknown or offline
+    // cores, cores shared between roles, cores not isolated from the
+    // scheduler, priorities outside the SCHED_FIFO range or above
+    // RLIMIT_RTPRIO. Call before engine threads start.
+    static void configure(const Config& config);
+
+    // Place the calling thread according to its role's policy; returns the
+    // core it was pinned to, or -1
+    static int apply_current(ThreadRole role, const std::string& name);
+
+    // Report lines from the last configure(), for logs and diagnostics
+    static std::vector<std::string> validation_report();
+};
+
+} // namespace arbitrage
@@ -1,2 +1,248 @@
-// Thread pool implementation moved to header file for template support
-// This file is kept for potential non-template implementations
\ No newline at end of file
+#include "thread_pool.h"
+#include "utils/logger.h"
+#include <chrono>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+
+namespace arbitrage {
+
+namespace {
+
+// Calling thread's pool and worker slot, so submissions from inside a task
+// can take the local deque fast path
+thread_local ThreadPool* current_pool = nullptr;
+thread_local size_t current_worker = 0;
+
+// Pool whose task the calling thread is running, including tasks a helping
+// thread runs from run_pending_task()
+thread_local const ThreadPool* running_pool = nullptr;
+
+inline uint64_t next_random(uint64_t& state) {
+    // xorshift64
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+void pin_to_core(size_t index, int core) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(core, &cpus);
+
+    int result = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    if (result != 0) {
+        LOG_WARN("Failed to pin pool-{} to core {}: {}", index, core, std::strerror(result));
+    }
+}
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t num_threads)
+    : ThreadPool(Config{num_threads, {}, {}}) {
+}
+
+ThreadPool::ThreadPool(const Config& config)
+    : config_(config) {
+    size_t num_threads = config_.num_threads > 0 ? config_.num_threads : 1;
+
+    // All deques exist before any worker can try to steal from them
+    workers_.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+        workers_.back()->rng_state = 0x9E3779B97F4A7C15ULL * (i + 1);
+    }
+
+    for (size_t i = 0; i < num_threads; ++i) {
+        workers_[i]->thread = std::thread([this, i] {
+            ThreadRegistry::instance().register_current_thread("pool-" + std::to_string(i),
+                                                               ThreadRole::POOL);
+            if (!config_.cores.empty()) {
+                pin_to_core(i, config_.cores[i % config_.cores.size()]);
+            }
+            worker_thread(i);
+        });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    stop();
+}
+
+int ThreadPool::current_worker_index() const {
+    return current_pool == this ? static_cast<int>(current_worker) : -1;
+}
+
+void ThreadPool::enqueue(Task&& task) {
+    if (stop_.load(std::memory_order_acquire)) {
+        throw std::runtime_error("ThreadPool is stopped");
+    }
+
+    Job* job = TaskNode::acquire();
+    job->task = std::move(task);
+    pending_tasks_.fetch_add(1, std::memory_order_relaxed);
+
+    if (current_pool == this) {
+        workers_[current_worker]->deque.push(job);
+    } else {
+        std::lock_guard<std::mutex> lock(injection_mutex_);
+        if (injection_tail_) {
+            injection_tail_->next = job;
+        } else {
+            injection_head_ = job;
+        }
+        injection_tail_ = job;
+        injection_size_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    wake_one();
+}
+
+void ThreadPool::wake_one() {
+    work_signal_.notify_one();
+}
+
+ThreadPool::Job* ThreadPool::find_task(Worker* self) {
+    if (self) {
+        if (Job* job = self->deque.pop()) {
+            return job;
+        }
+    }
+
+    if (injection_size_.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> lock(injection_mutex_);
+        if (Job* job = injection_head_) {
+            injection_head_ = job->next;
+            if (!injection_head_) {
+                injection_tail_ = nullptr;
+            }
+            job->next = nullptr;
+            injection_size_.fetch_sub(1, std::memory_order_relaxed);
+            return job;
+        }
+    }
+
+    // Steal, starting from a random victim
+    size_t count = workers_.size();
+    thread_local uint64_t outsider_rng = 0x2545F4914F6CDD1DULL;
+    uint64_t& rng = self ? self->rng_state : outsider_rng;
+    size_t start = static_cast<size_t>(next_random(rng) % count);
+
+    for (size_t offset = 0; offset < count; ++offset) {
+        Worker* victim = workers_[(start + offset) % count].get();
+        if (victim == self) continue;
+
+        if (Job* job = victim->deque.steal()) {
+            total_tasks_stolen_.fetch_add(1, std::memory_order_relaxed);
+            return job;
+        }
+    }
+
+    return nullptr;
+}
+
+void ThreadPool::run_task(Job* job) {
+    active_tasks_++;
+    const ThreadPool* outer = running_pool;
+    running_pool = this;
+
+    try {
+        job->task();
+    } catch (const std::exception& e) {
+        LOG_ERROR("Unhandled exception in pool task: {}", e.what());
+    } catch (...) {
+        LOG_ERROR("Unhandled non-standard exception in pool task");
+    }
+
+    // Destroy captures before the task counts as finished
+    job->task.reset();
+    TaskNode::release(job);
+    running_pool = outer;
+
+    active_tasks_--;
+    total_tasks_processed_++;
+
+    if (pending_tasks_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        { std::lock_guard<std::mutex> lock(idle_mutex_); }
+        idle_condition_.notify_all();
+    }
+}
+
+bool ThreadPool::run_pending_task() {
+    Worker* self = current_pool == this ? workers_[current_worker].get() : nullptr;
+    Job* job = find_task(self);
+    if (!job) {
+        return false;
+    }
+
+    run_task(job);
+    return true;
+}
+
+void ThreadPool::worker_thread(size_t index) {
+    current_pool = this;
+    current_worker = index;
+    Worker* self = workers_[index].get();
+    WaitStrategy wait(config_.wait);
+
+    while (true) {
+        // Read before looking, so work published after the look moves it on
+        uint32_t seen = work_signal_.epoch();
+
+        Job* job = find_task(self);
+        if (job) {
+            run_task(job);
+            continue;
+        }
+
+        if (stop_.load(std::memory_order_acquire)) {
+            // Drain whatever is still queued before exiting
+            if ((job = find_task(self)) != nullptr) {
+                run_task(job);
+                continue;
+            }
+            return;
+        }
+
+        wait.wait(work_signal_, seen);
+    }
+}
+
+void ThreadPool::wait_all() {
+    // The pool-wide count includes the calling task and any other task
+    // waiting here, so from inside a task it may never reach zero; fork-join
+    // inside the pool has to wait on its own TaskLatch
+    if (current_pool == this || running_pool == this) {
+        throw std::logic_error("ThreadPool::wait_all() called from a pool task; join with a TaskLatch");
+    }
+
+    std::unique_lock<std::mutex> lock(idle_mutex_);
+    idle_condition_.wait(lock, [this] {
+        return pending_tasks_.load(std::memory_order_acquire) == 0;
+    });
+}
+
+void ThreadPool::stop() {
+    stop_ = true;
+    work_signal_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+
+    // Only reachable with tasks left if stop() raced a submit from outside
+    std::lock_guard<std::mutex> lock(injection_mutex_);
+    while (Job* job = injection_head_) {
+        injection_head_ = job->next;
+        job->next = nullptr;
+        job->task.reset();
+        TaskNode::release(job);
+    }
+    injection_tail_ = nullptr;
+    injection_size_.store(0, std::memory_order_relaxed);
+}
+
+} // namespace arbitrage
@@ -1,7 +1,6 @@
 #pragma once
 
 #include <vector>
-#include <queue>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
@@ -9,43 +8,191 @@
 #include <future>
 #include <atomic>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include "task.h"
+#include "thread_registry.h"
+#include "wait_strategy.h"
 
 namespace arbitrage {
 
+// Chase-Lev work-stealing deque (Le et al., "Correct and Efficient
+// Work-Stealing for Weak Memory Models", 2013).
+//
+// The owning worker pushes and pops at the bottom without locks; other
+// workers steal from the top with a single CAS. The buffer grows when full;
+// replaced buffers are kept until destruction because a thief may still be
+// reading from one.
+template<typename T>
+class WorkStealingDeque {
+public:
+    explicit WorkStealingDeque(size_t capacity = 256)
+        : buffer_(new Buffer(round_up(capacity))) {
+        retired_.emplace_back(buffer_.load(std::memory_order_relaxed));
+    }
+    
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+    
+    // Owner only
+    void push(T* item) {
+        int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        int64_t top = top_.load(std::memory_order_acquire);
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        
+        if (bottom - top > static_cast<int64_t>(buffer->mask)) {
+            buffer = grow(buffer, top, bottom);
+        }
+        
+        buffer->put(bottom, item);
+        bottom_.store(bottom + 1, std::memory_order_release);     // Publishes the item to thieves
+    }
+    
+    // Owner only; newest first
+    T* pop() {
+        int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = top_.load(std::memory_order_relaxed);
+        
+        if (top > bottom) {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        
+        T* item = buffer->get(bottom);
+        if (top == bottom) {
+            // Last item: race thieves for it
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                              std::memory_order_relaxed)) {
+                item = nullptr;
+            }
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+    
+    // Any thread; oldest first. Returns nullptr when empty or on a lost race.
+    T* steal() {
+        int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t bottom = bottom_.load(std::memory_order_acquire);
+        
+        if (top >= bottom) {
+            return nullptr;
+        }
+        
+        Buffer* buffer = buffer_.load(std::memory_order_acquire);
+        T* item = buffer->get(top);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return item;
+    }
+    
+    bool empty() const {
+        return top_.load(std::memory_order_acquire) >= bottom_.load(std::memory_order_acquire);
+    }
+    
+    size_t size() const {
+        int64_t size = bottom_.load(std::memory_order_acquire) - top_.load(std::memory_order_acquire);
+        return size > 0 ? static_cast<size_t>(size) : 0;
+    }
+
+private:
+    struct Buffer {
+        explicit Buffer(size_t capacity)
+            : mask(capacity - 1), slots(new std::atomic<T*>[capacity]) {}
+        
+        T* get(int64_t index) const {
+            return slots[static_cast<size_t>(index) & mask].load(std::memory_order_relaxed);
+        }
+        
+        void put(int64_t index, T* item) {
+            slots[static_cast<size_t>(index) & mask].store(item, std::memory_order_relaxed);
+        }
+        
+        size_t mask;
+        std::unique_ptr<std::atomic<T*>[]> slots;
+    };
+    
+    static size_t round_up(size_t capacity) {
+        size_t result = 2;
+        while (result < capacity) {
+            result <<= 1;
+        }
+        return result;
+    }
+    
+    Buffer* grow(Buffer* buffer, int64_t top, int64_t bottom) {
+        auto bigger = std::make_unique<Buffer>((buffer->mask + 1) * 2);
+        for (int64_t index = top; index < bottom; ++index) {
+            bigger->put(index, buffer->get(index));
+        }
+        
+        Buffer* result = bigger.get();
+        retired_.push_back(std::move(bigger));
+        buffer_.store(result, std::memory_order_release);
+        return result;
+    }
+    
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+    std::atomic<Buffer*> buffer_;
+    std::vector<std::unique_ptr<Buffer>> retired_;      // Owner only; includes the live buffer
+};
+
+// Work-stealing thread pool.
+//
+// Each worker owns a Chase-Lev deque. Tasks submitted from a worker go
+// straight onto its own deque; tasks from other threads go through a shared
+// injection queue. An idle worker drains its deque, then the injection
+// queue, then steals from workers in random order; with nothing found it
+// waits for the next submission using the configured WaitStrategy.
 class ThreadPool {
 public:
+    struct Config {
+        size_t num_threads = std::thread::hardware_concurrency();
+        std::vector<int> cores;                 // Worker i pinned to cores[i % size]; empty = unpinned
+        WaitStrategy::Config wait;              // How idle workers wait for submissions
+    };
+    
     explicit ThreadPool(size_t num_threads = std::thread::hardware_concurrency());
+    explicit ThreadPool(const Config& config);
     ~ThreadPool();
     
     // Delete copy constructor and assignment
     ThreadPool(const ThreadPool&) = delete;
     ThreadPool& operator=(const ThreadPool&) = delete;
     
-    // Submit a task to the thread pool
+    // Submit a task to the thread pool. The future's shared state is the
+    // only allocation; use execute() where no result is needed.
     template<typename F, typename... Args>
     auto submit(F&& f, Args&&... args) -> std::future<decltype(f(args...))> {
         using return_type = decltype(f(args...));
         
-        auto task = std::make_shared<std::packaged_task<return_type()>>(
-            std::bind(std::forward<F>(f), std::forward<Args>(args)...)
-        );
-        
-        std::future<return_type> result = task->get_future();
-        
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex_);
-            
-            if (stop_) {
-                throw std::runtime_error("ThreadPool is stopped");
-            }
-            
-            tasks_.emplace([task]() { (*task)(); });
-        }
+        std::packaged_task<return_type()> task(
+            [f = std::forward<F>(f), ... args = std::forward<Args>(args)]() mutable {
+                return f(args...);
+            });
         
-        condition_.notify_one();
+        std::future<return_type> result = task.get_future();
+        enqueue(Task(std::move(task)));
         return result;
     }
     
+    // Fire-and-forget submission. Does not allocate once the task node
+    // caches are warm, provided f fits Task's inline storage. Exceptions
+    // escaping f are logged and dropped.
+    template<typename F>
+    void execute(F&& f) {
+        static_assert(Task::fits_inline<std::decay_t<F>>(),
+                      "execute() callable exceeds Task inline storage; capture by reference");
+        enqueue(Task(std::forward<F>(f)));
+    }
+    
     // Submit a batch of tasks
     template<typename F, typename Iterator>
     std::vector<std::future<decltype(std::declval<F>()(std::declval<typename Iterator::value_type>()))>>
@@ -63,16 +210,26 @@ public:
         return futures;
     }
     
-    // Wait for all tasks to complete
+    // Wait for all tasks to complete. Not from a worker of this pool or
+    // from inside one of its tasks (std::logic_error); those wait on a
+    // TaskLatch for the tasks they forked instead.
     void wait_all();
     
+    // Run one pending task on the calling thread, if any. Lets a thread that
+    // waits on pool work help instead of blocking a worker slot.
+    bool run_pending_task();
+    
+    // Index of the calling worker in this pool, or -1 for other threads
+    int current_worker_index() const;
+    
     // Get the number of worker threads
     size_t num_threads() const { return workers_.size(); }
     
     // Get the number of pending tasks
     size_t pending_tasks() const {
-        std::unique_lock<std::mutex> lock(queue_mutex_);
-        return tasks_.size();
+        size_t pending = pending_tasks_.load();
+        size_t active = active_tasks_.load();
+        return pending > active ? pending - active : 0;
     }
     
     // Get the number of active tasks
@@ -80,29 +237,110 @@ public:
         return active_tasks_.load();
     }
     
-    // Stop the thread pool
-    void stop();
+    size_t tasks_processed() const { return total_tasks_processed_.load(); }
+    size_t tasks_stolen() const { return total_tasks_stolen_.load(); }
     
+    // Stop the thread pool; queued tasks still run before workers exit
+    void stop();
+
 private:
-    void worker_thread();
+    using Job = TaskNode;
+    
+    struct Worker {
+        WorkStealingDeque<Job> deque;
+        std::thread thread;
+        uint64_t rng_state = 0;         // Victim selection, worker thread only
+    };
+    
+    void enqueue(Task&& task);
+    void worker_thread(size_t index);
+    Job* find_task(Worker* self);
+    void run_task(Job* job);
+    void wake_one();
     
-    std::vector<std::thread> workers_;
-    std::queue<std::function<void()>> tasks_;
+    Config config_;
+    std::vector<std::unique_ptr<Worker>> workers_;
     
-    mutable std::mutex queue_mutex_;
-    std::condition_variable condition_;
-    std::condition_variable finished_condition_;
+    // Submissions from threads outside the pool, linked through TaskNode::next
+    Job* injection_head_ = nullptr;
+    Job* injection_tail_ = nullptr;
+    std::mutex injection_mutex_;
+    std::atomic<size_t> injection_size_{0};
+    
+    // A submitter notifies after publishing work, so a worker that saw no
+    // work under an older epoch does not wait through it
+    WakeSignal work_signal_;
+    
+    // Signalled only when the pool drains, not after every task
+    std::mutex idle_mutex_;
+    std::condition_variable idle_condition_;
     
     std::atomic<bool> stop_{false};
+    std::atomic<size_t> pending_tasks_{0};          // Submitted, not yet finished
     std::atomic<size_t> active_tasks_{0};
     std::atomic<size_t> total_tasks_processed_{0};
+    std::atomic<size_t> total_tasks_stolen_{0};
+};
+
+// Countdown for fork-join over the pool.
+//
+// Lives on the forking frame, so joining costs no allocation. Each forked
+// task calls count_down() once; wait() runs pending pool tasks while the
+// count is non-zero, and only a thread outside the pool ever blocks, so
+// nested fork-join cannot starve the workers.
+class TaskLatch {
+public:
+    explicit TaskLatch(int64_t count = 0) : count_(count) {}
+    
+    TaskLatch(const TaskLatch&) = delete;
+    TaskLatch& operator=(const TaskLatch&) = delete;
+    
+    void add(int64_t count = 1) { count_.fetch_add(count, std::memory_order_relaxed); }
+    
+    void count_down() {
+        if (count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            count_.notify_all();
+        }
+    }
+    
+    bool try_wait() const { return count_.load(std::memory_order_acquire) == 0; }
+    
+    void wait(ThreadPool& pool) {
+        bool worker = pool.current_worker_index() >= 0;
+        uint32_t idle_rounds = 0;
+        
+        while (!try_wait()) {
+            if (pool.run_pending_task()) {
+                idle_rounds = 0;
+                continue;
+            }
+            
+            if (worker || ++idle_rounds < 64) {
+                std::this_thread::yield();
+                continue;
+            }
+            
+            int64_t current = count_.load(std::memory_order_acquire);
+            if (current != 0) {
+                count_.wait(current, std::memory_order_acquire);
+            }
+        }
+    }
+
+private:
+    std::atomic<int64_t> count_;
 };
 
 // Global thread pool instance
 class GlobalThreadPool {
 public:
+    // Applies to the pool created by the first instance() call
+    static void configure(const ThreadPool::Config& config) {
+        config_storage() = config;
+    }
+    
     static ThreadPool& instance() {
-        static ThreadPool pool;
+        static ThreadPool pool(config_storage());
         return pool;
     }
     
@@ -110,6 +348,12 @@ public:
     static auto submit(F&& f, Args&&... args) {
         return instance().submit(std::forward<F>(f), std::forward<Args>(args)...);
     }
+
+private:
+    static ThreadPool::Config& config_storage() {
+        static ThreadPool::Config config;
+        return config;
+    }
 };
 
 // RAII helper for parallel execution
@@ -126,13 +370,20 @@ public:
         futures_.push_back(pool_.submit(std::forward<F>(f), std::forward<Args>(args)...));
     }
     
+    // From a pool worker, helps run queued tasks rather than blocking
     void wait() {
         for (auto& future : futures_) {
-            future.wait();
+            while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                if (!pool_.run_pending_task()) {
+                    future.wait();
+                }
+            }
         }
     }
     
     auto get_results() {
+        wait();
+        
         using result_type = typename decltype(futures_)::value_type::value_type;
         std::vector<result_type> results;
         results.reserve(futures_.size());
@@ -143,71 +394,10 @@ public:
         
         return results;
     }
-    
+
 private:
     ThreadPool& pool_;
     std::vector<std::future<decltype(std::declval<F>()())>> futures_;
 };
 
-// Thread pool implementation
-inline ThreadPool::ThreadPool(size_t num_threads) {
-    workers_.reserve(num_threads);
-    
-    for (size_t i = 0; i < num_threads; ++i) {
-        workers_.emplace_back([this] { worker_thread(); });
-    }
-}
-
-inline ThreadPool::~ThreadPool() {
-    stop();
-}
-
-inline void ThreadPool::worker_thread() {
-    while (true) {
-        std::function<void()> task;
-        
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex_);
-            
-            condition_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
-            
-            if (stop_ && tasks_.empty()) {
-                return;
-            }
-            
-            task = std::move(tasks_.front());
-            tasks_.pop();
-            active_tasks_++;
-        }
-        
-        task();
-        
-        active_tasks_--;
-        total_tasks_processed_++;
-        finished_condition_.notify_all();
-    }
-}
-
-inline void ThreadPool::wait_all() {
-    std::unique_lock<std::mutex> lock(queue_mutex_);
-    finished_condition_.wait(lock, [this] {
-        return tasks_.empty() && active_tasks_ == 0;
-    });
-}
-
-inline void ThreadPool::stop() {
-    {
-        std::unique_lock<std::mutex> lock(queue_mutex_);
-        stop_ = true;
-    }
-    
-    condition_.notify_all();
-    
-    for (auto& worker : workers_) {
-        if (worker.joinable()) {
-            worker.join();
-        }
-    }
-}
-
-} // namespace arbitrage
\ No newline at end of file
+} // namespace arbitrage
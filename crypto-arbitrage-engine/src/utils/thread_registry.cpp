@@ -0,0 +1,206 @@
+#include "thread_registry.h"
+#include "thread_placement.h"
+#include <cstdlib>
+#include <dirent.h>
+#include <fstream>
+#include <pthread.h>
+#include <sstream>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace arbitrage {
+
+const char* thread_role_to_string(ThreadRole role) {
+    switch (role) {
+        case ThreadRole::IO: return "io";
+        case ThreadRole::HEARTBEAT: return "heartbeat";
+        case ThreadRole::RECONNECT: return "reconnect";
+        case ThreadRole::STATS: return "stats";
+        case ThreadRole::DETECTOR: return "detector";
+        case ThreadRole::POOL: return "pool";
+        case ThreadRole::METRICS: return "metrics";
+        case ThreadRole::MONITOR: return "monitor";
+        case ThreadRole::LOGGER: return "logger";
+        case ThreadRole::OTHER: return "other";
+    }
+    return "other";
+}
+
+bool thread_role_from_string(const std::string& name, ThreadRole& role) {
+    for (size_t i = 0; i < THREAD_ROLE_COUNT; ++i) {
+        auto candidate = static_cast<ThreadRole>(i);
+        if (name == thread_role_to_string(candidate)) {
+            role = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+namespace {
+
+// Removes the calling thread from the registry when it exits
+struct RegistrationGuard {
+    bool active = false;
+
+    ~RegistrationGuard() {
+        if (active) {
+            ThreadRegistry::instance().unregister_current_thread();
+        }
+    }
+};
+
+thread_local RegistrationGuard registration_guard;
+
+} // namespace
+
+ThreadRegistry& ThreadRegistry::instance() {
+    static ThreadRegistry registry;
+    return registry;
+}
+
+pid_t ThreadRegistry::current_tid() {
+    static thread_local pid_t tid = static_cast<pid_t>(::syscall(SYS_gettid));
+    return tid;
+}
+
+void ThreadRegistry::register_current_thread(const std::string& name, ThreadRole role) {
+    // Kernel limit is 16 bytes including the terminator
+    std::string kernel_name = name.substr(0, 15);
+    pthread_setname_np(pthread_self(), kernel_name.c_str());
+
+    int core = ThreadPlacement::apply_current(role, name);
+
+    pid_t tid = current_tid();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        threads_[tid] = ThreadInfo{tid, name, role, core};
+    }
+
+    registration_guard.active = true;
+}
+
+void ThreadRegistry::unregister_current_thread() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    threads_.erase(current_tid());
+    registration_guard.active = false;
+}
+
+std::vector<ThreadRegistry::ThreadInfo> ThreadRegistry::threads() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<ThreadInfo> result;
+    result.reserve(threads_.size());
+    for (const auto& [tid, info] : threads_) {
+        result.push_back(info);
+    }
+    return result;
+}
+
+std::vector<ThreadRegistry::ThreadSample> ThreadRegistry::sample() {
+    std::lock_guard<std::mutex> sample_lock(sample_mutex_);
+
+    auto now = std::chrono::steady_clock::now();
+    double elapsed = last_times_.empty()
+        ? 0.0
+        : std::chrono::duration<double>(now - last_sample_time_).count();
+    double ticks_per_second = static_cast<double>(sysconf(_SC_CLK_TCK));
+
+    std::unordered_map<pid_t, ThreadInfo> registered;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        registered = threads_;
+    }
+
+    std::vector<ThreadSample> samples;
+    std::unordered_map<pid_t, CpuTimes> current_times;
+
+    DIR* tasks = opendir("/proc/self/task");
+    if (!tasks) {
+        return samples;
+    }
+
+    while (dirent* entry = readdir(tasks)) {
+        if (entry->d_name[0] < '0' || entry->d_name[0] > '9') continue;
+
+        pid_t tid = static_cast<pid_t>(std::atoi(entry->d_name));
+
+        ThreadSample sample{};
+        sample.tid = tid;
+        CpuTimes times{};
+        std::string comm;
+
+        if (!read_task_stat(tid, sample.state, times, sample.last_cpu, comm)) continue;
+        read_task_switches(tid, sample.voluntary_switches, sample.involuntary_switches);
+
+        auto info = registered.find(tid);
+        sample.registered = info != registered.end();
+        sample.name = sample.registered ? info->second.name : comm;
+        sample.role = sample.registered ? info->second.role : ThreadRole::OTHER;
+
+        auto previous = last_times_.find(tid);
+        // A reused tid shows up with smaller counters - treat it as new
+        if (elapsed > 0.0 && previous != last_times_.end() &&
+            times.user_ticks >= previous->second.user_ticks &&
+            times.system_ticks >= previous->second.system_ticks) {
+            double scale = 100.0 / (ticks_per_second * elapsed);
+            sample.user_percent = (times.user_ticks - previous->second.user_ticks) * scale;
+            sample.system_percent = (times.system_ticks - previous->second.system_ticks) * scale;
+            sample.cpu_percent = sample.user_percent + sample.system_percent;
+        }
+
+        current_times[tid] = times;
+        samples.push_back(std::move(sample));
+    }
+    closedir(tasks);
+
+    // Exited threads drop out here
+    last_times_ = std::move(current_times);
+    last_sample_time_ = now;
+
+    return samples;
+}
+
+bool ThreadRegistry::read_task_stat(pid_t tid, char& state, CpuTimes& times, int& last_cpu,
+                                    std::string& comm) {
+    std::ifstream file("/proc/self/task/" + std::to_string(tid) + "/stat");
+    if (!file.is_open()) return false;
+
+    std::string line;
+    std::getline(file, line);
+
+    // comm may contain spaces or parentheses; it ends at the last ')'
+    auto open = line.find('(');
+    auto close = line.rfind(')');
+    if (open == std::string::npos || close == std::string::npos || close < open) return false;
+
+    comm = line.substr(open + 1, close - open - 1);
+
+    // Fields after comm, numbered from 3 (state) as in proc(5)
+    std::istringstream fields(line.substr(close + 2));
+    fields >> state;
+
+    std::string field;
+    for (int index = 4; index <= 39 && fields >> field; ++index) {
+        if (index == 14) times.user_ticks = std::stoull(field);
+        else if (index == 15) times.system_ticks = std::stoull(field);
+        else if (index == 39) last_cpu = std::stoi(field);
+    }
+
+    return true;
+}
+
+void ThreadRegistry::read_task_switches(pid_t tid, uint64_t& voluntary, uint64_t& involuntary) {
+    std::ifstream file("/proc/self/task/" + std::to_string(tid) + "/status");
+    std::string line;
+
+    while (std::getline(file, line)) {
+        if (line.compare(0, 24, "voluntary_ctxt_switches:") == 0) {
+            voluntary = std::stoull(line.substr(24));
+        } else if (line.compare(0, 27, "nonvoluntary_ctxt_switches:") == 0) {
+            involuntary = std::stoull(line.substr(27));
+        }
+    }
+}
+
+} // namespace arbitrage
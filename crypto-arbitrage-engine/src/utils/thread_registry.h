@@ -0,0 +1,96 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <sys/types.h>
+#include <unordered_map>
+#include <vector>
+
+namespace arbitrage {
+
+// What an engine thread does; used for naming, reporting and placement
+enum class ThreadRole {
+    IO,             // Exchange websocket event loop
+    HEARTBEAT,      // Exchange ping / liveness
+    RECONNECT,      // Short-lived exchange reconnect
+    STATS,          // Market data statistics
+    DETECTOR,       // Arbitrage detection loop
+    POOL,           // ThreadPool worker
+    METRICS,        // Metrics collection / exposition
+    MONITOR,        // Performance monitor / SLO evaluation
+    LOGGER,         // Async log writer
+    OTHER
+};
+
+constexpr size_t THREAD_ROLE_COUNT = static_cast<size_t>(ThreadRole::OTHER) + 1;
+
+const char* thread_role_to_string(ThreadRole role);
+bool thread_role_from_string(const std::string& name, ThreadRole& role);
+
+// Registry of named engine threads plus a /proc-based per-thread sampler.
+//
+// Every engine thread calls register_current_thread() first thing; that
+// sets the kernel thread name (visible in top -H, perf, gdb), applies the
+// role's ThreadPlacement and records the tid. The entry is dropped
+// automatically when the thread exits.
+class ThreadRegistry {
+public:
+    struct ThreadInfo {
+        pid_t tid;
+        std::string name;
+        ThreadRole role;
+        int core;                           // Pinned core, -1 if unpinned
+    };
+
+    // One /proc/self/task/<tid> reading, rates over the last sample interval
+    struct ThreadSample {
+        pid_t tid;
+        std::string name;
+        ThreadRole role;
+        bool registered;
+        char state;                         // R, S, D, ...
+        double cpu_percent;                 // Of one core
+        double user_percent;
+        double system_percent;
+        uint64_t voluntary_switches;        // Cumulative
+        uint64_t involuntary_switches;      // Cumulative
+        int last_cpu;
+    };
+
+    static ThreadRegistry& instance();
+
+    // Name (truncated to 15 chars by the kernel) and register the calling thread
+    void register_current_thread(const std::string& name, ThreadRole role);
+    void unregister_current_thread();
+
+    std::vector<ThreadInfo> threads() const;
+
+    // Read every task of the process; CPU rates are relative to the previous call
+    std::vector<ThreadSample> sample();
+
+    static pid_t current_tid();
+
+private:
+    ThreadRegistry() = default;
+
+    struct CpuTimes {
+        uint64_t user_ticks;
+        uint64_t system_ticks;
+    };
+
+    static bool read_task_stat(pid_t tid, char& state, CpuTimes& times, int& last_cpu,
+                               std::string& comm);
+    static void read_task_switches(pid_t tid, uint64_t& voluntary, uint64_t& involuntary);
+
+    std::unordered_map<pid_t, ThreadInfo> threads_;
+    mutable std::mutex mutex_;
+
+    // Sampler state
+    std::unordered_map<pid_t, CpuTimes> last_times_;
+    std::chrono::steady_clock::time_point last_sample_time_;
+    std::mutex sample_mutex_;
+};
+
+} // namespace arbitrage
@@ -0,0 +1,69 @@
+#include "tsc_clock.h"
+#include "utils/logger.h"
+#include <thread>
+
+#ifdef ARB_HAS_TSC
+#include <cpuid.h>
+#endif
+
+namespace arbitrage {
+
+std::atomic<bool> TscClock::use_tsc_{false};
+std::atomic<uint64_t> TscClock::ns_multiplier_{uint64_t(1) << TscClock::SHIFT};
+
+void TscClock::calibrate(std::chrono::milliseconds duration) {
+#ifdef ARB_HAS_TSC
+    if (!has_invariant_tsc()) {
+        LOG_WARN("CPU has no invariant TSC - scope timers fall back to steady_clock");
+        return;
+    }
+
+    unsigned int aux;
+    auto wall_start = std::chrono::steady_clock::now();
+    uint64_t tsc_start = __rdtscp(&aux);
+
+    std::this_thread::sleep_for(duration);
+
+    uint64_t tsc_end = __rdtscp(&aux);
+    auto wall_end = std::chrono::steady_clock::now();
+
+    double elapsed_ns = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(wall_end - wall_start).count());
+    double ticks = static_cast<double>(tsc_end - tsc_start);
+
+    if (ticks <= 0.0 || elapsed_ns <= 0.0) {
+        LOG_WARN("TSC calibration failed - scope timers fall back to steady_clock");
+        return;
+    }
+
+    double ns_per_tick = elapsed_ns / ticks;
+    ns_multiplier_.store(static_cast<uint64_t>(ns_per_tick * static_cast<double>(uint64_t(1) << SHIFT)),
+                         std::memory_order_relaxed);
+    use_tsc_.store(true, std::memory_order_relaxed);
+
+    LOG_INFO("TSC calibrated: {:.3f} GHz", ticks / elapsed_ns);
+#else
+    (void)duration;
+#endif
+}
+
+double TscClock::ticks_per_nanosecond() {
+    double ns_per_tick = static_cast<double>(ns_multiplier_.load(std::memory_order_relaxed)) /
+                         static_cast<double>(uint64_t(1) << SHIFT);
+    return ns_per_tick > 0.0 ? 1.0 / ns_per_tick : 0.0;
+}
+
+bool TscClock::has_invariant_tsc() {
+#ifdef ARB_HAS_TSC
+    unsigned int eax, ebx, ecx, edx;
+    if (__get_cpuid_max(0x80000000, nullptr) < 0x80000007) {
+        return false;
+    }
+    __cpuid(0x80000007, eax, ebx, ecx, edx);
+    return (edx & (1u << 8)) != 0;
+#else
+    return false;
+#endif
+}
+
+} // namespace arbitrage
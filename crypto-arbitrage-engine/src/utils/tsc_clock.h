@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define ARB_HAS_TSC 1
+#endif
+
+namespace arbitrage {
+
+// 64x64 -> 128-bit products for fixed-point tick conversion; __extension__
+// keeps -Wpedantic quiet about the compiler builtin
+__extension__ typedef unsigned __int128 uint128;
+
+// Timestamp counter clock for hot-path interval timing.
+//
+// now() reads rdtscp (ordered against earlier loads, ~20 cycles) and
+// to_nanoseconds() converts tick deltas with a fixed-point multiplier
+// measured once at startup against steady_clock. Without an invariant TSC
+// (or before calibration) ticks are steady_clock nanoseconds, so timings
+// stay correct, only slower to take.
+class TscClock {
+public:
+    // Measure TSC frequency; call once at startup before worker threads run
+    static void calibrate(std::chrono::milliseconds duration = std::chrono::milliseconds(20));
+
+    static uint64_t now() {
+#ifdef ARB_HAS_TSC
+        if (use_tsc_.load(std::memory_order_relaxed)) {
+            unsigned int aux;
+            return __rdtscp(&aux);
+        }
+#endif
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    static uint64_t to_nanoseconds(uint64_t ticks) {
+        uint64_t multiplier = ns_multiplier_.load(std::memory_order_relaxed);
+        return static_cast<uint64_t>((static_cast<uint128>(ticks) * multiplier) >> SHIFT);
+    }
+
+    static bool is_tsc() { return use_tsc_.load(std::memory_order_relaxed); }
+    static double ticks_per_nanosecond();
+
+private:
+    static constexpr unsigned SHIFT = 32;
+
+    static bool has_invariant_tsc();
+
+    static std::atomic<bool> use_tsc_;
+    static std::atomic<uint64_t> ns_multiplier_;    // ns per tick in 32.32 fixed point
+};
+
+} // namespace arbitrage
@@ -0,0 +1,128 @@
+#include "wait_strategy.h"
+#include "utils/logger.h"
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <mutex>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace arbitrage {
+
+namespace {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) &&
+              std::atomic<uint32_t>::is_always_lock_free,
+              "futex needs a plain 32-bit word");
+
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+struct RoleConfigs {
+    std::mutex mutex;
+    WaitStrategy::Config roles[THREAD_ROLE_COUNT];
+};
+
+RoleConfigs& role_configs() {
+    static RoleConfigs* instance = new RoleConfigs();       // Threads may start during exit
+    return *instance;
+}
+
+} // namespace
+
+void WakeSignal::park(uint32_t seen, std::chrono::nanoseconds timeout) const {
+    sleepers_.fetch_add(1, std::memory_order_seq_cst);
+
+    // Re-check after announcing, so a notify in between either is seen here
+    // or sees us and issues the wake; FUTEX_WAIT compares the word again
+    if (epoch_.load(std::memory_order_seq_cst) == seen) {
+        timespec relative{};
+        timespec* limit = nullptr;
+        if (timeout != std::chrono::nanoseconds::max()) {
+            auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+            relative.tv_sec = seconds.count();
+            relative.tv_nsec = (timeout - seconds).count();
+            limit = &relative;
+        }
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch_), FUTEX_WAIT_PRIVATE,
+                  seen, limit, nullptr, 0);
+    }
+
+    sleepers_.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+void WakeSignal::wake(int count) {
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&epoch_), FUTEX_WAKE_PRIVATE,
+              count < 0 ? INT_MAX : count, nullptr, nullptr, 0);
+}
+
+bool WaitStrategy::wait(const WakeSignal& signal, uint32_t seen, Clock::time_point deadline) const {
+    bool timed = deadline != Clock::time_point::max();
+
+    // Spin phase; SPIN never leaves it. The clock is read every 64 polls.
+    for (uint32_t spin = 0; config_.kind == Kind::SPIN || spin < config_.spin_iterations; ++spin) {
+        if (signal.epoch() != seen) return true;
+        cpu_relax();
+        if (timed && (spin & 63) == 63 && Clock::now() >= deadline) return false;
+    }
+
+    while (signal.epoch() == seen) {
+        auto now = timed ? Clock::now() : Clock::time_point{};
+        if (timed && now >= deadline) return false;
+
+        if (config_.kind == Kind::YIELD) {
+            sched_yield();
+        } else {
+            signal.park(seen, timed ? std::chrono::nanoseconds(deadline - now)
+                                    : std::chrono::nanoseconds::max());
+        }
+    }
+    return true;
+}
+
+void WaitStrategy::configure(ThreadRole role, const Config& config) {
+    auto& configs = role_configs();
+    {
+        std::lock_guard<std::mutex> lock(configs.mutex);
+        configs.roles[static_cast<size_t>(role)] = config;
+    }
+
+    LOG_INFO("Wait strategy for {}: {}{}", thread_role_to_string(role), kind_to_string(config.kind),
+             config.kind == Kind::SPIN ? std::string()
+                                       : " after " + std::to_string(config.spin_iterations) + " spins");
+}
+
+WaitStrategy::Config WaitStrategy::for_role(ThreadRole role) {
+    auto& configs = role_configs();
+    std::lock_guard<std::mutex> lock(configs.mutex);
+    return configs.roles[static_cast<size_t>(role)];
+}
+
+const char* WaitStrategy::kind_to_string(Kind kind) {
+    switch (kind) {
+        case Kind::SPIN: return "spin";
+        case Kind::YIELD: return "yield";
+        default: return "park";
+    }
+}
+
+bool WaitStrategy::kind_from_string(const std::string& name, Kind& kind) {
+    if (name == "spin") {
+        kind = Kind::SPIN;
+    } else if (name == "yield") {
+        kind = Kind::YIELD;
+    } else if (name == "park") {
+        kind = Kind::PARK;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+} // namespace arbitrage
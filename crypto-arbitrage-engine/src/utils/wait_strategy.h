@@ -0,0 +1,97 @@
+#pragma once
+
+#include "thread_registry.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace arbitrage {
+
+// Wake-up counter a consumer can wait on.
+//
+// Producers bump the epoch after publishing work; a consumer reads epoch()
+// before looking for work and, finding none, waits for it to move on. A
+// parked waiter sleeps on the epoch word itself with a futex, and notify
+// only enters the kernel when someone is actually parked, so a producer
+// feeding spinning consumers pays one atomic increment.
+class WakeSignal {
+public:
+    WakeSignal() = default;
+    WakeSignal(const WakeSignal&) = delete;
+    WakeSignal& operator=(const WakeSignal&) = delete;
+
+    uint32_t epoch() const { return epoch_.load(std::memory_order_acquire); }
+
+    void notify_one() {
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+        if (sleepers_.load(std::memory_order_seq_cst) > 0) {
+            wake(1);
+        }
+    }
+
+    void notify_all() {
+        epoch_.fetch_add(1, std::memory_order_seq_cst);
+        if (sleepers_.load(std::memory_order_seq_cst) > 0) {
+            wake(-1);
+        }
+    }
+
+    // Sleep while the epoch is still seen, for at most timeout; may return
+    // spuriously, so callers re-check
+    void park(uint32_t seen, std::chrono::nanoseconds timeout = std::chrono::nanoseconds::max()) const;
+
+private:
+    void wake(int count);
+
+    alignas(64) mutable std::atomic<uint32_t> epoch_{0};
+    mutable std::atomic<uint32_t> sleepers_{0};
+};
+
+// How a consumer thread waits for its WakeSignal.
+//
+//   SPIN   poll with a pause instruction until signalled; sub-microsecond
+//          wake-up, burns its core. Only for roles with a dedicated core.
+//   YIELD  spin_iterations polls, then sched_yield() between polls; gives
+//          the core to other runnable threads but never sleeps.
+//   PARK   spin_iterations polls, then sleep on a futex until notified;
+//          costs a syscall on both sides once parked.
+//
+// Strategies are chosen per thread role from the threading config, so the
+// detector can spin on an isolated core while background threads park.
+class WaitStrategy {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Kind {
+        SPIN,
+        YIELD,
+        PARK
+    };
+
+    struct Config {
+        Kind kind = Kind::PARK;
+        uint32_t spin_iterations = 2000;        // Polls before yielding / parking
+    };
+
+    WaitStrategy() = default;
+    explicit WaitStrategy(const Config& config) : config_(config) {}
+
+    // Wait until signal moves past seen or deadline passes; true if signalled
+    bool wait(const WakeSignal& signal, uint32_t seen,
+              Clock::time_point deadline = Clock::time_point::max()) const;
+
+    const Config& config() const { return config_; }
+
+    // Per-role defaults; call before the role's threads start
+    static void configure(ThreadRole role, const Config& config);
+    static Config for_role(ThreadRole role);
+
+    static const char* kind_to_string(Kind kind);
+    static bool kind_from_string(const std::string& name, Kind& kind);
+
+private:
+    Config config_;
+};
+
+} // namespace arbitrage
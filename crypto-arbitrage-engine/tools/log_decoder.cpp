@@ -0,0 +1,201 @@
+// Decodes a binary LOG_FAST log (system.binary_log_file) into text lines
+// in the engine's log layout:
+//
+//   log_decoder <engine.binlog> [out.log]
+//
+// Writes to stdout without an output path. Timestamps come from the
+// record TSC and the latest TSC / wall-clock anchor before it, the same
+// mapping the text log used when the record was drained; version 1 files
+// only have the header's startup anchor and drift over long runs.
+//
+// The engine writes records per thread as it drains them. Lines are sorted
+// by stamp between anchors (about a second apart); a record stamped just
+// before an anchor but drained just after it can still print out of order.
+
+#include "utils/binary_log_format.h"
+#include <spdlog/common.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace arbitrage;
+
+namespace {
+
+// Bounds the memory held for sorting when anchors stop (idle engine clock)
+constexpr size_t MAX_WINDOW_RECORDS = 1'000'000;
+
+struct SiteInfo {
+    binlog::SiteEntry entry;
+    std::vector<binlog::ArgType> types;
+    std::string file;
+    std::string format;
+};
+
+struct Line {
+    uint64_t tsc;
+    uint64_t thread_id;
+    spdlog::level::level_enum level;
+    std::string text;
+};
+
+template <typename T>
+bool read_pod(std::ifstream& in, T* out, size_t count = 1) {
+    in.read(reinterpret_cast<char*>(out), static_cast<std::streamsize>(sizeof(T) * count));
+    return static_cast<bool>(in);
+}
+
+bool read_bytes(std::ifstream& in, std::string& out, size_t size) {
+    out.resize(size);
+    in.read(out.data(), static_cast<std::streamsize>(size));
+    return static_cast<bool>(in);
+}
+
+// "2024-01-01 12:00:00.123456789", local time like the text log
+std::string format_time(int64_t wall_ns) {
+    std::time_t seconds = static_cast<std::time_t>(wall_ns / 1000000000);
+    std::tm local{};
+    localtime_r(&seconds, &local);
+
+    char buffer[64];
+    size_t length = std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &local);
+    std::snprintf(buffer + length, sizeof(buffer) - length, ".%09lld",
+                  static_cast<long long>(wall_ns % 1000000000));
+    return buffer;
+}
+
+int64_t to_wall(const binlog::AnchorEntry& anchor, uint64_t tsc) {
+    // Stamps taken before the anchor land behind it
+    return tsc >= anchor.tsc
+        ? anchor.wall_ns + static_cast<int64_t>(static_cast<double>(tsc - anchor.tsc) / anchor.ticks_per_nanosecond)
+        : anchor.wall_ns - static_cast<int64_t>(static_cast<double>(anchor.tsc - tsc) / anchor.ticks_per_nanosecond);
+}
+
+// Writes the lines mapped through anchor in stamp order
+void flush(std::ostream& out, std::vector<Line>& window, const binlog::AnchorEntry& anchor) {
+    std::stable_sort(window.begin(), window.end(),
+                     [](const Line& a, const Line& b) { return a.tsc < b.tsc; });
+    for (const Line& line : window) {
+        auto level_name = spdlog::level::to_string_view(line.level);
+        out << "[" << format_time(to_wall(anchor, line.tsc)) << "] ["
+            << std::string(level_name.data(), level_name.size()) << "] [" << line.thread_id << "] "
+            << line.text << "\n";
+    }
+    window.clear();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <engine.binlog> [out.log]" << std::endl;
+        return 1;
+    }
+
+    std::string input_path = argv[1];
+    std::ifstream in(input_path, std::ios::binary);
+    if (!in.is_open()) {
+        std::cerr << "cannot open " << input_path << std::endl;
+        return 1;
+    }
+
+    binlog::LogFileHeader header{};
+    if (!read_pod(in, &header) ||
+        std::memcmp(header.magic, binlog::LOG_MAGIC, sizeof(header.magic)) != 0) {
+        std::cerr << input_path << " is not a binary log" << std::endl;
+        return 1;
+    }
+    if (header.version == 0 || header.version > binlog::LOG_VERSION) {
+        std::cerr << "unsupported binary log version " << header.version << std::endl;
+        return 1;
+    }
+
+    std::ofstream file_out;
+    if (argc > 2) {
+        file_out.open(argv[2]);
+        if (!file_out.is_open()) {
+            std::cerr << "cannot write " << argv[2] << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = argc > 2 ? static_cast<std::ostream&>(file_out) : std::cout;
+
+    binlog::AnchorEntry anchor{};
+    anchor.tsc = header.anchor_tsc;
+    anchor.wall_ns = header.anchor_wall_ns;
+    anchor.ticks_per_nanosecond = header.ticks_per_nanosecond > 0.0 ? header.ticks_per_nanosecond : 1.0;
+
+    std::unordered_map<uint32_t, SiteInfo> sites;
+    std::vector<Line> window;
+    std::string payload;
+    size_t record_count = 0;
+
+    // A log cut off mid-entry (engine killed) decodes up to the last whole one
+    binlog::EntryTag tag;
+    while (read_pod(in, &tag)) {
+        if (tag == binlog::EntryTag::SITE) {
+            SiteInfo site;
+            std::string types;
+            if (!read_pod(in, &site.entry) ||
+                !read_bytes(in, types, site.entry.arg_count) ||
+                !read_bytes(in, site.file, site.entry.file_length) ||
+                !read_bytes(in, site.format, site.entry.format_length)) {
+                std::cerr << "truncated site entry" << std::endl;
+                break;
+            }
+            for (char type : types) {
+                site.types.push_back(static_cast<binlog::ArgType>(type));
+            }
+            sites[site.entry.id] = std::move(site);
+        } else if (tag == binlog::EntryTag::ANCHOR) {
+            binlog::AnchorEntry next{};
+            if (!read_pod(in, &next)) {
+                std::cerr << "truncated anchor" << std::endl;
+                break;
+            }
+            flush(out, window, anchor);
+            if (next.ticks_per_nanosecond > 0.0) {
+                anchor = next;
+            }
+        } else if (tag == binlog::EntryTag::RECORD) {
+            binlog::RecordEntry record{};
+            if (!read_pod(in, &record) || !read_bytes(in, payload, record.payload_size)) {
+                std::cerr << "truncated record" << std::endl;
+                break;
+            }
+
+            auto site = sites.find(record.site);
+            if (site == sites.end()) {
+                std::cerr << "record for unknown site " << record.site << std::endl;
+                continue;
+            }
+            const SiteInfo& info = site->second;
+
+            Line line{record.tsc, record.thread_id,
+                      static_cast<spdlog::level::level_enum>(info.entry.level), std::string()};
+            if (!binlog::format_record(line.text, info.format, info.types.data(), info.types.size(),
+                                       payload.data(), payload.size())) {
+                line.text += " [truncated arguments]";
+            }
+            window.push_back(std::move(line));
+            if (window.size() >= MAX_WINDOW_RECORDS) {
+                flush(out, window, anchor);
+            }
+            record_count++;
+        } else {
+            std::cerr << "unknown entry tag " << static_cast<int>(tag) << std::endl;
+            break;
+        }
+    }
+
+    flush(out, window, anchor);
+    out.flush();
+    std::cerr << "Decoded " << record_count << " records from " << sites.size() << " call sites" << std::endl;
+    return 0;
+}
@@ -0,0 +1,189 @@
+// Converts an EventTracer dump (trace-*.bin) into Chrome trace event JSON,
+// loadable in chrome://tracing or ui.perfetto.dev.
+//
+//   trace_to_chrome <trace.bin> [out.json]
+//
+// Timestamps are microseconds relative to the oldest record in the dump;
+// the wall-clock time of the dump is recorded in the metadata.
+
+#include "performance/event_trace_format.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace arbitrage;
+
+namespace {
+
+struct ThreadTrace {
+    trace::TraceThreadHeader header;
+    std::vector<trace::TraceRecord> records;
+};
+
+template <typename T>
+bool read_pod(std::ifstream& in, T* out, size_t count = 1) {
+    in.read(reinterpret_cast<char*>(out), static_cast<std::streamsize>(sizeof(T) * count));
+    return static_cast<bool>(in);
+}
+
+std::string escape_json(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buffer[8];
+            std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+            escaped += buffer;
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+std::string bounded_string(const char* data, size_t size) {
+    return std::string(data, strnlen(data, size));
+}
+
+const char* phase_code(uint8_t phase) {
+    switch (static_cast<trace::Phase>(phase)) {
+        case trace::Phase::BEGIN: return "B";
+        case trace::Phase::END: return "E";
+        case trace::Phase::INSTANT: return "i";
+    }
+    return "i";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <trace.bin> [out.json]" << std::endl;
+        return 1;
+    }
+
+    std::string input_path = argv[1];
+    std::string output_path = argc > 2 ? argv[2] : input_path + ".json";
+
+    std::ifstream in(input_path, std::ios::binary);
+    if (!in.is_open()) {
+        std::cerr << "cannot open " << input_path << std::endl;
+        return 1;
+    }
+
+    trace::TraceFileHeader header{};
+    if (!read_pod(in, &header) ||
+        std::memcmp(header.magic, trace::TRACE_MAGIC, sizeof(header.magic)) != 0) {
+        std::cerr << input_path << " is not a trace dump" << std::endl;
+        return 1;
+    }
+    if (header.version != trace::TRACE_VERSION) {
+        std::cerr << "unsupported trace version " << header.version << std::endl;
+        return 1;
+    }
+
+    std::unordered_map<uint32_t, std::string> instruments;
+    for (uint32_t i = 0; i < header.instrument_count; ++i) {
+        trace::TraceInstrument instrument{};
+        if (!read_pod(in, &instrument)) {
+            std::cerr << "truncated instrument table" << std::endl;
+            return 1;
+        }
+        instruments[instrument.id] = bounded_string(instrument.name, sizeof(instrument.name));
+    }
+
+    std::vector<ThreadTrace> threads(header.thread_count);
+    uint64_t first_tsc = std::numeric_limits<uint64_t>::max();
+    for (auto& thread : threads) {
+        if (!read_pod(in, &thread.header)) {
+            std::cerr << "truncated thread header" << std::endl;
+            return 1;
+        }
+        thread.records.resize(thread.header.record_count);
+        if (thread.header.record_count > 0 &&
+            !read_pod(in, thread.records.data(), thread.records.size())) {
+            std::cerr << "truncated records for tid " << thread.header.tid << std::endl;
+            return 1;
+        }
+        if (!thread.records.empty()) {
+            first_tsc = std::min(first_tsc, thread.records.front().tsc);
+        }
+    }
+
+    double ticks_per_us = header.ticks_per_nanosecond * 1000.0;
+    if (ticks_per_us <= 0.0) ticks_per_us = 1000.0;
+
+    std::ofstream out(output_path);
+    if (!out.is_open()) {
+        std::cerr << "cannot write " << output_path << std::endl;
+        return 1;
+    }
+
+    out << "{\"displayTimeUnit\":\"ns\",\"otherData\":{\"dump_wall_ns\":" << header.anchor_wall_ns
+        << "},\"traceEvents\":[\n";
+
+    bool first = true;
+    auto separator = [&]() -> const char* {
+        if (first) {
+            first = false;
+            return "";
+        }
+        return ",\n";
+    };
+
+    size_t event_count = 0;
+    char timestamp[32];
+
+    for (const auto& thread : threads) {
+        out << separator() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+            << thread.header.tid << ",\"args\":{\"name\":\""
+            << escape_json(bounded_string(thread.header.name, sizeof(thread.header.name))) << "\"}}";
+
+        for (const auto& record : thread.records) {
+            std::string name = record.event < trace::EVENT_NAMES.size()
+                ? std::string(trace::EVENT_NAMES[record.event])
+                : "event_" + std::to_string(record.event);
+
+            std::snprintf(timestamp, sizeof(timestamp), "%.3f",
+                          static_cast<double>(record.tsc - first_tsc) / ticks_per_us);
+
+            out << separator() << "{\"name\":\"" << name << "\",\"cat\":\"engine\",\"ph\":\""
+                << phase_code(record.phase) << "\",\"ts\":" << timestamp
+                << ",\"pid\":1,\"tid\":" << thread.header.tid;
+
+            if (static_cast<trace::Phase>(record.phase) == trace::Phase::INSTANT) {
+                out << ",\"s\":\"t\"";
+            }
+
+            if (static_cast<trace::Phase>(record.phase) != trace::Phase::END) {
+                out << ",\"args\":{\"arg\":" << record.arg;
+                if (record.instrument != 0) {
+                    auto instrument = instruments.find(record.instrument);
+                    out << ",\"instrument\":\"";
+                    if (instrument != instruments.end()) {
+                        out << escape_json(instrument->second);
+                    } else {
+                        out << record.instrument;
+                    }
+                    out << "\"";
+                }
+                out << "}";
+            }
+            out << "}";
+            event_count++;
+        }
+    }
+
+    out << "\n]}\n";
+
+    std::cout << "Wrote " << event_count << " events from " << threads.size()
+              << " threads to " << output_path << std::endl;
+    return 0;
+}